@@ -3,7 +3,8 @@
 #include <filesystem>
 #include "zefs/FileStream.h"
 #include "zefs/ZEFS.h"
-#include "threading/jobsystem/Async.h"
+#include "zefs/AsyncIO.h"
+#include "zefs/Utils.h"
 
 namespace ze::assetdatacache
 {
@@ -34,28 +35,32 @@ std::vector<uint8_t> get_sync(const std::string& in_key)
 	if(!has_key(in_key))
 		return {};
 
-	filesystem::FileIStream stream(cache_dir / in_key,
-		filesystem::FileReadFlagBits::Binary);
-
-	stream.seekg(0, std::ios::end);
-	int64_t size = stream.tellg();
-	stream.seekg(0, std::ios::beg);
-
-	std::vector<uint8_t> data;
-	data.resize(size / sizeof(uint8_t));
-
-	stream.read(reinterpret_cast<char*>(data.data()), data.size());
-
-	return data;
+	return filesystem::read_file_to_vector((cache_dir / in_key).string(), true);
 }
 
 std::future<std::vector<uint8_t>> get_async(const std::string& in_key)
 {
-	return jobsystem::async<std::vector<uint8_t>>(
-		[in_key](const jobsystem::Job& in_job)
+	auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+	std::future<std::vector<uint8_t>> future = promise->get_future();
+
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(cache_dir / in_key, error);
+	if(error)
+	{
+		promise->set_value({});
+		return future;
+	}
+
+	/** Read with async I/O instead of blocking a worker */
+	auto data = std::make_shared<std::vector<uint8_t>>(size);
+	filesystem::asyncio::submit({ filesystem::asyncio::ReadRequest(cache_dir / in_key, 0, *data) },
+		[promise, data](const filesystem::asyncio::ReadBatch& in_batch)
 		{
-			return get_sync(in_key);
+			data->resize(in_batch.has_failed() ? 0 : in_batch.get_requests().front().bytes_read);
+			promise->set_value(std::move(*data));
 		});
+
+	return future;
 }
 
 bool has_key(const std::string& in_key)
@@ -21,6 +21,7 @@ ASSETDATACACHE_API void cache(const std::string& in_context, const std::string&
 
 /**
  * Get the data
+ * Entries are copied instead of mapped as cache() rewrites them in place when an asset is recooked
  */
 ASSETDATACACHE_API std::vector<uint8_t> get_sync(const std::string& in_key);
 
@@ -28,6 +28,7 @@
 #include "zefs/Utils.h"
 #include <filesystem>
 #include "editor/windows/Console.h"
+#include "editor/windows/FrameStats.h"
 #include <imgui_internal.h>
 #include "editor/PropertyEditor.h"
 #include "editor/propertyeditors/PrimitivesPropertyEditors.h"
@@ -62,6 +63,9 @@ EditorApp::EditorApp() : EngineApp(),
 
 	assetdatabase::scan("Assets", assetdatabase::AssetScanMode::Sync);
 
+	/** Keep the database up to date without rescanning */
+	assetdatabase::watch("Assets");
+
 
 	/** Main context */
 	main_context = ImGui::CreateContext(&font_atlas);
@@ -180,6 +184,7 @@ EditorApp::EditorApp() : EngineApp(),
 	/** Default windows */
 	main_windows.emplace_back(std::make_unique<MapEditor>());
 	main_windows.emplace_back(std::make_unique<Console>());
+	main_windows.emplace_back(std::make_unique<FrameStats>());
 
 	assetutils::get_on_asset_imported().bind(std::bind(&EditorApp::on_asset_imported,
 		this, std::placeholders::_1, std::placeholders::_2));
@@ -359,6 +364,9 @@ void EditorApp::process_event(const SDL_Event& in_event, const float in_delta_ti
 
 void EditorApp::post_tick(const float in_delta_time)
 {
+	/** Delegates of the watched asset directories are broadcasted here */
+	assetdatabase::process_file_events();
+
 	for(const auto& expired_child : expired_childs)
 	{
 		for(size_t i = 0; i < main_windows.size(); ++i)
@@ -62,10 +62,10 @@ OwnerPtr<Asset> TinyObjFactory::create_from_stream(std::istream& in_stream)
 			if (unique_vertices.count(vertex) == 0)
 			{
 				unique_vertices[vertex] = static_cast<uint32_t>(lod.vertices.size());
-				lod.vertices.push_back(vertex);
+				lod.vertices.edit().push_back(vertex);
 			}
 
-			lod.indices.push_back(unique_vertices[vertex]);
+			lod.indices.edit().push_back(unique_vertices[vertex]);
 		}
 	}
 #endif
@@ -0,0 +1,14 @@
+#include "editor/windows/FrameStats.h"
+#include "engine/ui/FrameStats.h"
+
+namespace ze::editor
+{
+
+FrameStats::FrameStats() : Window("Frame Stats") {}
+
+void FrameStats::draw()
+{
+	ui::draw_frame_stats();
+}
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Window.h"
+
+namespace ze::editor
+{
+
+/**
+ * Frame time percentiles and graphs
+ */
+class FrameStats : public Window
+{
+public:
+	FrameStats();
+protected:
+	void draw() override;
+};
+
+}
@@ -1,14 +1,18 @@
 #include "assets/AssetManager.h"
 #include "serialization/BinaryArchive.h"
+#include "serialization/MemoryArchive.h"
+#include "compression/BlockCompression.h"
 #include "assets/Asset.h"
 #include <robin_hood.h>
 #include "reflection/Class.h"
 #include <ostream>
 #include "module/Module.h"
 #include "zefs/ZEFS.h"
+#include "zefs/AsyncIO.h"
 #include <utility>
 #include "assets/Asset.h"
 #include "zefs/FileStream.h"
+#include "zefs/Utils.h"
 #include "reflection/Serialization.h"
 #include "threading/jobsystem/Async.h"
 #include "assets/AssetArchive.h"
@@ -86,33 +90,234 @@ Asset* AssetRequestHandle::get_asset() const
 	return assets[paths.front()].asset.get();
 }
 
-OwnerPtr<Asset> load_asset(const std::filesystem::path& in_path)
+/**
+ * Split an asset file into its inline data and bulk section using the footer, if any
+ */
+bool split_bulk_section(std::span<const uint8_t> in_file, std::span<const uint8_t>& out_inline, 
+	std::span<const uint8_t>& out_bulk)
+{
+	out_inline = in_file;
+	out_bulk = {};
+
+	if (in_file.size() < sizeof(AssetBulkFooter))
+		return true;
+
+	AssetBulkFooter footer;
+	memcpy(&footer, in_file.data() + in_file.size() - sizeof(AssetBulkFooter), sizeof(AssetBulkFooter));
+	if (footer.magic != AssetBulkFooter::magic_value)
+		return true;
+
+	const size_t body_size = in_file.size() - sizeof(AssetBulkFooter);
+	if (footer.offset > body_size || footer.size > body_size - footer.offset)
+		return false;
+
+	out_inline = in_file.subspan(0, footer.offset);
+	out_bulk = in_file.subspan(footer.offset, footer.size);
+	return true;
+}
+
+/**
+ * Append the bulk section and its footer after the serialized asset
+ */
+void write_bulk_section(std::vector<uint8_t>& in_asset_data, const std::vector<uint8_t>& in_bulk_data)
+{
+	if (in_bulk_data.empty())
+		return;
+
+	AssetBulkFooter footer;
+	footer.offset = (in_asset_data.size() + asset_bulk_data_alignment - 1) & ~(asset_bulk_data_alignment - 1);
+	footer.size = in_bulk_data.size();
+	footer.magic = AssetBulkFooter::magic_value;
+
+	in_asset_data.resize(footer.offset);
+	in_asset_data.insert(in_asset_data.end(), in_bulk_data.begin(), in_bulk_data.end());
+	in_asset_data.insert(in_asset_data.end(), reinterpret_cast<const uint8_t*>(&footer), 
+		reinterpret_cast<const uint8_t*>(&footer) + sizeof(footer));
+}
+
+/**
+ * Get the size of the binary metadata block (including its footer) at the end of an asset file
+ * \param in_file_end The end of the file (or the whole file)
+ * \return 0 if the file has no embedded metadata
+ */
+size_t get_embedded_metadata_size(std::span<const uint8_t> in_file_end)
+{
+	if (in_file_end.size() < sizeof(AssetMetadataFooter))
+		return 0;
+
+	AssetMetadataFooter footer;
+	memcpy(&footer, in_file_end.data() + in_file_end.size() - sizeof(AssetMetadataFooter), sizeof(AssetMetadataFooter));
+	if (footer.magic != AssetMetadataFooter::magic_value || 
+		footer.version != AssetMetadataFooter::current_version)
+		return 0;
+
+	return footer.metadata_size + sizeof(AssetMetadataFooter);
+}
+
+/**
+ * Parse the binary metadata at the end of an asset file
+ * \param in_file_end The end of the file, must contain the whole metadata block
+ */
+bool parse_embedded_metadata(std::span<const uint8_t> in_file_end, AssetMetadata& out_metadata)
+{
+	const size_t size = get_embedded_metadata_size(in_file_end);
+	if (size == 0 || size > in_file_end.size())
+		return false;
+
+	serialization::MemoryInputArchive ar(in_file_end.subspan(in_file_end.size() - size, 
+		size - sizeof(AssetMetadataFooter)));
+	ar <=> out_metadata;
+	return !ar.has_failed() && ar.get_remaining() == 0 && out_metadata.asset_class;
+}
+
+/**
+ * Append the binary metadata and its footer at the end of an asset file
+ */
+void write_embedded_metadata(std::vector<uint8_t>& in_file_data, const AssetMetadata& in_metadata)
+{
+	const size_t offset = in_file_data.size();
+	serialization::MemoryOutputArchive ar(in_file_data);
+	ar <=> const_cast<AssetMetadata&>(in_metadata);
+
+	AssetMetadataFooter footer;
+	footer.metadata_size = static_cast<uint32_t>(in_file_data.size() - offset);
+	footer.version = AssetMetadataFooter::current_version;
+	footer.magic = AssetMetadataFooter::magic_value;
+	ar.save_bytes(&footer, sizeof(footer));
+}
+
+/**
+ * Write an asset file, block-compressing it if requested
+ * \param in_metadata If not null, metadata to embed at the end of the file (never compressed)
+ */
+bool write_asset_file(const std::filesystem::path& in_path, std::span<const uint8_t> in_data, const bool in_compress,
+	const AssetMetadata* in_metadata = nullptr)
 {
-	/** Open the asset */
-	filesystem::FileIStream stream(in_path, filesystem::FileReadFlagBits::Binary);
+	std::vector<uint8_t> file_data;
+	if (in_compress)
+	{
+		compression::BlockCompressionStats stats;
+		file_data = compression::compress_blocks(in_data, compression::default_block_size, &stats);
+
+		ze::logger::info("Compressed {}: {} -> {} bytes (ratio {:.2f}, {:.1f} MiB/s)",
+			in_path.string(),
+			stats.uncompressed_size,
+			stats.compressed_size,
+			stats.get_ratio(),
+			stats.get_throughput());
+	}
+	else
+	{
+		file_data.assign(in_data.begin(), in_data.end());
+	}
+
+	if (in_metadata)
+		write_embedded_metadata(file_data, *in_metadata);
+
+	ze::filesystem::FileOStream stream(in_path, ze::filesystem::FileWriteFlagBits::Binary |
+		ze::filesystem::FileWriteFlagBits::ReplaceExisting);
 	if (!stream)
+		return false;
+
+	stream.write(reinterpret_cast<const char*>(file_data.data()), file_data.size());
+	return true;
+}
+
+/**
+ * Deserialize an asset from the whole content of its file
+ * The region is shared with the asset bulk data views
+ */
+OwnerPtr<Asset> load_asset(const std::filesystem::path& in_path, std::shared_ptr<filesystem::MappedRegion> region)
+{
+	if (!*region || region->empty())
 	{
 		ze::logger::error("Failed to open asset {}", in_path.string());
 		return nullptr;
 	}
 
-	/** Parse the header */
-	auto metadata = get_metadata_from_file(in_path);
+	std::shared_ptr<const void> storage = region;
+
+	/** Use the metadata embedded at the end of the file, fallback to the .zemeta file for older assets */
+	std::optional<AssetMetadata> metadata;
+	std::span<const uint8_t> asset_data = region->get_span();
+	if (const size_t metadata_size = get_embedded_metadata_size(asset_data))
+	{
+		AssetMetadata embedded_metadata;
+		if (parse_embedded_metadata(asset_data, embedded_metadata))
+			metadata = std::move(embedded_metadata);
+		asset_data = asset_data.subspan(0, asset_data.size() - std::min(metadata_size, asset_data.size()));
+	}
+	else
+	{
+		metadata = get_metadata_from_file(in_path);
+	}
+
 	if (!metadata.has_value())
 	{
 		ze::logger::error("Invalid metadata for asset {}", in_path.string());
 		return nullptr; 
 	}
 
-	AssetInputArchive<serialization::BinaryInputArchive> ar(*metadata, stream);
+	/** Decompress block-compressed assets, bulk data will then point to the decompressed buffer */
+	if (compression::is_block_compressed(asset_data))
+	{
+		auto decompressed_data = std::make_shared<std::vector<uint8_t>>();
+		compression::BlockCompressionStats stats;
+		if (!compression::decompress_blocks(asset_data, *decompressed_data, &stats))
+		{
+			ze::logger::error("Failed to decompress asset {}", in_path.string());
+			return nullptr;
+		}
+
+		ze::logger::verbose("Decompressed {}: {} blocks, ratio {:.2f}, {:.1f} MiB/s",
+			in_path.string(),
+			stats.block_count,
+			stats.get_ratio(),
+			stats.get_throughput());
+		asset_data = *decompressed_data;
+		storage = std::move(decompressed_data);
+	}
+
+	std::span<const uint8_t> inline_data = asset_data;
+	std::span<const uint8_t> bulk_section;
+	if (!split_bulk_section(asset_data, inline_data, bulk_section))
+	{
+		ze::logger::error("Invalid bulk section for asset {}", in_path.string());
+		return nullptr;
+	}
+
+	AssetInputArchive<serialization::MemoryInputArchive> ar(*metadata, inline_data);
+	ar.bulk_section = bulk_section;
+	ar.bulk_storage = std::move(storage);
 	OwnerPtr<Asset> asset = metadata->asset_class->instantiate<Asset>();
 	asset->set_path(in_path);
 	asset->set_metadata(*metadata);
 	reflection::serialization::serialize(ar, *asset);
+	if (ar.rejected || ar.underlying_archive.has_failed())
+	{
+		ze::logger::error("Asset {} is truncated or corrupted", in_path.string());
+		delete asset;
+		return nullptr;
+	}
 
 	return asset;
 }
 
+OwnerPtr<Asset> load_asset(const std::filesystem::path& in_path)
+{
+	/** Map the whole asset, deserializing from a span is much cheaper than going through a stream
+	 * The region is shared with the asset bulk data views so they point directly into the file mapping */
+#if ZE_WITH_EDITOR
+	/** The editor can overwrite assets while they are loaded, so they are read instead of mapped */
+	auto region = std::make_shared<filesystem::MappedRegion>(
+		filesystem::read_file_to_vector(in_path.string(), true));
+#else
+	auto region = std::make_shared<filesystem::MappedRegion>(filesystem::map(in_path, 
+		filesystem::MapAccessHint::Sequential));
+#endif
+	return load_asset(in_path, std::move(region));
+}
+
 std::pair<Asset*, std::shared_ptr<AssetRequestHandle>> load_asset_sync(const std::filesystem::path& in_path)
 {
 	std::shared_ptr<AssetRequestHandle> handle = std::make_shared<AssetRequestHandle>(std::vector<std::filesystem::path>{in_path});
@@ -161,9 +366,8 @@ std::shared_ptr<AssetRequestHandle> load_asset_async(const std::filesystem::path
 	}
 
 	ze::logger::verbose("Loading asset {}", in_path.string());
-	jobsystem::async([in_path, handle](const jobsystem::Job& in_job)
+	auto on_loaded = [in_path, handle](OwnerPtr<Asset> asset)
 	{
-		OwnerPtr<Asset> asset = load_asset(in_path);
 		if(!asset)
 		{
 			ze::logger::verbose("Failed to load asset {}", in_path.string());
@@ -175,7 +379,36 @@ std::shared_ptr<AssetRequestHandle> load_asset_async(const std::filesystem::path
 		asset_entry.ref_count++;
 		ze::logger::verbose("Loaded asset {}", in_path.string());
 		handle->complete();
-	});
+	};
+
+	/** Read OS files with async I/O so no worker waits on the disk, only the deserialization runs in a job */
+	const std::filesystem::path native_path = filesystem::get_native_path(in_path);
+	std::error_code error;
+	const uintmax_t file_size = native_path.empty() ? 0 : std::filesystem::file_size(native_path, error);
+	if(!native_path.empty() && !error)
+	{
+		auto data = std::make_shared<std::vector<uint8_t>>(file_size);
+		filesystem::asyncio::submit({ filesystem::asyncio::ReadRequest(in_path, 0, *data) },
+			[in_path, data, on_loaded](const filesystem::asyncio::ReadBatch& in_batch)
+			{
+				OwnerPtr<Asset> asset = nullptr;
+				if(!in_batch.has_failed())
+				{
+					data->resize(in_batch.get_requests().front().bytes_read);
+					asset = load_asset(in_path, std::make_shared<filesystem::MappedRegion>(std::move(*data)));
+				}
+
+				on_loaded(asset);
+			});
+	}
+	else
+	{
+		/** Files that aren't OS files (e.g packed) are already in memory */
+		jobsystem::async([in_path, on_loaded](const jobsystem::Job& in_job)
+		{
+			on_loaded(load_asset(in_path));
+		});
+	}
 
 	return handle;
 }
@@ -191,11 +424,50 @@ void unload_all()
 	assets.clear();
 }
 
-std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_path)
+std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_path, uint64_t* out_file_size)
 {
 	AssetMetadata metadata;
 
-	/** Search a correspond metadata file, if we can't found one, the metadata should be stored in the asset file */
+	/** Try the metadata embedded at the end of the asset file, only the end of the file is read */
+	{
+		filesystem::FileIStream stream(in_path, filesystem::FileReadFlagBits::Binary | 
+			filesystem::FileReadFlagBits::End);
+		if (!stream)
+			return std::nullopt;
+
+		const uint64_t file_size = stream.tellg();
+		if (out_file_size)
+			*out_file_size = file_size;
+
+		std::vector<uint8_t> file_end;
+		auto read_end = [&](const size_t in_size)
+		{
+			file_end.resize(std::min<uint64_t>(in_size, file_size));
+			stream.clear();
+			stream.seekg(file_size - file_end.size(), std::ios::beg);
+			stream.read(reinterpret_cast<char*>(file_end.data()), file_end.size());
+			return stream.gcount() == static_cast<std::streamsize>(file_end.size());
+		};
+
+		if (read_end(AssetMetadataFooter::tail_read_size))
+		{
+			/** Metadata bigger than our first read (e.g lots of editor data) */
+			const size_t metadata_size = get_embedded_metadata_size(file_end);
+			if (metadata_size > file_end.size() && metadata_size <= file_size)
+				read_end(metadata_size);
+
+			if (metadata_size != 0)
+			{
+				if (parse_embedded_metadata(file_end, metadata))
+					return std::make_optional(metadata);
+
+				ze::logger::error("Invalid asset {} (bad embedded metadata)", in_path.string());
+				return std::nullopt;
+			}
+		}
+	}
+
+	/** Fallback to the .zemeta file for assets saved without embedded metadata */
 	std::filesystem::path metadata_path = in_path.concat("meta");
 	if(ze::filesystem::exists(metadata_path))
 	{
@@ -207,7 +479,7 @@ std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_pat
 			return std::nullopt;
 		}
 		
-		serialization::JsonInputArchive ar(stream);
+		serialization::JsonInputArchive ar(stream, serialization::JsonReadMode::Sequential);
 		ar <=> metadata;
 		if (!metadata.asset_class)
 		{
@@ -216,10 +488,6 @@ std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_pat
 		
 		return std::make_optional(metadata);
 	}
-	else
-	{
-		
-	}
 
 	return std::nullopt;
 }
@@ -241,30 +509,27 @@ void save_asset(const AssetSaveInfo& in_info)
 
 	/** Serialize the asset */
 	{
-		ze::filesystem::FileOStream stream(in_info.path, ze::filesystem::FileWriteFlagBits::Binary |
-			ze::filesystem::FileWriteFlagBits::ReplaceExisting);
-		if (!stream)
-			return;
-
-		AssetOutputArchive<serialization::BinaryOutputArchive> archive(metadata, stream);
+		std::vector<uint8_t> asset_data;
+		AssetOutputArchive<serialization::MemoryOutputArchive> archive(metadata, asset_data);
 		archive.cooked_data = std::move(cooker_ctx.cooked_data);
 		reflection::serialization::serialize(archive, *in_info.asset);
+		write_bulk_section(asset_data, archive.bulk_data);
+
+		const bool compress = in_info.asset->use_block_compression();
+		if (!write_asset_file(in_info.path, asset_data, compress, &metadata))
+			return;
 
 		/** Save cooked data */
 		if (metadata.has_seperate_cooked_data)
 		{
 			std::filesystem::path cooked_path = in_info.path;
 			cooked_path.replace_extension("zecookeddata");
-			ze::filesystem::FileOStream cooked_stream(cooked_path, ze::filesystem::FileWriteFlagBits::Binary |
-				ze::filesystem::FileWriteFlagBits::ReplaceExisting);
-			if (!cooked_stream)
+			if (!write_asset_file(cooked_path, archive.cooked_data, compress))
 				return;
-
-			cooked_stream.write(reinterpret_cast<const char*>(archive.cooked_data.data()), archive.cooked_data.size());
 		}
 	}
 
-	/** Save metadata */
+	/** Save metadata as json too, for tools and version control */
 	{
 		std::filesystem::path meta_path = in_info.asset->get_path().concat("meta");
 		ze::filesystem::FileOStream stream(meta_path,
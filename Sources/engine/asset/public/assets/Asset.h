@@ -26,6 +26,9 @@ public:
     template<typename ArchiveType>
     void serialize(AssetArchive<ArchiveType>& in_archive) {}
 
+    /** Should the asset files of this class be block-compressed when saved. Loading detects compressed files */
+    virtual bool use_block_compression() const { return false; }
+
     void set_path(const std::filesystem::path& in_path) { path = in_path; }
     void set_metadata(const AssetMetadata& in_metadata) { metadata = in_metadata; }
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "serialization/BinaryArchive.h"
+#include "serialization/MemoryArchive.h"
 #include "AssetMetadata.h"
+#include "AssetBulkData.h"
 #include "reflection/Serialization.h"
 
 namespace ze
@@ -18,6 +20,16 @@ struct AssetArchive
 	/** Cooked data provided by the cooker */
 	std::vector<uint8_t> cooked_data;
 
+	/** Bulk section being written (output), see AssetBulkData */
+	std::vector<uint8_t> bulk_data;
+
+	/** Bulk section of the loaded file (input) and the storage owning it */
+	std::span<const uint8_t> bulk_section;
+	std::shared_ptr<const void> bulk_storage;
+
+	/** Set when the data can't be loaded (e.g unsupported version), nothing is serialized afterwards */
+	bool rejected = false;
+
 	template<typename... Args>
 	AssetArchive(const AssetMetadata& in_metadata, Args&&... in_args) : metadata(in_metadata),
 		underlying_archive(std::forward<Args>(in_args)...)
@@ -29,6 +41,9 @@ struct AssetArchive
 	template<typename T>
 	ZE_FORCEINLINE void operator<=>(const T& cdata)
 	{
+		if (rejected) [[unlikely]]
+			return;
+
 		T& data = const_cast<T&>(cdata);
 
 		if constexpr (ze::serialization::has_serialize_function_with_version<T, AssetArchive<Archive>>)
@@ -56,6 +71,24 @@ struct AssetArchive
 			underlying_archive <=> data;
 		}
 	}
+
+	/** Reject the data being loaded, the load will fail instead of reading a mismatching layout */
+	void reject(const std::string_view in_reason)
+	{
+		if (!rejected)
+			ze::logger::error("Rejected asset data: {}", in_reason);
+		rejected = true;
+	}
+
+	/** Append a region to the bulk section, returns its offset */
+	uint64_t add_bulk_region(const void* in_data, const size_t in_size)
+	{
+		const size_t offset = (bulk_data.size() + asset_bulk_data_alignment - 1) & ~(asset_bulk_data_alignment - 1);
+		bulk_data.resize(offset + in_size);
+		if (in_size > 0)
+			memcpy(bulk_data.data() + offset, in_data, in_size);
+		return offset;
+	}
 };
 
 template<typename Archive>
@@ -84,11 +117,68 @@ ZE_FORCEINLINE void serialize(AssetArchive<Archive>& archive, std::vector<T>& ve
 	if constexpr (serialization::is_input_archive<Archive>)
 		vector.resize(size);
 
-	for (auto& elem : vector)
-		archive <=> elem;
+	if constexpr (serialization::can_serialize_as_bytes<T, Archive>)
+	{
+		if(size > 0)
+			archive <=> serialization::make_binary_data(vector.data(), sizeof(T) * size);
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		/** std::vector<bool> elements are proxies */
+		for (size_t i = 0; i < size; ++i)
+		{
+			bool elem = vector[i];
+			archive <=> elem;
+			vector[i] = elem;
+		}
+	}
+	else
+	{
+		for (auto& elem : vector)
+			archive <=> elem;
+	}
+}
+
+/** Bulk data support for AssetArchive, the inline data is only the region offset and size */
+template<typename Archive, typename T>
+ZE_FORCEINLINE void serialize(AssetArchive<Archive>& archive, AssetBulkData<T>& data)
+{
+	uint64_t offset = 0;
+	uint64_t size = data.size_bytes();
+	if constexpr (serialization::is_output_archive<Archive>)
+		offset = archive.add_bulk_region(data.data(), size);
+
+	archive.underlying_archive <=> offset;
+	archive.underlying_archive <=> size;
+
+	if constexpr (serialization::is_input_archive<Archive>)
+	{
+		if (size == 0)
+		{
+			data.clear();
+			return;
+		}
+
+		const bool valid = archive.bulk_storage && 
+			offset <= archive.bulk_section.size() &&
+			size <= archive.bulk_section.size() - offset &&
+			size % sizeof(T) == 0;
+		ZE_CHECKF(valid, "Invalid bulk data region (offset {}, size {}, bulk section size {})", 
+			offset, size, archive.bulk_section.size());
+		if (!valid)
+		{
+			data.clear();
+			return;
+		}
+
+		data.set_view(std::span<const T>(reinterpret_cast<const T*>(archive.bulk_section.data() + offset), size / sizeof(T)),
+			archive.bulk_storage);
+	}
 }
 
 }
 
 ZE_REFL_REGISTER_ARCHIVE(ze::AssetInputArchive<ze::serialization::BinaryInputArchive>);
-ZE_REFL_REGISTER_ARCHIVE(ze::AssetOutputArchive<ze::serialization::BinaryOutputArchive>);
\ No newline at end of file
+ZE_REFL_REGISTER_ARCHIVE(ze::AssetOutputArchive<ze::serialization::BinaryOutputArchive>);
+ZE_REFL_REGISTER_ARCHIVE(ze::AssetInputArchive<ze::serialization::MemoryInputArchive>);
+ZE_REFL_REGISTER_ARCHIVE(ze::AssetOutputArchive<ze::serialization::MemoryOutputArchive>);
\ No newline at end of file
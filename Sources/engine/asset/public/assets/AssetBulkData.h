@@ -0,0 +1,89 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "serialization/Archive.h"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace ze
+{
+
+/**
+ * Bulk data regions are stored after the serialized asset, in a section described by a footer at the end of the file:
+ *	[serialized asset][padding][bulk region 0][padding][bulk region 1]...[AssetBulkFooter]
+ * Regions are addressed by an offset relative to the start of the bulk section
+ */
+static constexpr size_t asset_bulk_data_alignment = 64;
+
+struct AssetBulkFooter
+{
+	static constexpr uint64_t magic_value = 0x31304B4C5542455A; /** "ZEBULK01" */
+
+	uint64_t offset;
+	uint64_t size;
+	uint64_t magic;
+};
+static_assert(sizeof(AssetBulkFooter) == 24);
+
+/**
+ * A large contiguous payload of an asset (mipmaps, vertices, indices...)
+ * When written, the payload is moved to the bulk section of the asset file instead of being serialized inline
+ * When loaded, this is a view into the asset file memory, kept alive as long as this object references it
+ * To modify the data, use edit() that will make an owned copy if required
+ */
+template<typename T>
+	requires serialization::is_trivially_serializable<T>
+class AssetBulkData
+{
+public:
+	AssetBulkData() = default;
+	AssetBulkData(std::vector<T> in_data) : owned(std::move(in_data)) {}
+
+	/** Make this a view into an external storage */
+	void set_view(std::span<const T> in_view, std::shared_ptr<const void> in_storage)
+	{
+		owned.clear();
+		view = in_view;
+		storage = std::move(in_storage);
+	}
+
+	/** Get a mutable owned copy of the data */
+	std::vector<T>& edit()
+	{
+		if (storage)
+		{
+			owned.assign(view.begin(), view.end());
+			view = {};
+			storage.reset();
+		}
+
+		return owned;
+	}
+
+	void clear()
+	{
+		owned.clear();
+		owned.shrink_to_fit();
+		view = {};
+		storage.reset();
+	}
+
+	ZE_FORCEINLINE std::span<const T> get_span() const { return storage ? view : std::span<const T>(owned); }
+	ZE_FORCEINLINE const T* data() const { return get_span().data(); }
+	ZE_FORCEINLINE size_t size() const { return get_span().size(); }
+	ZE_FORCEINLINE size_t size_bytes() const { return get_span().size_bytes(); }
+	ZE_FORCEINLINE bool empty() const { return get_span().empty(); }
+	ZE_FORCEINLINE const T& operator[](const size_t in_idx) const { return get_span()[in_idx]; }
+	ZE_FORCEINLINE auto begin() const { return get_span().begin(); }
+	ZE_FORCEINLINE auto end() const { return get_span().end(); }
+
+	/** True if the data is a view into a loaded asset file */
+	ZE_FORCEINLINE bool is_view() const { return storage != nullptr; }
+private:
+	std::vector<T> owned;
+	std::span<const T> view;
+	std::shared_ptr<const void> storage;
+};
+
+}
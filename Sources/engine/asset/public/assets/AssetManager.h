@@ -101,8 +101,10 @@ void save_asset(const AssetSaveInfo& in_info);
 
 /**
  * Try get the metadata of the specified file if this is an asset
- * This function works with cooked asset (single asset file) and uncooked assets (asset file and .zemeta file)
+ * The binary metadata embedded at the end of the asset file is used if present (only the end of the file is read),
+ * otherwise the .zemeta file is parsed
+ * \param out_file_size If not null, receives the size of the asset file
  */
-std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_path);
+std::optional<AssetMetadata> get_metadata_from_file(std::filesystem::path in_path, uint64_t* out_file_size = nullptr);
 
 }
\ No newline at end of file
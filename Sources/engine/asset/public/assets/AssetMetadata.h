@@ -1,9 +1,13 @@
 #pragma once
 
 #include "serialization/types/Uuid.h"
+#include "serialization/types/String.h"
+#include "serialization/types/Map.h"
 #include "serialization/Json.h"
 #include "EngineVer.h"
 #include "reflection/Class.h"
+#include <array>
+#include <cstring>
 
 namespace ze
 {
@@ -72,7 +76,51 @@ struct AssetMetadata
         	archive <=> serialization::make_named_data("editor_data", editor_data);
 #endif
     }
+
+    /** Binary layout, embedded at the end of asset files */
+    template<typename ArchiveType>
+        requires (!std::is_base_of_v<serialization::JsonArchive, ArchiveType>)
+    void serialize(ArchiveType& archive)
+    {
+        std::array<uint8_t, 16> uuid_bytes;
+        if constexpr(serialization::is_output_archive<ArchiveType>)
+            memcpy(uuid_bytes.data(), uuid.as_bytes().data(), uuid_bytes.size());
+        archive <=> serialization::make_binary_data(uuid_bytes.data(), uuid_bytes.size());
+
+        std::string class_name = asset_class ? asset_class->get_name() : "";
+        archive <=> class_name;
+        archive <=> engine_version;
+        archive <=> asset_format;
+        archive <=> has_seperate_cooked_data;
+        archive <=> editor_data;
+
+        if constexpr(serialization::is_input_archive<ArchiveType>)
+        {
+            uuid = uuids::uuid(uuid_bytes.begin(), uuid_bytes.end());
+            asset_class = reflection::Class::get_by_name(class_name);
+        }
+    }
 };
 ZE_SERL_TYPE_VERSION(AssetMetadata, AssetMetadata::Ver0);
 
+/**
+ * Footer of the binary metadata stored at the end of asset files:
+ *	[asset data][binary AssetMetadata][AssetMetadataFooter]
+ * This allows reading the metadata of an asset with a single small read of the end of the file
+ * .zemeta files are only written as an editor interchange format and read as a fallback for older assets
+ */
+struct AssetMetadataFooter
+{
+    static constexpr uint64_t magic_value = 0x31304154454D455A; /** "ZEMETA01" */
+    static constexpr uint32_t current_version = 1;
+
+    /** Size of the end of the file read at once when looking for the metadata, enough for most assets */
+    static constexpr size_t tail_read_size = 1024;
+
+    uint32_t metadata_size;
+    uint32_t version;
+    uint64_t magic;
+};
+static_assert(sizeof(AssetMetadataFooter) == 16);
+
 }
\ No newline at end of file
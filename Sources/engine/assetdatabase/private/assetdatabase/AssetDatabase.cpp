@@ -3,6 +3,7 @@
 #include <robin_hood.h>
 #include "module/ModuleManager.h"
 #include "threading/jobsystem/Async.h"
+#include "threading/Mutex.h"
 #include <istream>
 #include <ios>
 #include "serialization/BinaryArchive.h"
@@ -10,6 +11,7 @@
 #include "module/Module.h"
 #include "zefs/FileStream.h"
 #include "zefs/ZEFS.h"
+#include "zefs/FileWatcher.h"
 #include "PathTree.h"
 #include "assets/AssetMetadata.h"
 #include "assets/AssetManager.h"
@@ -22,57 +24,125 @@ namespace ze::assetdatabase
 PathTree path_tree;
 robin_hood::unordered_map<std::filesystem::path, AssetPrimitiveData> data_map;
 OnAssetRegistered on_asset_registered;
+OnAssetUnregistered on_asset_unregistered;
 OnAssetScanCompleted on_asset_scan_completed;
-std::mutex map_mutex;
+Mutex map_mutex("AssetDatabase");
+robin_hood::unordered_map<std::filesystem::path, filesystem::FileWatchHandle> watches;
+std::mutex watches_mutex;
 
-void register_asset(const std::filesystem::path& path)
-{
-	std::lock_guard<std::mutex> guard(map_mutex);
+/** Events received by the file watcher thread, applied by process_file_events */
+std::vector<filesystem::FileWatchEvent> pending_file_events;
+std::mutex pending_file_events_mutex;
 
+/**
+ * Register an asset whose metadata has already been read
+ */
+void register_asset(const std::filesystem::path& path, const AssetMetadata& metadata, const uint64_t size)
+{
 	AssetPrimitiveData data;
 	data.name = path.stem().string();
 	data.path = path;
 	data.meta_path = path;
+	data.size = size;
+	data.metadata = metadata;
 
 	/** Metapath, if it exists */
 	data.meta_path = data.meta_path.stem().concat(".zemeta");
 	if(!ze::filesystem::exists(data.meta_path))
 		data.meta_path = "";
 
-	/** Parse the header */
-	std::optional<AssetMetadata> metadata = assetmanager::get_metadata_from_file(path);
-	if(!metadata.has_value())
+	{
+		std::lock_guard<Mutex> guard(map_mutex);
+		path_tree.add(path);
+
+		/** Re-registering a modified asset replaces its data */
+		data_map.insert_or_assign(path, data);
+	}
+
+	ze::logger::verbose("Registered asset {} ({})", path.string(),
+		metadata.asset_class->get_name());
+
+	on_asset_registered.broadcast(data);
+}
+
+void register_asset(const std::filesystem::path& path)
+{
+	/** Parse the header, the file size is retrieved by the same read */
+	uint64_t size = 0;
+	std::optional<AssetMetadata> metadata = assetmanager::get_metadata_from_file(path, &size);
+	if(!metadata.has_value() || !metadata->asset_class)
 	{
 		ze::logger::error("Invalid metadata {}", path.string());
 		return;
 	}
-	data.metadata = *metadata;
 
-	path_tree.add(path);
+	register_asset(path, *metadata, size);
+}
+
+bool is_registered(const std::filesystem::path& path)
+{
+	std::lock_guard<Mutex> guard(map_mutex);
+	return path_tree.has_path(path);
+}
+
+/**
+ * Unregister an asset or every asset of a directory
+ */
+void unregister_path(const std::filesystem::path& path, const bool is_directory)
+{
+	std::vector<std::filesystem::path> unregistered;
 
-	/** Open the asset file */
 	{
-		filesystem::FileIStream asset_stream(data.path,
-			filesystem::FileReadFlagBits::End);
-		if (!asset_stream)
+		std::lock_guard<Mutex> guard(map_mutex);
+		path_tree.remove(path);
+
+		if (is_directory)
 		{
-			ze::logger::error("Failed to open asset {}", path.string());
-			return;
+			for (auto it = data_map.begin(); it != data_map.end(); )
+			{
+				const std::filesystem::path relative_path = it->first.lexically_relative(path);
+				if (!relative_path.empty() && *relative_path.begin() != "..")
+				{
+					unregistered.emplace_back(it->first);
+					it = data_map.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+		else if (data_map.erase(path))
+		{
+			unregistered.emplace_back(path);
 		}
-
-		data.size = asset_stream.tellg();
 	}
 
-	data_map.insert({ path, data });
-	ze::logger::verbose("Registered asset {} ({})", path.string(),
-		metadata->asset_class->get_name());
-
-	on_asset_registered.broadcast(data);
+	for (const auto& asset_path : unregistered)
+	{
+		ze::logger::verbose("Unregistered asset {}", asset_path.string());
+		on_asset_unregistered.broadcast(asset_path);
+	}
 }
 
-bool is_registered(const std::filesystem::path& path)
+/**
+ * Register or refresh a single file, files that are not assets are ignored
+ */
+void update_asset(const std::filesystem::path& path)
 {
-	return path_tree.has_path(path);
+	if (path.extension() == ".zemeta")
+		return;
+
+	uint64_t size = 0;
+	std::optional<AssetMetadata> metadata = assetmanager::get_metadata_from_file(path, &size);
+	if (!metadata.has_value() || !metadata->asset_class)
+	{
+		/** The file is not an asset anymore */
+		unregister_path(path, false);
+		return;
+	}
+
+	register_asset(path, *metadata, size);
 }
 
 bool is_valid_asset(const std::filesystem::path& path)
@@ -85,12 +155,19 @@ void scan_internal(const std::filesystem::path& path)
 	filesystem::iterate_directories(path,
 		[&](const filesystem::DirectoryEntry& entry)
 		{
-			if (filesystem::is_directory(path / entry.path) ||
-				!is_valid_asset(path / entry.path) || 
+			const std::filesystem::path asset_path = path / entry.path;
+			if (filesystem::is_directory(asset_path) ||
+				asset_path.extension() == ".zemeta" ||
 				is_registered(entry.path))
 				return;
 
-			register_asset(path / entry.path);
+			/** Metadata is only read once per file */
+			uint64_t size = 0;
+			std::optional<AssetMetadata> metadata = assetmanager::get_metadata_from_file(asset_path, &size);
+			if (!metadata.has_value() || !metadata->asset_class)
+				return;
+
+			register_asset(asset_path, *metadata, size);
 		}, filesystem::IterateDirectoriesFlagBits::Recursive);
 
 	on_asset_scan_completed.broadcast();
@@ -113,8 +190,117 @@ void scan(const std::filesystem::path& path, const AssetScanMode& scanmode)
 	}
 }
 
+/**
+ * Rescan a directory whose changes were lost, assets that disappeared are unregistered
+ *	and the remaining ones are refreshed
+ */
+void resync_directory(const std::filesystem::path& path)
+{
+	std::vector<std::filesystem::path> registered_paths;
+	{
+		std::lock_guard<Mutex> guard(map_mutex);
+		for (const auto& [asset_path, data] : data_map)
+		{
+			const std::filesystem::path relative_path = asset_path.lexically_relative(path);
+			if (!relative_path.empty() && *relative_path.begin() != "..")
+				registered_paths.emplace_back(asset_path);
+		}
+	}
+
+	for (const auto& asset_path : registered_paths)
+	{
+		if (filesystem::exists(asset_path))
+			update_asset(asset_path);
+		else
+			unregister_path(asset_path, false);
+	}
+
+	scan_internal(path);
+}
+
+void apply_file_event(const filesystem::FileWatchEvent& event)
+{
+	switch (event.type)
+	{
+	case filesystem::FileWatchEventType::Created:
+	case filesystem::FileWatchEventType::Modified:
+		/** Files of new directories are reported by their own events */
+		if (!event.is_directory)
+			update_asset(event.path);
+		break;
+	case filesystem::FileWatchEventType::Deleted:
+		unregister_path(event.path, event.is_directory);
+		break;
+	case filesystem::FileWatchEventType::Renamed:
+		unregister_path(event.old_path, event.is_directory);
+		if (event.is_directory)
+			scan_internal(event.path);
+		else
+			update_asset(event.path);
+		break;
+	case filesystem::FileWatchEventType::Overflowed:
+		ze::logger::info("Lost file events for {}, rescanning it", event.path.string());
+		resync_directory(event.path);
+		break;
+	}
+}
+
+/**
+ * Called from the file watcher thread, queue the event so delegates are broadcasted from the thread
+ *	calling process_file_events
+ */
+void on_file_changed(const filesystem::FileWatchEvent& event)
+{
+	std::lock_guard<std::mutex> guard(pending_file_events_mutex);
+	pending_file_events.emplace_back(event);
+}
+
+void process_file_events()
+{
+	std::vector<filesystem::FileWatchEvent> events;
+	{
+		std::lock_guard<std::mutex> guard(pending_file_events_mutex);
+		events.swap(pending_file_events);
+	}
+
+	for (const auto& event : events)
+		apply_file_event(event);
+}
+
+bool watch(const std::filesystem::path& path)
+{
+	std::lock_guard<std::mutex> guard(watches_mutex);
+	if (watches.contains(path))
+		return true;
+
+	const filesystem::FileWatchHandle handle = filesystem::watch(path, &on_file_changed);
+	if (handle == filesystem::invalid_file_watch_handle)
+		return false;
+
+	watches.insert({ path, handle });
+	return true;
+}
+
+void unwatch(const std::filesystem::path& path)
+{
+	filesystem::FileWatchHandle handle = filesystem::invalid_file_watch_handle;
+
+	{
+		std::lock_guard<std::mutex> guard(watches_mutex);
+		auto it = watches.find(path);
+		if (it == watches.end())
+			return;
+
+		handle = it->second;
+		watches.erase(it);
+	}
+
+	filesystem::unwatch(handle);
+}
+
 std::vector<AssetPrimitiveData> get_assets(const std::filesystem::path& dir)
 {
+	std::lock_guard<Mutex> guard(map_mutex);
 	auto childs = path_tree.get_childs(dir, true);
 	
 	std::vector<AssetPrimitiveData> assets;
@@ -132,6 +318,7 @@ std::vector<AssetPrimitiveData> get_assets(const std::filesystem::path& dir)
 
 std::optional<AssetPrimitiveData> get_asset_primitive_data(const std::filesystem::path& path)
 {
+	std::lock_guard<Mutex> guard(map_mutex);
 	auto data = data_map.find(path);
 	if (data != data_map.end())
 		return data->second;
@@ -141,10 +328,12 @@ std::optional<AssetPrimitiveData> get_asset_primitive_data(const std::filesystem
 
 std::vector<std::filesystem::path> get_subdirectories(const std::filesystem::path& root)
 {
+	std::lock_guard<Mutex> guard(map_mutex);
 	return path_tree.get_childs(root, false);
 }
 
 OnAssetRegistered& get_on_asset_registered() { return on_asset_registered; }
+OnAssetUnregistered& get_on_asset_unregistered() { return on_asset_unregistered; }
 OnAssetScanCompleted& get_on_asset_scan_completed() { return on_asset_scan_completed; }
 
 }
\ No newline at end of file
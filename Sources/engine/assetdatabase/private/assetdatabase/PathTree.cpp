@@ -53,6 +53,24 @@ void PathTree::add(const std::filesystem::path& path)
 	}
 }
 
+void PathTree::remove(const std::filesystem::path& path)
+{
+	auto it = paths.find(path);
+	if (it != paths.end())
+	{
+		/** Copy as removing a child unlinks it from this directory */
+		const std::vector<std::filesystem::path> childs(it->second.childs.begin(), it->second.childs.end());
+		for (const auto& child : childs)
+			remove(path / child);
+
+		paths.erase(path);
+	}
+
+	auto parent_it = paths.find(path.parent_path());
+	if (parent_it != paths.end())
+		parent_it->second.childs.erase(path.filename());
+}
+
 std::vector<std::filesystem::path> PathTree::get_childs(const std::filesystem::path& path,
 	const bool& include_files)
 {
@@ -33,6 +33,9 @@ public:
 	/** Add the specified path to the path tree (path must be relative) */
 	void add(const std::filesystem::path& path);
 
+	/** Remove the specified file or directory, including its childs */
+	void remove(const std::filesystem::path& path);
+
 	std::vector<std::filesystem::path> get_childs(const std::filesystem::path& path,
 		const bool& include_files);
 
@@ -53,6 +53,7 @@ enum class AssetScanMode
 
 /** Delegates */
 using OnAssetRegistered = MulticastDelegateNoRet<const AssetPrimitiveData&>;
+using OnAssetUnregistered = MulticastDelegateNoRet<const std::filesystem::path&>;
 using OnAssetScanCompleted = MulticastDelegateNoRet<>;
 
 /** Functions */
@@ -63,6 +64,24 @@ using OnAssetScanCompleted = MulticastDelegateNoRet<>;
  */
 ASSETDATABASE_API void scan(const std::filesystem::path& path, const AssetScanMode& scanmode = AssetScanMode::Async);
 
+/**
+ * Watch a directory and apply file changes (creation, modification, rename, deletion) to the database
+ *	without rescanning it
+ * Assets already present must be registered with scan
+ * Changes are queued by the file watcher thread and applied by process_file_events
+ * \return false if the directory can't be watched
+ */
+ASSETDATABASE_API bool watch(const std::filesystem::path& path);
+
+/** Stop watching a directory previously passed to watch */
+ASSETDATABASE_API void unwatch(const std::filesystem::path& path);
+
+/**
+ * Apply the file changes received since the last call
+ * Delegates are broadcasted from the calling thread, call it from the main thread once per frame
+ */
+ASSETDATABASE_API void process_file_events();
+
 /**
  * Get sub directories of the specified directory in the asset database path tree
  */
@@ -79,6 +98,7 @@ ASSETDATABASE_API std::vector<AssetPrimitiveData> get_assets(const std::filesyst
 ASSETDATABASE_API std::optional<AssetPrimitiveData> get_asset_primitive_data(const std::filesystem::path& path);
 
 ASSETDATABASE_API inline OnAssetRegistered& get_on_asset_registered();
+ASSETDATABASE_API inline OnAssetUnregistered& get_on_asset_unregistered();
 ASSETDATABASE_API inline OnAssetScanCompleted& get_on_asset_scan_completed();
 
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "compression/BlockCompression.h"
+#include "threading/jobsystem/JobSystem.h"
+#include <lz4.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace ze::compression
+{
+
+/**
+ * Run in_func for each index, split across the job system workers if it is running
+ */
+template<typename Func>
+void for_each_block(const size_t in_count, Func&& in_func)
+{
+	const size_t job_count = std::min<size_t>({ in_count, jobsystem::get_worker_count(),
+		jobsystem::Job::max_childs - 1 });
+	if (job_count <= 1)
+	{
+		for (size_t i = 0; i < in_count; ++i)
+			in_func(i);
+		return;
+	}
+
+	std::atomic_size_t next_block = 0;
+	auto process = [&]()
+	{
+		size_t idx = 0;
+		while ((idx = next_block++) < in_count)
+			in_func(idx);
+	};
+
+	const jobsystem::Job& parent = jobsystem::create_job(jobsystem::JobType::Normal, [](const jobsystem::Job&) {});
+	for (size_t i = 0; i < job_count; ++i)
+	{
+		const jobsystem::Job& job = jobsystem::create_child_job(jobsystem::JobType::Normal, parent,
+			[&process](const jobsystem::Job&)
+			{
+				process();
+			});
+		jobsystem::schedule(job);
+	}
+
+	jobsystem::schedule(parent);
+	jobsystem::wait(parent);
+}
+
+/**
+ * Validate the header and the seek table of a block stream
+ */
+bool read_header(std::span<const uint8_t> in_data, BlockStreamHeader& out_header)
+{
+	if (in_data.size() < sizeof(BlockStreamHeader))
+		return false;
+
+	memcpy(&out_header, in_data.data(), sizeof(BlockStreamHeader));
+	if (out_header.magic != BlockStreamHeader::magic_value ||
+		out_header.version != BlockStreamHeader::current_version ||
+		out_header.block_size == 0)
+		return false;
+
+	const uint64_t expected_block_count = (out_header.uncompressed_size + out_header.block_size - 1) / out_header.block_size;
+	if (out_header.block_count != expected_block_count)
+		return false;
+
+	const uint64_t table_size = static_cast<uint64_t>(out_header.block_count) * sizeof(BlockEntry);
+	return table_size <= in_data.size() - sizeof(BlockStreamHeader);
+}
+
+ZE_FORCEINLINE BlockEntry get_block_entry(std::span<const uint8_t> in_data, const uint32_t in_block_idx)
+{
+	BlockEntry entry;
+	memcpy(&entry, in_data.data() + sizeof(BlockStreamHeader) + in_block_idx * sizeof(BlockEntry), sizeof(BlockEntry));
+	return entry;
+}
+
+ZE_FORCEINLINE size_t get_block_uncompressed_size(const BlockStreamHeader& in_header, const uint32_t in_block_idx)
+{
+	const uint64_t offset = static_cast<uint64_t>(in_block_idx) * in_header.block_size;
+	return std::min<uint64_t>(in_header.block_size, in_header.uncompressed_size - offset);
+}
+
+/**
+ * Decode a block to out_block, the size of out_block must be the exact uncompressed size of the block
+ */
+bool decode_block(std::span<const uint8_t> in_data, const BlockEntry& in_entry, std::span<uint8_t> out_block)
+{
+	if (in_entry.offset > in_data.size() || in_entry.compressed_size > in_data.size() - in_entry.offset)
+		return false;
+
+	const uint8_t* src = in_data.data() + in_entry.offset;
+	if (in_entry.stored)
+	{
+		if (in_entry.compressed_size != out_block.size())
+			return false;
+
+		memcpy(out_block.data(), src, out_block.size());
+		return true;
+	}
+
+	const int result = LZ4_decompress_safe(reinterpret_cast<const char*>(src),
+		reinterpret_cast<char*>(out_block.data()),
+		static_cast<int>(in_entry.compressed_size),
+		static_cast<int>(out_block.size()));
+	return result == static_cast<int>(out_block.size());
+}
+
+bool is_block_compressed(std::span<const uint8_t> in_data)
+{
+	if (in_data.size() < sizeof(uint32_t))
+		return false;
+
+	uint32_t magic = 0;
+	memcpy(&magic, in_data.data(), sizeof(uint32_t));
+	return magic == BlockStreamHeader::magic_value;
+}
+
+std::vector<uint8_t> compress_blocks(std::span<const uint8_t> in_data,
+	const uint32_t in_block_size,
+	BlockCompressionStats* out_stats)
+{
+	ZE_CHECK(in_block_size > 0 && in_block_size <= LZ4_MAX_INPUT_SIZE);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	BlockStreamHeader header;
+	header.magic = BlockStreamHeader::magic_value;
+	header.version = BlockStreamHeader::current_version;
+	header.block_size = in_block_size;
+	header.uncompressed_size = in_data.size();
+	header.block_count = static_cast<uint32_t>((in_data.size() + in_block_size - 1) / in_block_size);
+
+	/** Compress each block to its own buffer */
+	std::vector<std::vector<uint8_t>> blocks(header.block_count);
+	std::vector<BlockEntry> entries(header.block_count);
+	for_each_block(header.block_count, [&](const size_t in_idx)
+	{
+		std::span<const uint8_t> src = in_data.subspan(in_idx * in_block_size,
+			get_block_uncompressed_size(header, static_cast<uint32_t>(in_idx)));
+
+		std::vector<uint8_t>& block = blocks[in_idx];
+		block.resize(LZ4_compressBound(static_cast<int>(src.size())));
+		const int size = LZ4_compress_default(reinterpret_cast<const char*>(src.data()),
+			reinterpret_cast<char*>(block.data()),
+			static_cast<int>(src.size()),
+			static_cast<int>(block.size()));
+
+		/** Store incompressible blocks as-is */
+		if (size <= 0 || static_cast<size_t>(size) >= src.size())
+		{
+			block.assign(src.begin(), src.end());
+			entries[in_idx].stored = 1;
+		}
+		else
+		{
+			block.resize(size);
+			entries[in_idx].stored = 0;
+		}
+
+		entries[in_idx].compressed_size = static_cast<uint32_t>(block.size());
+	});
+
+	/** Build the stream */
+	uint64_t offset = sizeof(BlockStreamHeader) + header.block_count * sizeof(BlockEntry);
+	for (auto& entry : entries)
+	{
+		entry.offset = offset;
+		offset += entry.compressed_size;
+	}
+
+	std::vector<uint8_t> stream(offset);
+	memcpy(stream.data(), &header, sizeof(BlockStreamHeader));
+	if (!entries.empty())
+		memcpy(stream.data() + sizeof(BlockStreamHeader), entries.data(), entries.size() * sizeof(BlockEntry));
+	for (size_t i = 0; i < blocks.size(); ++i)
+		memcpy(stream.data() + entries[i].offset, blocks[i].data(), blocks[i].size());
+
+	if (out_stats)
+	{
+		out_stats->uncompressed_size = in_data.size();
+		out_stats->compressed_size = stream.size();
+		out_stats->block_count = header.block_count;
+		out_stats->time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	return stream;
+}
+
+bool decompress_blocks(std::span<const uint8_t> in_data, std::vector<uint8_t>& out_data,
+	BlockCompressionStats* out_stats)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	BlockStreamHeader header;
+	if (!read_header(in_data, header))
+	{
+		ze::logger::error("Invalid block compressed stream");
+		return false;
+	}
+
+	out_data.resize(header.uncompressed_size);
+
+	std::atomic_bool failed = false;
+	for_each_block(header.block_count, [&](const size_t in_idx)
+	{
+		const uint32_t block_idx = static_cast<uint32_t>(in_idx);
+		std::span<uint8_t> dst(out_data.data() + in_idx * header.block_size,
+			get_block_uncompressed_size(header, block_idx));
+		if (!decode_block(in_data, get_block_entry(in_data, block_idx), dst))
+			failed = true;
+	});
+
+	if (failed)
+	{
+		ze::logger::error("Corrupted block compressed stream");
+		out_data.clear();
+		return false;
+	}
+
+	if (out_stats)
+	{
+		out_stats->uncompressed_size = header.uncompressed_size;
+		out_stats->compressed_size = in_data.size();
+		out_stats->block_count = header.block_count;
+		out_stats->time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	return true;
+}
+
+size_t decompress_block(std::span<const uint8_t> in_data, const uint32_t in_block_idx,
+	std::span<uint8_t> out_block)
+{
+	BlockStreamHeader header;
+	if (!read_header(in_data, header) || in_block_idx >= header.block_count)
+		return 0;
+
+	const size_t size = get_block_uncompressed_size(header, in_block_idx);
+	if (out_block.size() < size)
+		return 0;
+
+	return decode_block(in_data, get_block_entry(in_data, in_block_idx), out_block.subspan(0, size)) ? size : 0;
+}
+
+}
@@ -1,5 +1,6 @@
 #include "console/Console.h"
 #include <charconv>
+#include <cstdlib>
 
 namespace ze
 {
@@ -24,79 +25,182 @@ CConsole& CConsole::Get()
 	return *console;
 }
 
-void CConsole::Execute(const std::string_view& InCmdName, 
+/**
+ * Parse in_value and set the convar
+ * \return false if the value is invalid for this convar
+ */
+bool set_convar_from_string(ConVar& in_convar, const std::string_view& in_value)
+{
+	switch(in_convar.get_type())
+	{
+	case ConVar::DataTypeInt32:
+	{
+		int32_t value = 0;
+		auto result = std::from_chars(in_value.data(), in_value.data() + in_value.size(), value);
+		if(result.ec != std::errc() || result.ptr != in_value.data() + in_value.size())
+			return false;
+
+		in_convar.set_int(value);
+		return true;
+	}
+	case ConVar::DataTypeFloat:
+	{
+		/** Clang doesn't have std::from_chars for floats, in_value may not be null terminated */
+		const std::string str(in_value);
+		char* end = nullptr;
+		const float value = std::strtof(str.c_str(), &end);
+		if(str.empty() || end != str.c_str() + str.size())
+			return false;
+
+		in_convar.set_float(value);
+		return true;
+	}
+	case ConVar::DataTypeString:
+		in_convar.set_string(std::string(in_value));
+		return true;
+	}
+
+	return false;
+}
+
+ConVar* CConsole::find_convar(const std::string_view& in_name)
+{
+	std::lock_guard<std::mutex> guard(registry_mutex);
+	auto it = ConVarMap.find(in_name);
+	return it != ConVarMap.end() ? &ConVars[it->second] : nullptr;
+}
+
+bool CConsole::register_command(const std::string& in_name, const std::string& in_help,
+	ConCmd::Function&& in_function)
+{
+	std::lock_guard<std::mutex> guard(registry_mutex);
+	if(ConCmdMap.contains(in_name))
+	{
+		ze::logger::warn("ConCmd \"{}\" is already registered", in_name);
+		return false;
+	}
+
+	ConCmd& command = ConCmds.emplace_back(in_name, in_help, std::move(in_function));
+	ConCmdMap.insert({ std::string_view(command.name), ConCmds.size() - 1 });
+	return true;
+}
+
+void CConsole::Execute(const std::string_view& InCmdName,
 	const std::vector<std::string_view>& InParams)
 {
-	/** Search for convars */
-	for(ConVar& ConVar : ConVars)
+	const ConCmd* command = nullptr;
 	{
-		if(ConVar.name == InCmdName)
+		std::lock_guard<std::mutex> guard(registry_mutex);
+		auto it = ConCmdMap.find(InCmdName);
+		if(it != ConCmdMap.end())
+			command = &ConCmds[it->second];
+	}
+
+	/** Commands are executed outside the lock so they can use the console */
+	if(command)
+	{
+		command->function.execute(InParams);
+		return;
+	}
+
+	ConVar* convar = find_convar(InCmdName);
+	if(!convar)
+	{
+		ze::logger::error("Unknown concmd/convar \"{}\"", InCmdName);
+		return;
+	}
+
+	if(InParams.empty())
+	{
+		if(convar->get_type() == ConVar::DataTypeFloat)
+			ze::logger::error("Invalid syntax.\n{}\n\t- Min: {}\n\t- Max: {}\n\t- Current: {}",
+				convar->help.c_str(),
+				convar->get_min_as_float(), convar->get_max_as_float(),
+				convar->get_as_float());
+		else if (convar->get_type() == ConVar::DataTypeInt32)
+			ze::logger::error(
+				"Invalid syntax\n{}\n\t- Min: {}\n\t- Max: {}\n\t- Current: {}",
+				convar->help.c_str(),
+				convar->get_min_as_int(), convar->get_max_as_int(),
+				convar->get_as_int());
+		else
+			ze::logger::error("Invalid syntax\n{}\n\t- Current: {}",
+				convar->help.c_str(),
+				convar->get_as_string().c_str());
+		return;
+	}
+
+	if(!set_convar_from_string(*convar, InParams[0]))
+	{
+		ze::logger::error("Invalid argument \"{}\"", InParams[0]);
+		return;
+	}
+
+	ze::logger::info("\"{}\" changed to \"{}\"", InCmdName, InParams[0]);
+}
+
+size_t CConsole::apply_config(const std::string_view& in_config)
+{
+	struct Entry
+	{
+		ConVar* convar;
+		std::string_view name;
+		std::string_view value;
+	};
+
+	constexpr std::string_view whitespaces = " \t\r";
+
+	/** Names are resolved in a single pass under the lock, convars are set outside so delegates can use the console */
+	std::vector<Entry> entries;
+	{
+		std::lock_guard<std::mutex> guard(registry_mutex);
+
+		size_t line_start = 0;
+		while(line_start < in_config.size())
 		{
-			if(InParams.empty())
-			{
-				if(ConVar.data.index() == ConVar::DataTypeFloat)
-					ze::logger::error("Invalid syntax.\n{}\n\t- Min: {}\n\t- Max: {}\n\t- Current: {}", 
-						ConVar.help.c_str(),
-						ConVar.get_min_as_float(), ConVar.get_max_as_float(),
-						ConVar.get_max_as_float());
-				else if (ConVar.data.index() == ConVar::DataTypeInt32)
-					ze::logger::error( 
-						"Invalid syntax\n{}\n\t- Min: {}\n\t- Max: {}\n\t- Current: {}", 
-						ConVar.help.c_str(),
-						ConVar.get_min_as_int(), ConVar.get_max_as_int(),
-						ConVar.get_as_int());
-				else
-					ze::logger::error("Invalid syntax\n{}\n\t- Current:", 
-						ConVar.help.c_str(),
-						ConVar.get_as_string().c_str());
-			}
-			else
-			{
-				const auto& Arg = InParams[0];
-				switch(ConVar.data.index())
-				{
-				case ConVar::DataTypeInt32:
-				{
-					int32_t Int = 0;
-					auto Result = std::from_chars(Arg.data(), Arg.data() + Arg.size(), Int);
-					if(Result.ec == std::errc::invalid_argument)
-					{
-						ze::logger::error("Invalid argument \"{}\"", InParams[0].data());
-						return;
-					}
-					else
-						ConVar.set_int(Int);
-
-					break;
-				}
-				case ConVar::DataTypeFloat:
-				{
-					// For some reasons
-					// Clang doesn't have std::from_chars for floats
-					float Float = static_cast<float>(std::atof(Arg.data()));
-
-					/*if (Result.ec == std::errc::invalid_argument)
-					{
-						ze::logger::error("Invalid argument \"{}\"", InParams[0].data());
-						return;
-					}
-					else*/
-						ConVar.set_float(Float);
-					break;
-				}
-				case ConVar::DataTypeString:
-					ConVar.set_string(InParams[0].data());
-					break;
-				}
-
-				ze::logger::info("\"{}\" changed to \"{}\"", InCmdName.data(),
-					InParams[0].data());
-			}
-			return;
+			size_t line_end = in_config.find('\n', line_start);
+			if(line_end == std::string_view::npos)
+				line_end = in_config.size();
+
+			std::string_view line = in_config.substr(line_start, line_end - line_start);
+			line_start = line_end + 1;
+
+			const size_t first = line.find_first_not_of(whitespaces);
+			if(first == std::string_view::npos)
+				continue;
+
+			line = line.substr(first, line.find_last_not_of(whitespaces) - first + 1);
+			if(line.starts_with('#') || line.starts_with("//"))
+				continue;
+
+			const size_t name_end = line.find_first_of(whitespaces);
+			const std::string_view name = line.substr(0, name_end);
+			std::string_view value = name_end != std::string_view::npos ?
+				line.substr(line.find_first_not_of(whitespaces, name_end)) : std::string_view();
+			if(value.size() >= 2 && value.front() == '"' && value.back() == '"')
+				value = value.substr(1, value.size() - 2);
+
+			auto it = ConVarMap.find(name);
+			entries.push_back({ it != ConVarMap.end() ? &ConVars[it->second] : nullptr, name, value });
 		}
 	}
 
-	ze::logger::error("Unknown concmd/convar \"{}\"", InCmdName.data());
+	size_t count = 0;
+	for(const Entry& entry : entries)
+	{
+		if(!entry.convar)
+		{
+			ze::logger::warn("Config: unknown convar \"{}\"", entry.name);
+			continue;
+		}
+
+		if(set_convar_from_string(*entry.convar, entry.value))
+			count++;
+		else
+			ze::logger::warn("Config: invalid value \"{}\" for convar \"{}\"", entry.value, entry.name);
+	}
+
+	return count;
 }
 
-}
\ No newline at end of file
+}
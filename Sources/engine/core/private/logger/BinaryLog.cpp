@@ -0,0 +1,880 @@
+#include "logger/BinaryLog.h"
+#include "logger/Logger.h"
+#include "threading/Thread.h"
+#include <robin_hood.h>
+#include <fmt/args.h>
+#include <fmt/chrono.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ze::logger::binary
+{
+
+/**
+ * Single producer single consumer ring of records
+ * Records are contiguous, when a record doesn't fit before the end of the ring the remaining space
+ *	is skipped (marked by a format id of 0)
+ */
+struct ThreadBuffer
+{
+	static constexpr uint32_t padding_format_id = 0;
+	static constexpr uint32_t record_alignment = 8;
+
+	std::unique_ptr<uint8_t[]> data;
+	uint64_t capacity;
+	uint64_t mask;
+	std::thread::id thread_id;
+	uint32_t index;
+
+	/** Producer side */
+	alignas(64) std::atomic_uint64_t head;
+	uint64_t reserved_head;
+	std::atomic_uint64_t dropped;
+	std::atomic_bool thread_exited;
+
+	/** Consumer side */
+	alignas(64) std::atomic_uint64_t tail;
+	bool thread_written;
+
+	ThreadBuffer(const size_t in_capacity, const uint32_t in_index) :
+		capacity(std::bit_ceil(std::max<size_t>(in_capacity, 4096))), mask(capacity - 1),
+		thread_id(std::this_thread::get_id()), index(in_index), head(0), reserved_head(0), dropped(0),
+		thread_exited(false), tail(0), thread_written(false)
+	{
+		data = std::make_unique<uint8_t[]>(capacity);
+	}
+};
+
+struct Format
+{
+	SeverityFlagBits severity;
+	std::string format;
+	std::string file;
+	uint32_t line;
+	std::vector<ArgType> arg_types;
+};
+
+/** Marks the buffer of an exiting thread so the writer can release it once drained */
+struct ThreadBufferHandle
+{
+	std::shared_ptr<ThreadBuffer> buffer;
+	uint64_t session;
+
+	ThreadBufferHandle() : session(0) {}
+
+	~ThreadBufferHandle()
+	{
+		if (buffer)
+			buffer->thread_exited = true;
+	}
+};
+
+Settings settings;
+std::atomic_uint32_t enabled_severities = 0;
+std::atomic_uint64_t session = 0;
+
+/** Formats and thread buffers */
+std::mutex registry_mutex;
+std::vector<Format> formats;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+uint32_t next_thread_index = 0;
+
+/** Writer thread */
+std::mutex writer_mutex;
+std::condition_variable writer_condition_var;
+std::thread writer_thread;
+bool stop_requested = false;
+std::unique_ptr<std::streambuf> stream;
+std::function<std::unique_ptr<std::streambuf>()> stream_factory;
+size_t written_format_count = 0;
+
+thread_local ThreadBufferHandle thread_buffer;
+
+/** Trivial thread locals for the hot path, the handle above is only touched when the buffer changes */
+thread_local ThreadBuffer* current_buffer = nullptr;
+thread_local uint64_t current_session = 0;
+
+template<typename T>
+void append(std::vector<uint8_t>& out_data, const T& in_value)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&in_value);
+	out_data.insert(out_data.end(), bytes, bytes + sizeof(T));
+}
+
+void append_string(std::vector<uint8_t>& out_data, const std::string_view& in_string)
+{
+	append(out_data, static_cast<uint32_t>(in_string.size()));
+	out_data.insert(out_data.end(), in_string.begin(), in_string.end());
+}
+
+ZE_FORCEINLINE uint64_t align_record_size(const uint64_t in_size)
+{
+	return (in_size + ThreadBuffer::record_alignment - 1) & ~uint64_t(ThreadBuffer::record_alignment - 1);
+}
+
+void start_on_first_use();
+
+namespace detail
+{
+
+uint8_t* begin_record(const uint32_t in_size)
+{
+	if (current_session != session.load(std::memory_order_acquire) || !current_buffer)
+	{
+		/** Every thread goes through here before writing its first record of a session */
+		start_on_first_use();
+
+		std::lock_guard<std::mutex> guard(registry_mutex);
+		if (thread_buffer.buffer)
+			thread_buffer.buffer->thread_exited = true;
+
+		thread_buffer.buffer = std::make_shared<ThreadBuffer>(settings.thread_buffer_size, next_thread_index++);
+		thread_buffer.session = session.load(std::memory_order_acquire);
+		buffers.emplace_back(thread_buffer.buffer);
+		current_buffer = thread_buffer.buffer.get();
+		current_session = thread_buffer.session;
+	}
+
+	ThreadBuffer& buffer = *current_buffer;
+	const uint64_t size = align_record_size(in_size);
+	uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	const uint64_t tail = buffer.tail.load(std::memory_order_acquire);
+	const uint64_t offset = head & buffer.mask;
+	const uint64_t padding = offset + size > buffer.capacity ? buffer.capacity - offset : 0;
+	if (head + padding + size - tail > buffer.capacity)
+	{
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	if (padding > 0)
+	{
+		const uint32_t padding_id = ThreadBuffer::padding_format_id;
+		memcpy(buffer.data.get() + offset, &padding_id, sizeof(padding_id));
+		head += padding;
+	}
+
+	buffer.reserved_head = head;
+	return buffer.data.get() + (head & buffer.mask);
+}
+
+void end_record(const uint32_t in_size)
+{
+	ThreadBuffer& buffer = *current_buffer;
+	buffer.head.store(buffer.reserved_head + align_record_size(in_size), std::memory_order_release);
+}
+
+}
+
+int64_t get_system_time()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+struct PendingRecord
+{
+	const detail::RecordHeader* header;
+	uint32_t thread_index;
+};
+
+/**
+ * Collect the records of every thread buffer, sort them by time and write them
+ * Must be called with writer_mutex locked
+ */
+void write_pending_records()
+{
+	std::vector<uint8_t> data;
+	std::vector<std::shared_ptr<ThreadBuffer>> current_buffers;
+	{
+		std::lock_guard<std::mutex> guard(registry_mutex);
+		for (; written_format_count < formats.size(); ++written_format_count)
+		{
+			const Format& format = formats[written_format_count];
+			append(data, EntryType::Format);
+			append(data, static_cast<uint32_t>(written_format_count + 1));
+			append(data, static_cast<uint8_t>(format.severity));
+			append(data, format.line);
+			append(data, static_cast<uint8_t>(format.arg_types.size()));
+			data.insert(data.end(), reinterpret_cast<const uint8_t*>(format.arg_types.data()),
+				reinterpret_cast<const uint8_t*>(format.arg_types.data() + format.arg_types.size()));
+			append_string(data, format.format);
+			append_string(data, format.file);
+		}
+
+		current_buffers = buffers;
+	}
+
+	std::vector<PendingRecord> records;
+	std::vector<uint64_t> heads(current_buffers.size());
+	for (size_t i = 0; i < current_buffers.size(); ++i)
+	{
+		ThreadBuffer& buffer = *current_buffers[i];
+		if (!buffer.thread_written)
+		{
+			append(data, EntryType::Thread);
+			append(data, buffer.index);
+			append_string(data, threading::get_thread_name(buffer.thread_id));
+			buffer.thread_written = true;
+		}
+
+		if (const uint64_t dropped = buffer.dropped.exchange(0))
+		{
+			append(data, EntryType::Dropped);
+			append(data, buffer.index);
+			append(data, dropped);
+		}
+
+		const uint64_t head = buffer.head.load(std::memory_order_acquire);
+		for (uint64_t pos = buffer.tail.load(std::memory_order_relaxed); pos < head; )
+		{
+			const uint64_t offset = pos & buffer.mask;
+			const auto* header = reinterpret_cast<const detail::RecordHeader*>(buffer.data.get() + offset);
+			if (header->format_id == ThreadBuffer::padding_format_id)
+			{
+				pos += buffer.capacity - offset;
+				continue;
+			}
+
+			records.push_back({ header, buffer.index });
+			pos += align_record_size(header->size);
+		}
+
+		heads[i] = head;
+	}
+
+	/** Sampled after the heads, so every record of the batch is older */
+	if (!records.empty())
+	{
+		append(data, EntryType::Clock);
+		append(data, detail::get_timestamp());
+		append(data, get_system_time());
+	}
+
+	std::stable_sort(records.begin(), records.end(),
+		[](const PendingRecord& left, const PendingRecord& right)
+		{
+			return left.header->timestamp < right.header->timestamp;
+		});
+
+	for (const auto& record : records)
+	{
+		const uint32_t args_size = record.header->size - static_cast<uint32_t>(sizeof(detail::RecordHeader));
+		const uint8_t* args = reinterpret_cast<const uint8_t*>(record.header + 1);
+		append(data, EntryType::Record);
+		append(data, record.header->format_id);
+		append(data, record.thread_index);
+		append(data, record.header->timestamp);
+		append(data, args_size);
+		data.insert(data.end(), args, args + args_size);
+	}
+
+	if (!data.empty())
+	{
+		stream->sputn(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		stream->pubsync();
+	}
+
+	/** Records are copied, give the space back to the threads */
+	for (size_t i = 0; i < current_buffers.size(); ++i)
+		current_buffers[i]->tail.store(heads[i], std::memory_order_release);
+
+	std::lock_guard<std::mutex> guard(registry_mutex);
+	std::erase_if(buffers, [](const std::shared_ptr<ThreadBuffer>& in_buffer)
+	{
+		return in_buffer->thread_exited && in_buffer->tail == in_buffer->head;
+	});
+}
+
+void writer_thread_main()
+{
+	threading::set_thread_name("Binary Log Thread");
+
+	std::unique_lock<std::mutex> lock(writer_mutex);
+	while (!stop_requested)
+	{
+		writer_condition_var.wait_for(lock, settings.write_interval, []() { return stop_requested; });
+		write_pending_records();
+	}
+}
+
+/**
+ * Start a new session, threads will allocate new buffers
+ * Must be called with writer_mutex locked
+ */
+void begin_session(const Settings& in_settings)
+{
+	{
+		std::lock_guard<std::mutex> registry_guard(registry_mutex);
+		settings = in_settings;
+		buffers.clear();
+		next_thread_index = 0;
+	}
+
+	session.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Write the file header and start the writer thread
+ * Must be called with writer_mutex locked
+ */
+bool start(std::unique_ptr<std::streambuf>&& in_stream)
+{
+	if (!in_stream)
+		return false;
+
+	FileHeader header;
+	header.magic = FileHeader::magic_value;
+	header.version = FileHeader::current_version;
+	header.padding = 0;
+	header.system_time = get_system_time();
+	header.timestamp = detail::get_timestamp();
+	if (in_stream->sputn(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+		return false;
+
+	stream = std::move(in_stream);
+	written_format_count = 0;
+	stop_requested = false;
+	writer_thread = std::thread(&writer_thread_main);
+	return true;
+}
+
+void start_on_first_use()
+{
+	std::lock_guard<std::mutex> guard(writer_mutex);
+	if (stream || !stream_factory)
+		return;
+
+	auto factory = std::move(stream_factory);
+	stream_factory = nullptr;
+	if (!start(factory()))
+	{
+		enabled_severities = 0;
+		logger::error("Failed to open the binary log, ZE_LOG_BINARY records are discarded");
+	}
+}
+
+bool open(std::unique_ptr<std::streambuf>&& in_stream, const Settings& in_settings)
+{
+	std::lock_guard<std::mutex> guard(writer_mutex);
+	if (stream || stream_factory || !in_stream)
+		return false;
+
+	begin_session(in_settings);
+	if (!start(std::move(in_stream)))
+		return false;
+
+	enabled_severities = static_cast<uint32_t>(
+		static_cast<std::underlying_type_t<SeverityFlagBits>>(in_settings.severity_flags));
+	return true;
+}
+
+bool open_on_first_use(std::function<std::unique_ptr<std::streambuf>()>&& in_stream_factory,
+	const Settings& in_settings)
+{
+	std::lock_guard<std::mutex> guard(writer_mutex);
+	if (stream || stream_factory || !in_stream_factory)
+		return false;
+
+	begin_session(in_settings);
+	stream_factory = std::move(in_stream_factory);
+	enabled_severities = static_cast<uint32_t>(
+		static_cast<std::underlying_type_t<SeverityFlagBits>>(in_settings.severity_flags));
+	return true;
+}
+
+void close()
+{
+	{
+		std::lock_guard<std::mutex> guard(writer_mutex);
+		enabled_severities = 0;
+
+		/** Opened with open_on_first_use but never reached */
+		stream_factory = nullptr;
+		if (!stream)
+			return;
+
+		stop_requested = true;
+	}
+
+	writer_condition_var.notify_one();
+	writer_thread.join();
+
+	std::lock_guard<std::mutex> guard(writer_mutex);
+	write_pending_records();
+	stream.reset();
+}
+
+bool is_enabled(SeverityFlagBits severity)
+{
+	return enabled_severities.load(std::memory_order_relaxed) & static_cast<uint32_t>(severity);
+}
+
+uint32_t register_format(SeverityFlagBits severity, std::string_view format,
+	std::string_view file, uint32_t line, std::span<const ArgType> arg_types)
+{
+	std::lock_guard<std::mutex> guard(registry_mutex);
+	formats.push_back({ severity, std::string(format), std::string(file), line,
+		std::vector<ArgType>(arg_types.begin(), arg_types.end()) });
+	return static_cast<uint32_t>(formats.size());
+}
+
+/** Decoder */
+
+template<typename T>
+bool read(std::istream& in_stream, T& out_value)
+{
+	return static_cast<bool>(in_stream.read(reinterpret_cast<char*>(&out_value), sizeof(T)));
+}
+
+/** Limit of strings and records when the size of the decoded stream is unknown */
+constexpr uint64_t max_unsized_length = 16 * 1024 * 1024;
+
+/**
+ * Check in_size bytes can still be read, so sizes read from a corrupted log never trigger huge allocations
+ * \param in_end End of the stream, -1 if unknown
+ */
+bool can_read(std::istream& in_stream, const std::streamoff in_end, const uint64_t in_size)
+{
+	if (in_end < 0)
+		return in_size <= max_unsized_length;
+
+	const std::streamoff position = in_stream.tellg();
+	return position >= 0 && position <= in_end && in_size <= static_cast<uint64_t>(in_end - position);
+}
+
+bool read_string(std::istream& in_stream, const std::streamoff in_end, std::string& out_string)
+{
+	uint32_t size = 0;
+	if (!read(in_stream, size) || !can_read(in_stream, in_end, size))
+		return false;
+
+	out_string.resize(size);
+	return static_cast<bool>(in_stream.read(out_string.data(), size));
+}
+
+/**
+ * Read an argument from a record
+ * \return false if the record is too small
+ */
+template<typename T>
+bool read_arg(std::span<const uint8_t>& in_args, fmt::dynamic_format_arg_store<fmt::format_context>& out_store,
+	const bool in_is_bool = false)
+{
+	if (in_args.size() < sizeof(T))
+		return false;
+
+	T value;
+	memcpy(&value, in_args.data(), sizeof(T));
+	in_args = in_args.subspan(sizeof(T));
+	if constexpr (std::is_same_v<T, uint8_t>)
+	{
+		/** Bools are read as bytes, any byte value isn't a valid bool */
+		if (in_is_bool)
+		{
+			out_store.push_back(value != 0);
+			return true;
+		}
+	}
+
+	out_store.push_back(value);
+	return true;
+}
+
+bool decode_args(const Format& in_format, std::span<const uint8_t> in_args,
+	fmt::dynamic_format_arg_store<fmt::format_context>& out_store)
+{
+	for (const ArgType& type : in_format.arg_types)
+	{
+		bool valid = false;
+		switch (type)
+		{
+		case ArgType::Bool: valid = read_arg<uint8_t>(in_args, out_store, true); break;
+		case ArgType::Char: valid = read_arg<char>(in_args, out_store); break;
+		case ArgType::Int8: valid = read_arg<int8_t>(in_args, out_store); break;
+		case ArgType::Int16: valid = read_arg<int16_t>(in_args, out_store); break;
+		case ArgType::Int32: valid = read_arg<int32_t>(in_args, out_store); break;
+		case ArgType::Int64: valid = read_arg<int64_t>(in_args, out_store); break;
+		case ArgType::UInt8: valid = read_arg<uint8_t>(in_args, out_store); break;
+		case ArgType::UInt16: valid = read_arg<uint16_t>(in_args, out_store); break;
+		case ArgType::UInt32: valid = read_arg<uint32_t>(in_args, out_store); break;
+		case ArgType::UInt64: valid = read_arg<uint64_t>(in_args, out_store); break;
+		case ArgType::Float: valid = read_arg<float>(in_args, out_store); break;
+		case ArgType::Double: valid = read_arg<double>(in_args, out_store); break;
+		case ArgType::String:
+		{
+			uint32_t size = 0;
+			if (in_args.size() < sizeof(size))
+				break;
+
+			memcpy(&size, in_args.data(), sizeof(size));
+			in_args = in_args.subspan(sizeof(size));
+			if (in_args.size() < size)
+				break;
+
+			out_store.push_back(std::string(reinterpret_cast<const char*>(in_args.data()), size));
+			in_args = in_args.subspan(size);
+			valid = true;
+			break;
+		}
+		case ArgType::Pointer:
+		{
+			uint64_t address = 0;
+			if (in_args.size() < sizeof(address))
+				break;
+
+			memcpy(&address, in_args.data(), sizeof(address));
+			in_args = in_args.subspan(sizeof(address));
+			out_store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(address)));
+			valid = true;
+			break;
+		}
+		}
+
+		if (!valid)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Check a replacement field spec is valid for this argument type
+ * Only a conservative subset of the fmt syntax is accepted: [[fill]align][sign]['#']['0'][width]['.' precision][type]
+ */
+bool is_valid_format_spec(const std::string_view& in_spec, const ArgType in_type)
+{
+	const bool is_signed = in_type >= ArgType::Int8 && in_type <= ArgType::Int64;
+	const bool is_integer = is_signed || (in_type >= ArgType::UInt8 && in_type <= ArgType::UInt64);
+	const bool is_float = in_type == ArgType::Float || in_type == ArgType::Double;
+
+	auto is_align = [](const char in_char) { return in_char == '<' || in_char == '>' || in_char == '^'; };
+	auto is_digit = [](const char in_char) { return in_char >= '0' && in_char <= '9'; };
+
+	size_t i = 0;
+	if (in_spec.size() >= 2 && is_align(in_spec[1]) && in_spec[0] != '{' && in_spec[0] != '}' &&
+		static_cast<uint8_t>(in_spec[0]) < 0x80)
+		i = 2;
+	else if (!in_spec.empty() && is_align(in_spec[0]))
+		i = 1;
+
+	if (i < in_spec.size() && (in_spec[i] == '+' || in_spec[i] == '-' || in_spec[i] == ' '))
+	{
+		if (!is_signed && !is_float)
+			return false;
+		i++;
+	}
+
+	if (i < in_spec.size() && in_spec[i] == '#')
+	{
+		if (!is_integer && !is_float)
+			return false;
+		i++;
+	}
+
+	/** Widths and precisions are bounded so a corrupted format can't request a huge output */
+	auto skip_number = [&]()
+	{
+		const size_t start = i;
+		while (i < in_spec.size() && is_digit(in_spec[i]))
+			i++;
+		return i - start <= 4;
+	};
+
+	if (i < in_spec.size() && in_spec[i] == '0')
+	{
+		if (!is_integer && !is_float)
+			return false;
+		i++;
+	}
+
+	if (!skip_number())
+		return false;
+
+	if (i < in_spec.size() && in_spec[i] == '.')
+	{
+		if (!is_float && in_type != ArgType::String)
+			return false;
+
+		i++;
+		const size_t start = i;
+		if (!skip_number() || i == start)
+			return false;
+	}
+
+	if (i == in_spec.size())
+		return true;
+
+	if (i + 1 != in_spec.size())
+		return false;
+
+	std::string_view types;
+	if (is_integer)
+		types = "bBdoxX";
+	else if (is_float)
+		types = "aAeEfFgG";
+	else if (in_type == ArgType::String || in_type == ArgType::Bool)
+		types = "s";
+	else if (in_type == ArgType::Char)
+		types = "c";
+	else if (in_type == ArgType::Pointer)
+		types = "p";
+
+	return types.find(in_spec[i]) != std::string_view::npos;
+}
+
+/**
+ * Check fmt can format in_format with its arguments
+ * Exceptions are disabled so fmt aborts on invalid format strings, which a corrupted log can contain
+ */
+bool is_valid_format(const Format& in_format)
+{
+	const std::string_view format = in_format.format;
+	size_t next_arg = 0;
+	bool automatic_ids = false;
+	bool manual_ids = false;
+	for (size_t i = 0; i < format.size(); ++i)
+	{
+		if (format[i] == '}')
+		{
+			if (i + 1 == format.size() || format[i + 1] != '}')
+				return false;
+
+			i++;
+			continue;
+		}
+
+		if (format[i] != '{')
+			continue;
+
+		if (i + 1 < format.size() && format[i + 1] == '{')
+		{
+			i++;
+			continue;
+		}
+
+		const size_t end = format.find('}', i);
+		if (end == std::string_view::npos)
+			return false;
+
+		const std::string_view field = format.substr(i + 1, end - i - 1);
+		const size_t colon = field.find(':');
+		const std::string_view id = field.substr(0, colon);
+		size_t arg = 0;
+		if (id.empty())
+		{
+			automatic_ids = true;
+			arg = next_arg++;
+		}
+		else
+		{
+			if (id.size() > 3 || (id.size() > 1 && id[0] == '0'))
+				return false;
+
+			for (const char& c : id)
+			{
+				if (c < '0' || c > '9')
+					return false;
+				arg = arg * 10 + (c - '0');
+			}
+			manual_ids = true;
+		}
+
+		if ((automatic_ids && manual_ids) || arg >= in_format.arg_types.size() ||
+			!is_valid_format_spec(colon == std::string_view::npos ? std::string_view() : field.substr(colon + 1),
+				in_format.arg_types[arg]))
+			return false;
+
+		i = end;
+	}
+
+	return true;
+}
+
+/**
+ * Maps timestamps to the system time, using the log start and the latest clock entry
+ */
+struct ClockMapping
+{
+	int64_t start_timestamp;
+	int64_t start_system_time;
+	int64_t timestamp;
+	int64_t system_time;
+
+	/** Computed with doubles, timestamps of a corrupted log may overflow */
+	int64_t to_system_time(const int64_t in_timestamp) const
+	{
+		const double ticks = static_cast<double>(in_timestamp) - static_cast<double>(start_timestamp);
+		const double ns_per_tick = timestamp <= start_timestamp ? 1.0 :
+			(static_cast<double>(system_time) - static_cast<double>(start_system_time)) /
+			(static_cast<double>(timestamp) - static_cast<double>(start_timestamp));
+		const double time = static_cast<double>(start_system_time) + ticks * ns_per_tick;
+		return std::abs(time) < 9.0e18 ? static_cast<int64_t>(time) : 0;
+	}
+};
+
+std::string format_time(const ClockMapping& in_clock, const int64_t in_timestamp)
+{
+	const int64_t time = in_clock.to_system_time(in_timestamp);
+	const std::time_t seconds = static_cast<std::time_t>(time / 1000000000);
+	const int64_t milliseconds = (time / 1000000) % 1000;
+
+	const std::tm* local_time = ::localtime(&seconds);
+	if (!local_time)
+		return "??:??:??.???";
+
+	return fmt::format("{:02}:{:02}:{:02}.{:03}", local_time->tm_hour, local_time->tm_min, local_time->tm_sec,
+		milliseconds);
+}
+
+bool decode(std::istream& in_stream, std::ostream& out_stream)
+{
+	/** Lengths read from the log are checked against the stream size */
+	std::streamoff end = -1;
+	const std::streamoff start = in_stream.tellg();
+	if (start >= 0 && in_stream.seekg(0, std::ios::end))
+	{
+		end = in_stream.tellg();
+		in_stream.seekg(start);
+	}
+	in_stream.clear();
+
+	FileHeader header;
+	if (!read(in_stream, header) || header.magic != FileHeader::magic_value ||
+		header.version != FileHeader::current_version)
+	{
+		logger::error("Invalid binary log: bad magic or unsupported version");
+		return false;
+	}
+
+	ClockMapping clock;
+	clock.start_timestamp = clock.timestamp = header.timestamp;
+	clock.start_system_time = clock.system_time = header.system_time;
+
+	robin_hood::unordered_map<uint32_t, Format> decoded_formats;
+	robin_hood::unordered_set<uint32_t> invalid_formats;
+	robin_hood::unordered_map<uint32_t, std::string> thread_names;
+	std::vector<uint8_t> args;
+	while (true)
+	{
+		EntryType type;
+		if (!read(in_stream, type))
+			return in_stream.eof();
+
+		switch (type)
+		{
+		case EntryType::Format:
+		{
+			uint32_t id = 0;
+			uint8_t severity = 0;
+			uint8_t arg_count = 0;
+			Format format;
+			if (!read(in_stream, id) || !read(in_stream, severity) || !read(in_stream, format.line) ||
+				!read(in_stream, arg_count))
+				return false;
+
+			format.severity = static_cast<SeverityFlagBits>(severity);
+			format.arg_types.resize(arg_count);
+			if (!in_stream.read(reinterpret_cast<char*>(format.arg_types.data()), arg_count) ||
+				!read_string(in_stream, end, format.format) || !read_string(in_stream, end, format.file))
+				return false;
+
+			for (const ArgType& arg_type : format.arg_types)
+			{
+				if (arg_type > ArgType::Pointer)
+				{
+					logger::error("Invalid binary log: unknown argument type {}", static_cast<uint32_t>(arg_type));
+					return false;
+				}
+			}
+
+			/** Records of an invalid format are written unformatted */
+			if (is_valid_format(format))
+			{
+				invalid_formats.erase(id);
+			}
+			else
+			{
+				logger::warn("Binary log format \"{}\" ({}:{}) doesn't match its arguments", format.format,
+					format.file, format.line);
+				invalid_formats.insert(id);
+			}
+
+			decoded_formats[id] = std::move(format);
+			break;
+		}
+		case EntryType::Thread:
+		{
+			uint32_t index = 0;
+			std::string name;
+			if (!read(in_stream, index) || !read_string(in_stream, end, name))
+				return false;
+
+			thread_names[index] = std::move(name);
+			break;
+		}
+		case EntryType::Record:
+		{
+			uint32_t format_id = 0;
+			uint32_t thread_index = 0;
+			int64_t timestamp = 0;
+			uint32_t args_size = 0;
+			if (!read(in_stream, format_id) || !read(in_stream, thread_index) ||
+				!read(in_stream, timestamp) || !read(in_stream, args_size) || !can_read(in_stream, end, args_size))
+				return false;
+
+			args.resize(args_size);
+			if (!in_stream.read(reinterpret_cast<char*>(args.data()), args_size))
+				return false;
+
+			auto format_it = decoded_formats.find(format_id);
+			if (format_it == decoded_formats.end())
+			{
+				logger::error("Invalid binary log: unknown format {}", format_id);
+				return false;
+			}
+
+			const Format& format = format_it->second;
+			fmt::dynamic_format_arg_store<fmt::format_context> store;
+			if (!decode_args(format, args, store))
+			{
+				logger::error("Invalid binary log: corrupted record of format {} ({}:{})", format_id,
+					format.file, format.line);
+				return false;
+			}
+
+			out_stream << fmt::format("({}) [{}/{}] {}\n", format_time(clock, timestamp),
+				get_severity_as_string(format.severity), thread_names[thread_index],
+				invalid_formats.contains(format_id) ? format.format : fmt::vformat(format.format, store));
+			break;
+		}
+		case EntryType::Dropped:
+		{
+			uint32_t thread_index = 0;
+			uint64_t count = 0;
+			if (!read(in_stream, thread_index) || !read(in_stream, count))
+				return false;
+
+			out_stream << fmt::format("[WARN/{}] {} records dropped, the thread buffer was full\n",
+				thread_names[thread_index], count);
+			break;
+		}
+		case EntryType::Clock:
+			if (!read(in_stream, clock.timestamp) || !read(in_stream, clock.system_time))
+				return false;
+			break;
+		default:
+			logger::error("Invalid binary log: unknown entry type {}", static_cast<uint32_t>(type));
+			return false;
+		}
+	}
+}
+
+}
@@ -4,60 +4,328 @@
 #include <mutex>
 #include <sstream>
 #include "module/Module.h"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include "threading/Thread.h"
+#include "threading/Mutex.h"
 #include "logger/Sink.h"
+#include "logger/MessageQueue.h"
 #include "App.h"
 #include "MessageBox.h"
 
 namespace ze::logger
 {
 
-std::mutex logger_mutex;
+/** Max messages written between two checks of the flush/dropped state */
+static constexpr size_t max_batch_size = 256;
+
+/** Fallback wake up of the logger thread, producers only notify it when it sleeps */
+static constexpr std::chrono::milliseconds idle_wait_time(10);
+
+/**
+ * Protects sinks, held by the logger thread while it writes a batch
+ * Constant-initialized, other static initializers may log
+ */
+constinit Mutex logger_mutex("Logger");
 std::vector<std::unique_ptr<Sink>> sinks;
 
+/** Severities accepted by at least one sink, fatal messages are always logged */
+std::atomic_uint32_t enabled_severities = static_cast<uint32_t>(SeverityFlagBits::Fatal);
+
+AsyncSettings async_settings;
+std::unique_ptr<MessageQueue<Message>> queue;
+std::atomic_bool async_running = false;
+
+/** Producers that saw async_running and may still use the queue, stop_async waits for them before freeing it */
+std::atomic_uint32_t active_producers = 0;
+std::atomic_bool stop_requested = false;
+std::thread logger_thread;
+
+/** Producer and consumer counters, used by flush */
+std::atomic_uint64_t pushed_count = 0;
+std::atomic_uint64_t processed_count = 0;
+std::atomic_uint64_t dropped_count = 0;
+std::atomic_uint64_t flush_target = 0;
+
+/** Processed count when sinks were last flushed */
+std::atomic_uint64_t flushed_count = 0;
+thread_local bool is_logger_thread = false;
+
+std::mutex wake_mutex;
+std::condition_variable wake_condition_var;
+std::atomic_bool logger_thread_sleeping = false;
+std::condition_variable flushed_condition_var;
+
+/** Must be called with logger_mutex locked */
+void write_message(const Message& message)
+{
+	for(const auto& sink : sinks)
+	{
+		if(sink->get_severity_flags() & message.severity)
+			sink->log(message);
+	}
+}
+
+/** Must be called with logger_mutex locked */
+void flush_sinks()
+{
+	for(const auto& sink : sinks)
+		sink->flush();
+}
+
+void wake_logger_thread()
+{
+	if (logger_thread_sleeping.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> guard(wake_mutex);
+		wake_condition_var.notify_one();
+	}
+}
+
+/**
+ * Write queued messages until the queue is empty or a batch is full
+ * \return The number of messages written
+ */
+size_t write_batch(bool& out_urgent)
+{
+	size_t count = 0;
+	while (count < max_batch_size)
+	{
+		std::optional<Message> message = queue->try_pop();
+		if (!message)
+			break;
+
+		write_message(*message);
+		out_urgent |= message->severity >= SeverityFlagBits::Warn;
+		count++;
+	}
+
+	return count;
+}
+
+void logger_thread_main()
+{
+	threading::set_thread_name("Logger Thread");
+	is_logger_thread = true;
+
+	auto last_flush = std::chrono::steady_clock::now();
+	bool pending_flush = false;
+	while (true)
+	{
+		size_t count = 0;
+		bool flushed = false;
+		{
+			std::lock_guard<Mutex> guard(logger_mutex);
+
+			bool urgent = false;
+			count = write_batch(urgent);
+			pending_flush |= count > 0;
+
+			if (const uint64_t dropped = dropped_count.exchange(0))
+			{
+				write_message(Message(std::chrono::system_clock::now(), std::this_thread::get_id(),
+					SeverityFlagBits::Warn, fmt::format("Log queue full, dropped {} messages", dropped)));
+				urgent = true;
+				pending_flush = true;
+			}
+
+			processed_count.fetch_add(count, std::memory_order_release);
+
+			const auto now = std::chrono::steady_clock::now();
+			const bool flush_requested = flushed_count.load() < flush_target.load();
+			if (pending_flush && (urgent || flush_requested || now - last_flush >= async_settings.flush_interval))
+			{
+				flush_sinks();
+				last_flush = now;
+				pending_flush = false;
+			}
+
+			if (!pending_flush)
+				flushed_count.store(processed_count.load(), std::memory_order_release);
+
+			flushed = flush_requested;
+		}
+
+		if (flushed)
+		{
+			std::lock_guard<std::mutex> guard(wake_mutex);
+			flushed_condition_var.notify_all();
+		}
+
+		if (count > 0)
+			continue;
+
+		if (stop_requested)
+			break;
+
+		std::unique_lock<std::mutex> lock(wake_mutex);
+		logger_thread_sleeping.store(true, std::memory_order_release);
+		wake_condition_var.wait_for(lock, idle_wait_time);
+		logger_thread_sleeping.store(false, std::memory_order_release);
+	}
+}
+
 void log(SeverityFlagBits severity, const std::string& str)
 {
-	std::lock_guard<std::mutex> guard(logger_mutex);
+	if (!is_enabled(severity))
+		return;
 
 	Message message(
 		std::chrono::system_clock::now(),
 		std::this_thread::get_id(),
 		severity,
-		std::move(str));
+		str);
 
-	/**
-	 * Call sinks
-	 */
-	for(const auto& sink : sinks)
+	/** Seq-cst pair with stop_async: either we see async_running cleared or it sees us as active */
+	active_producers.fetch_add(1);
+	if (async_running.load())
 	{
-		if(sink->get_severity_flags() & severity)
-			sink->log(message);
+		/** Fatal messages are never dropped, sinks logging from the logger thread can't wait for themselves */
+		const bool block = (async_settings.overflow_policy == OverflowPolicy::Block ||
+			severity == SeverityFlagBits::Fatal) && !is_logger_thread;
+		bool pushed = true;
+		while (!queue->try_push(message))
+		{
+			if (!block)
+			{
+				dropped_count.fetch_add(1, std::memory_order_relaxed);
+				pushed = false;
+				break;
+			}
+
+			wake_logger_thread();
+			std::this_thread::yield();
+		}
+
+		if (pushed)
+		{
+			pushed_count.fetch_add(1, std::memory_order_release);
+			wake_logger_thread();
+		}
+
+		active_producers.fetch_sub(1, std::memory_order_release);
+		if (!pushed)
+			return;
+	}
+	else
+	{
+		active_producers.fetch_sub(1, std::memory_order_release);
+
+		std::lock_guard<Mutex> guard(logger_mutex);
+		write_message(message);
 	}
 
 	if(severity == SeverityFlagBits::Fatal)
 	{
-		message_box("ZinoEngine Fatal Error", message.message.c_str(),
+		flush();
+		message_box("ZinoEngine Fatal Error", str.c_str(),
 			MessageBoxButtonFlagBits::Ok, MessageBoxIcon::Critical);
 		app::exit(-1);
 	}
 }
 
+bool is_enabled(SeverityFlagBits severity)
+{
+	return enabled_severities.load(std::memory_order_relaxed) & static_cast<uint32_t>(severity);
+}
+
+bool start_async(const AsyncSettings& in_settings)
+{
+	std::lock_guard<Mutex> guard(logger_mutex);
+	if (async_running)
+		return false;
+
+	async_settings = in_settings;
+	queue = std::make_unique<MessageQueue<Message>>(async_settings.queue_size);
+	stop_requested = false;
+	logger_thread = std::thread(&logger_thread_main);
+	async_running.store(true, std::memory_order_release);
+	return true;
+}
+
+void stop_async()
+{
+	{
+		std::lock_guard<Mutex> guard(logger_mutex);
+		if (!async_running)
+			return;
+
+		async_running.store(false);
+		stop_requested = true;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(wake_mutex);
+		wake_condition_var.notify_one();
+	}
+	logger_thread.join();
+
+	{
+		std::lock_guard<std::mutex> guard(wake_mutex);
+		flushed_condition_var.notify_all();
+	}
+
+	/**
+	 * Messages pushed while stopping
+	 * Producers that saw async_running before it was cleared may still be pushing, or waiting for room
+	 *	in Block mode, so keep draining until none is left before freeing the queue
+	 */
+	std::lock_guard<Mutex> guard(logger_mutex);
+	bool urgent = false;
+	while (active_producers.load() > 0)
+	{
+		if (write_batch(urgent) == 0)
+			std::this_thread::yield();
+	}
+	while (write_batch(urgent) > 0) {}
+	flush_sinks();
+	queue.reset();
+}
+
+void flush()
+{
+	/** Sinks are flushed after the current batch */
+	if (is_logger_thread)
+		return;
+
+	if (!async_running)
+	{
+		std::lock_guard<Mutex> guard(logger_mutex);
+		flush_sinks();
+		return;
+	}
+
+	const uint64_t target = pushed_count.load(std::memory_order_acquire);
+	uint64_t current_target = flush_target.load();
+	while (current_target < target && !flush_target.compare_exchange_weak(current_target, target)) {}
+
+	std::unique_lock<std::mutex> lock(wake_mutex);
+	wake_condition_var.notify_one();
+	flushed_condition_var.wait(lock, [target]()
+	{
+		return flushed_count.load(std::memory_order_acquire) >= target || !async_running;
+	});
+}
+
 /**
  * Sink manipulation
  */
 void add_sink(std::unique_ptr<Sink>&& sink)
 {
+	std::string name = sink->get_name();
+
 	/**
 	 * Scope so that we can print a verbose message without making a infinite mutex loop
 	 */
 	{
-		std::lock_guard<std::mutex> guard(logger_mutex);
+		std::lock_guard<Mutex> guard(logger_mutex);
+		enabled_severities |= static_cast<uint32_t>(static_cast<std::underlying_type_t<SeverityFlagBits>>(sink->get_severity_flags()));
 		sinks.push_back(std::move(sink));
 	}
 
-	verbose("Added sink {}", sinks.back()->get_name());
+	verbose("Added sink {}", name);
 }
 
-}
\ No newline at end of file
+}
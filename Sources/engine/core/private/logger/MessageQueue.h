@@ -0,0 +1,111 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <optional>
+
+namespace ze::logger
+{
+
+/**
+ * Bounded lock-free multi-producer queue (Vyukov's bounded MPMC queue)
+ * Each cell has a sequence number telling whether it can be written or read for the current lap,
+ *	so producers only contend on the enqueue index
+ */
+template<typename T>
+class MessageQueue
+{
+	struct alignas(64) Cell
+	{
+		std::atomic_size_t sequence;
+		alignas(T) std::byte storage[sizeof(T)];
+	};
+
+public:
+	/** in_capacity is rounded up to a power of two */
+	MessageQueue(const size_t in_capacity) : capacity(std::bit_ceil(std::max<size_t>(in_capacity, 2))),
+		mask(capacity - 1), cells(std::make_unique<Cell[]>(capacity)), enqueue_pos(0), dequeue_pos(0)
+	{
+		for (size_t i = 0; i < capacity; ++i)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~MessageQueue()
+	{
+		while (try_pop()) {}
+	}
+
+	/** \return false if the queue is full, in_value is left untouched */
+	bool try_push(T& in_value)
+	{
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (cell->storage) T(std::move(in_value));
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::optional<T> try_pop()
+	{
+		size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+			if (diff == 0)
+			{
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return std::nullopt;
+			}
+			else
+			{
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		T* value = std::launder(reinterpret_cast<T*>(cell->storage));
+		std::optional<T> result(std::move(*value));
+		value->~T();
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return result;
+	}
+
+	ZE_FORCEINLINE size_t get_capacity() const { return capacity; }
+private:
+	size_t capacity;
+	size_t mask;
+	std::unique_ptr<Cell[]> cells;
+	alignas(64) std::atomic_size_t enqueue_pos;
+	alignas(64) std::atomic_size_t dequeue_pos;
+};
+
+}
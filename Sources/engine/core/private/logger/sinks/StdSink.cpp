@@ -36,4 +36,9 @@ void StdSink::log(const Message& message)
 #endif
 }
 
+void StdSink::flush()
+{
+    std::cout.flush();
+}
+
 }
\ No newline at end of file
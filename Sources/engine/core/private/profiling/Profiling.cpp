@@ -1,6 +1,473 @@
 #include "profiling/Profiling.h"
+#include "threading/Thread.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
 
-namespace ZE::Profiling
+namespace ze::profiling
 {
 
-}
\ No newline at end of file
+/**
+ * Events recorded by a thread during a capture
+ * Only the owning thread appends, the collector reads up to count
+ */
+struct ThreadBuffer
+{
+	std::unique_ptr<Event[]> events;
+	uint32_t capacity;
+	std::thread::id thread_id;
+	std::atomic_uint32_t count;
+	std::atomic_uint64_t dropped;
+
+	ThreadBuffer(const size_t in_capacity) : events(std::make_unique<Event[]>(in_capacity)),
+		capacity(static_cast<uint32_t>(in_capacity)), thread_id(std::this_thread::get_id()), count(0), dropped(0) {}
+};
+
+Settings settings;
+std::atomic_bool capturing = false;
+
+/** Incremented by each capture, thread buffers of a previous capture are replaced */
+std::atomic_uint64_t session = 0;
+
+/** Protects the capture state below */
+std::mutex capture_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+std::vector<int64_t> frames;
+uint32_t frame_count = 0;
+int64_t begin_timestamp = 0;
+std::chrono::steady_clock::time_point begin_time;
+
+/** Keeps the buffer alive if the capture ends while the thread is recording */
+thread_local std::shared_ptr<ThreadBuffer> thread_buffer;
+
+/** Trivial thread locals for the hot path */
+thread_local ThreadBuffer* current_buffer = nullptr;
+thread_local uint64_t current_session = 0;
+
+/** Event of a ring buffer, read by snapshots while the owner may overwrite it */
+struct RingEvent
+{
+	std::atomic<const char*> name;
+	std::atomic_int64_t begin;
+	std::atomic_int64_t end;
+};
+
+/**
+ * Last events of a thread for the recorder
+ * Only the owning thread writes. Snapshots work like a seqlock: reserved is incremented before an event is
+ *	written and head after, events copied while they may have been overwritten are discarded
+ */
+struct RingBuffer
+{
+	std::unique_ptr<RingEvent[]> events;
+
+	/** Power of two */
+	uint64_t capacity;
+	std::thread::id thread_id;
+
+	/** Events whose write started, and events written since the buffer creation */
+	std::atomic_uint64_t reserved;
+	std::atomic_uint64_t head;
+
+	/** Set when the owning thread exits */
+	std::atomic_bool thread_exited;
+
+	/** recorded_frames when thread_exited was first seen, protected by recorder_mutex */
+	uint64_t exit_frame;
+
+	RingBuffer(const size_t in_capacity) : capacity(std::bit_ceil(std::max<uint64_t>(in_capacity, 1))),
+		thread_id(std::this_thread::get_id()), reserved(0), head(0), thread_exited(false),
+		exit_frame(std::numeric_limits<uint64_t>::max())
+	{
+		events = std::make_unique<RingEvent[]>(capacity);
+	}
+};
+
+/** Marks the ring of an exiting thread so new_frame releases it once it is out of the recorded frames */
+struct RingBufferHandle
+{
+	std::shared_ptr<RingBuffer> ring;
+
+	~RingBufferHandle()
+	{
+		if (ring)
+			ring->thread_exited = true;
+	}
+};
+
+RecorderSettings recorder_settings;
+std::atomic_bool recorder_enabled = false;
+
+/** Incremented each time the recorder is enabled or disabled, thread ring buffers are then replaced */
+std::atomic_uint64_t recorder_session = 0;
+
+/** Protects the recorder state below */
+std::mutex recorder_mutex;
+std::vector<std::shared_ptr<RingBuffer>> rings;
+
+/** Ring buffer of frame timestamps, indexed by recorded_frames */
+std::vector<int64_t> recorder_frames;
+uint64_t recorded_frames = 0;
+int64_t recorder_begin_timestamp = 0;
+std::chrono::steady_clock::time_point recorder_begin_time;
+
+thread_local RingBufferHandle thread_ring;
+thread_local RingBuffer* current_ring = nullptr;
+thread_local uint64_t current_recorder_session = 0;
+
+double get_ticks_per_microsecond(const int64_t in_begin_timestamp,
+	const std::chrono::steady_clock::time_point& in_begin_time, const int64_t in_end_timestamp)
+{
+#if ZE_PROFILING_USE_TSC
+	const double elapsed_us = std::chrono::duration<double, std::micro>(
+		std::chrono::steady_clock::now() - in_begin_time).count();
+	if (elapsed_us > 0.0)
+		return static_cast<double>(in_end_timestamp - in_begin_timestamp) / elapsed_us;
+
+	return 1.0;
+#else
+	return 1000.0;
+#endif
+}
+
+namespace detail
+{
+
+void record_ring(const char* in_name, const int64_t in_begin, const int64_t in_end)
+{
+	if (current_recorder_session != recorder_session.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> guard(recorder_mutex);
+		if (!recorder_enabled)
+			return;
+
+		thread_ring.ring = std::make_shared<RingBuffer>(recorder_settings.thread_buffer_size);
+		rings.emplace_back(thread_ring.ring);
+		current_ring = thread_ring.ring.get();
+		current_recorder_session = recorder_session.load(std::memory_order_relaxed);
+	}
+
+	RingBuffer& ring = *current_ring;
+	const uint64_t head = ring.head.load(std::memory_order_relaxed);
+	ring.reserved.store(head + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	RingEvent& event = ring.events[head & (ring.capacity - 1)];
+	event.name.store(in_name, std::memory_order_relaxed);
+	event.begin.store(in_begin, std::memory_order_relaxed);
+	event.end.store(in_end, std::memory_order_relaxed);
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+std::atomic_uint32_t recording_flags = 0;
+
+void record(const char* in_name, const int64_t in_begin, const int64_t in_end)
+{
+	const uint32_t flags = recording_flags.load(std::memory_order_relaxed);
+	if (flags & RecordingRecorder)
+		record_ring(in_name, in_begin, in_end);
+
+#if ZE_FEATURE(PROFILING)
+	if (!(flags & RecordingCapture))
+		return;
+
+	if (current_session != session.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> guard(capture_mutex);
+		if (!capturing)
+			return;
+
+		thread_buffer = std::make_shared<ThreadBuffer>(settings.thread_buffer_size);
+		buffers.emplace_back(thread_buffer);
+		current_buffer = thread_buffer.get();
+		current_session = session.load(std::memory_order_relaxed);
+	}
+
+	ThreadBuffer& buffer = *current_buffer;
+	const uint32_t count = buffer.count.load(std::memory_order_relaxed);
+	if (count >= buffer.capacity)
+	{
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	buffer.events[count] = { in_name, in_begin, in_end };
+	buffer.count.store(count + 1, std::memory_order_release);
+#endif
+}
+
+}
+
+bool begin_capture([[maybe_unused]] const uint32_t in_frame_count, [[maybe_unused]] const Settings& in_settings)
+{
+#if ZE_FEATURE(PROFILING)
+	std::lock_guard<std::mutex> guard(capture_mutex);
+	if (capturing)
+		return false;
+
+	settings = in_settings;
+	buffers.clear();
+	frames.clear();
+	frame_count = in_frame_count;
+	begin_time = std::chrono::steady_clock::now();
+	begin_timestamp = detail::get_timestamp();
+	session.fetch_add(1, std::memory_order_release);
+	capturing.store(true, std::memory_order_release);
+	detail::recording_flags.fetch_or(detail::RecordingCapture, std::memory_order_relaxed);
+	return true;
+#else
+	return false;
+#endif
+}
+
+Capture end_capture()
+{
+	Capture capture;
+
+	std::lock_guard<std::mutex> guard(capture_mutex);
+	if (!capturing)
+		return capture;
+
+	capturing.store(false, std::memory_order_release);
+	detail::recording_flags.fetch_and(~detail::RecordingCapture, std::memory_order_relaxed);
+	capture.begin = begin_timestamp;
+	capture.end = detail::get_timestamp();
+	capture.frames = std::move(frames);
+	capture.ticks_per_microsecond = get_ticks_per_microsecond(begin_timestamp, begin_time, capture.end);
+
+	capture.threads.reserve(buffers.size());
+	for (const auto& buffer : buffers)
+	{
+		ThreadCapture& thread = capture.threads.emplace_back();
+		thread.thread_id = buffer->thread_id;
+		thread.name = threading::get_thread_name(buffer->thread_id);
+		thread.events.assign(buffer->events.get(), buffer->events.get() +
+			buffer->count.load(std::memory_order_acquire));
+		thread.dropped = buffer->dropped.load(std::memory_order_relaxed);
+	}
+
+	buffers.clear();
+	frames.clear();
+	return capture;
+}
+
+bool is_capturing()
+{
+	return capturing.load(std::memory_order_relaxed);
+}
+
+void enable_recorder(const RecorderSettings& in_settings)
+{
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+	recorder_settings = in_settings;
+	rings.clear();
+	recorder_frames.assign(std::max<size_t>(in_settings.frame_count, 1), 0);
+	recorded_frames = 0;
+	recorder_begin_time = std::chrono::steady_clock::now();
+	recorder_begin_timestamp = detail::get_timestamp();
+	recorder_session.fetch_add(1, std::memory_order_release);
+	recorder_enabled.store(true, std::memory_order_release);
+	detail::recording_flags.fetch_or(detail::RecordingRecorder, std::memory_order_relaxed);
+}
+
+void disable_recorder()
+{
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+	recorder_enabled.store(false, std::memory_order_release);
+	detail::recording_flags.fetch_and(~detail::RecordingRecorder, std::memory_order_relaxed);
+	recorder_session.fetch_add(1, std::memory_order_release);
+	rings.clear();
+	recorder_frames.clear();
+	recorded_frames = 0;
+}
+
+bool is_recorder_enabled()
+{
+	return recorder_enabled.load(std::memory_order_relaxed);
+}
+
+Capture snapshot_recorder(const uint32_t in_frame_count)
+{
+	Capture capture;
+
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+	if (!recorder_enabled || recorded_frames == 0)
+		return capture;
+
+	const uint64_t frame_count = std::min<uint64_t>({ in_frame_count, recorded_frames, recorder_frames.size() });
+	for (uint64_t i = recorded_frames - frame_count; i < recorded_frames; ++i)
+		capture.frames.emplace_back(recorder_frames[i % recorder_frames.size()]);
+
+	/** Ends the current frame */
+	capture.end = detail::get_timestamp();
+	capture.frames.emplace_back(capture.end);
+	capture.begin = capture.frames.front();
+	capture.ticks_per_microsecond = get_ticks_per_microsecond(recorder_begin_timestamp, recorder_begin_time,
+		capture.end);
+
+	capture.threads.reserve(rings.size());
+	std::vector<Event> events;
+	for (const auto& ring : rings)
+	{
+		const uint64_t head = ring->head.load(std::memory_order_acquire);
+		const uint64_t first = head > ring->capacity ? head - ring->capacity : 0;
+
+		events.clear();
+		for (uint64_t i = first; i < head; ++i)
+		{
+			const RingEvent& event = ring->events[i & (ring->capacity - 1)];
+			events.push_back({ event.name.load(std::memory_order_relaxed), event.begin.load(std::memory_order_relaxed),
+				event.end.load(std::memory_order_relaxed) });
+		}
+
+		/**
+		 * The owner may have overwritten the oldest events while they were copied
+		 * The fence pairs with the one of record_ring: if a copy saw a new write, reserved includes it
+		 */
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t reserved = ring->reserved.load(std::memory_order_relaxed);
+		const uint64_t first_valid = std::max(first, reserved > ring->capacity ? reserved - ring->capacity : 0);
+
+		ThreadCapture& thread = capture.threads.emplace_back();
+		thread.thread_id = ring->thread_id;
+		thread.name = threading::get_thread_name(ring->thread_id);
+		thread.dropped = 0;
+		for (uint64_t i = std::min(first_valid, head); i < head; ++i)
+		{
+			const Event& event = events[i - first];
+			if (event.end >= capture.begin)
+				thread.events.emplace_back(event);
+		}
+	}
+
+	return capture;
+}
+
+bool new_frame()
+{
+	if (recorder_enabled.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> guard(recorder_mutex);
+		if (!recorder_frames.empty())
+			recorder_frames[recorded_frames++ % recorder_frames.size()] = detail::get_timestamp();
+
+		/** Release the rings of exited threads once their events are older than every recorded frame */
+		std::erase_if(rings, [](const std::shared_ptr<RingBuffer>& in_ring)
+		{
+			if (!in_ring->thread_exited.load(std::memory_order_relaxed))
+				return false;
+
+			if (in_ring->exit_frame == std::numeric_limits<uint64_t>::max())
+				in_ring->exit_frame = recorded_frames;
+
+			return recorded_frames - in_ring->exit_frame > recorder_frames.size();
+		});
+	}
+
+	if (!capturing.load(std::memory_order_relaxed))
+		return false;
+
+	std::lock_guard<std::mutex> guard(capture_mutex);
+	frames.emplace_back(detail::get_timestamp());
+
+	/** The first call ends the frame the capture started in */
+	return frame_count != 0 && frames.size() > frame_count;
+}
+
+void append_json_string(std::string& out_json, const std::string_view& in_string)
+{
+	out_json += '"';
+	for (const char c : in_string)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out_json += '\\';
+			out_json += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			fmt::format_to(std::back_inserter(out_json), "\\u{:04x}", static_cast<int>(c));
+		}
+		else
+		{
+			out_json += c;
+		}
+	}
+	out_json += '"';
+}
+
+void write_chrome_trace(const Capture& in_capture, std::ostream& out_stream)
+{
+	/** Events are written by chunks to bound the memory used by large captures */
+	constexpr size_t chunk_size = 64 * 1024;
+
+	const auto to_us = [&](const int64_t in_timestamp)
+	{
+		return static_cast<double>(in_timestamp - in_capture.begin) / in_capture.ticks_per_microsecond;
+	};
+
+	std::string json;
+	json.reserve(chunk_size + 1024);
+	bool first = true;
+	const auto begin_event = [&]()
+	{
+		if (json.size() >= chunk_size)
+		{
+			out_stream.write(json.data(), static_cast<std::streamsize>(json.size()));
+			json.clear();
+		}
+
+		json += first ? "\n" : ",\n";
+		first = false;
+	};
+
+	json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	/** Frames have their own track */
+	begin_event();
+	json += R"({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"Frames"}})";
+	for (size_t i = 1; i < in_capture.frames.size(); ++i)
+	{
+		begin_event();
+		fmt::format_to(std::back_inserter(json),
+			R"({{"name":"Frame {}","ph":"X","pid":1,"tid":0,"ts":{:.3f},"dur":{:.3f}}})", i,
+			to_us(in_capture.frames[i - 1]), to_us(in_capture.frames[i]) - to_us(in_capture.frames[i - 1]));
+	}
+
+	for (size_t thread_idx = 0; thread_idx < in_capture.threads.size(); ++thread_idx)
+	{
+		const ThreadCapture& thread = in_capture.threads[thread_idx];
+		const size_t tid = thread_idx + 1;
+
+		begin_event();
+		fmt::format_to(std::back_inserter(json), R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)",
+			tid);
+		append_json_string(json, thread.name.empty() ? fmt::format("Thread {}", tid) : thread.name);
+		json += "}}";
+
+		for (const Event& event : thread.events)
+		{
+			begin_event();
+			json += R"({"name":)";
+			append_json_string(json, event.name);
+			fmt::format_to(std::back_inserter(json), R"(,"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+				tid, to_us(event.begin), to_us(event.end) - to_us(event.begin));
+		}
+
+		if (thread.dropped > 0)
+		{
+			begin_event();
+			fmt::format_to(std::back_inserter(json),
+				R"({{"name":"Dropped {} events","ph":"i","s":"t","pid":1,"tid":{},"ts":{:.3f}}})",
+				thread.dropped, tid, to_us(in_capture.end));
+		}
+	}
+
+	json += "\n]}\n";
+	out_stream.write(json.data(), static_cast<std::streamsize>(json.size()));
+}
+
+}
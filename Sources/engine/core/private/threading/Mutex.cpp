@@ -0,0 +1,152 @@
+#include "threading/Mutex.h"
+#include "console/Console.h"
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <robin_hood.h>
+
+namespace ze::detail
+{
+
+struct LockStatsRegistry
+{
+	std::mutex mutex;
+	std::deque<LockStats> stats;
+	robin_hood::unordered_map<std::string_view, LockStats*> map;
+};
+
+/** Locks can be constructed during static initialization */
+LockStatsRegistry& get_registry()
+{
+	static LockStatsRegistry registry;
+	return registry;
+}
+
+void LockStats::record_contention(const std::chrono::steady_clock::duration& in_wait_time)
+{
+	const uint64_t wait_ns = static_cast<uint64_t>(std::max<int64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(in_wait_time).count(), 0));
+	const size_t bucket = std::min<size_t>(std::bit_width(wait_ns / 1000), wait_bucket_count - 1);
+
+	Shard& shard = shards[get_thread_shard()];
+	shard.contentions.fetch_add(1, std::memory_order_relaxed);
+	shard.total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+	shard.wait_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t max_wait = shard.max_wait_ns.load(std::memory_order_relaxed);
+	while (wait_ns > max_wait &&
+		!shard.max_wait_ns.compare_exchange_weak(max_wait, wait_ns, std::memory_order_relaxed)) {}
+}
+
+/** Sum of the shards of a LockStats */
+struct LockStatsTotals
+{
+	const char* name;
+	uint64_t acquisitions;
+	uint64_t contentions;
+	uint64_t total_wait_ns;
+	uint64_t max_wait_ns;
+	std::array<uint64_t, LockStats::wait_bucket_count> wait_histogram;
+
+	LockStatsTotals(const LockStats& in_stats) : name(in_stats.name), acquisitions(0), contentions(0),
+		total_wait_ns(0), max_wait_ns(0), wait_histogram()
+	{
+		for (const LockStats::Shard& shard : in_stats.shards)
+		{
+			acquisitions += shard.acquisitions.load(std::memory_order_relaxed);
+			contentions += shard.contentions.load(std::memory_order_relaxed);
+			total_wait_ns += shard.total_wait_ns.load(std::memory_order_relaxed);
+			max_wait_ns = std::max(max_wait_ns, shard.max_wait_ns.load(std::memory_order_relaxed));
+			for (size_t i = 0; i < LockStats::wait_bucket_count; ++i)
+				wait_histogram[i] += shard.wait_histogram[i].load(std::memory_order_relaxed);
+		}
+	}
+};
+
+LockStats& get_lock_stats(const char* in_name)
+{
+	LockStatsRegistry& registry = get_registry();
+	std::lock_guard<std::mutex> guard(registry.mutex);
+
+	auto it = registry.map.find(std::string_view(in_name));
+	if (it != registry.map.end())
+		return *it->second;
+
+	LockStats& stats = registry.stats.emplace_back(in_name);
+	registry.map.insert({ std::string_view(in_name), &stats });
+	return stats;
+}
+
+static ConCmdRef cmd_lock_stats("lock_stats", "Print the contention of named locks, sorted by total wait time. lock_stats reset to clear them",
+	[]([[maybe_unused]] const std::vector<std::string_view>& in_params)
+	{
+#if ZE_FEATURE(LOCK_STATS)
+		LockStatsRegistry& registry = get_registry();
+
+		if (!in_params.empty() && in_params[0] == "reset")
+		{
+			std::lock_guard<std::mutex> guard(registry.mutex);
+			for (LockStats& stats : registry.stats)
+			{
+				for (LockStats::Shard& shard : stats.shards)
+				{
+					shard.acquisitions.store(0, std::memory_order_relaxed);
+					shard.contentions.store(0, std::memory_order_relaxed);
+					shard.total_wait_ns.store(0, std::memory_order_relaxed);
+					shard.max_wait_ns.store(0, std::memory_order_relaxed);
+					for (auto& bucket : shard.wait_histogram)
+						bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+			return;
+		}
+
+		std::vector<LockStatsTotals> sorted_stats;
+		{
+			std::lock_guard<std::mutex> guard(registry.mutex);
+			for (const LockStats& stats : registry.stats)
+				sorted_stats.emplace_back(stats);
+		}
+
+		std::sort(sorted_stats.begin(), sorted_stats.end(), [](const LockStatsTotals& in_left,
+			const LockStatsTotals& in_right)
+		{
+			return in_left.total_wait_ns > in_right.total_wait_ns;
+		});
+
+		std::string text = "Lock stats";
+		for (const LockStatsTotals& stats : sorted_stats)
+		{
+			text += fmt::format("\n\t- {}: {} acquisitions, {} contended ({:.2f}%), wait total {:.3f} ms, avg {:.2f} us, max {:.2f} us",
+				stats.name, stats.acquisitions, stats.contentions,
+				stats.acquisitions != 0 ? 100.0 * stats.contentions / stats.acquisitions : 0.0,
+				stats.total_wait_ns / 1e6,
+				stats.contentions != 0 ? stats.total_wait_ns / 1e3 / stats.contentions : 0.0,
+				stats.max_wait_ns / 1e3);
+
+			if (stats.contentions == 0)
+				continue;
+
+			text += "\n\t\twait histogram:";
+			for (size_t i = 0; i < LockStats::wait_bucket_count; ++i)
+			{
+				const uint64_t count = stats.wait_histogram[i];
+				if (count == 0)
+					continue;
+
+				if (i == 0)
+					text += fmt::format(" <1us: {}", count);
+				else if (i == LockStats::wait_bucket_count - 1)
+					text += fmt::format(" >={}us: {}", 1ull << (i - 1), count);
+				else
+					text += fmt::format(" {}-{}us: {}", 1ull << (i - 1), 1ull << i, count);
+			}
+		}
+
+		ze::logger::info("{}", text);
+#else
+		ze::logger::info("Lock stats are compiled out of this build (ZE_FEATURE(LOCK_STATS))");
+#endif
+	});
+
+}
@@ -1,15 +1,32 @@
 #include "threading/jobsystem/Job.h"
 #include "threading/jobsystem/WorkerThread.h"
 #include "threading/jobsystem/JobSystem.h"
+#include <mutex>
+#include <deque>
+#include "profiling/Profiling.h"
 
 namespace ze::jobsystem
 {
 
+/** Jobs scheduled from threads that aren't workers, worker deques can only be pushed by their owner */
+std::mutex external_jobs_mutex;
+std::deque<const Job*> external_jobs;
+std::atomic_size_t external_job_count = 0;
+
 void schedule(const Job& job)
 {
 	if(job.type != JobType::Lightweight)
 	{
-		get_worker().get_job_queue().push(&job);	
+		if(is_worker_thread())
+		{
+			get_worker().get_job_queue().push(&job);
+		}
+		else
+		{
+			std::scoped_lock lock(external_jobs_mutex);
+			external_jobs.emplace_back(&job);
+			external_job_count++;
+		}
 
 		/** Wake one random worker */
 		WorkerThread::get_sleep_condition_var().notify_one();
@@ -37,6 +54,7 @@ void wait(const Job& job)
 
 void detail::execute(const Job& job)
 {
+	ZE_PROFILE_SCOPE("Job");
 	job.function(job);
 	finish(job);
 }
@@ -62,7 +80,7 @@ void detail::finish(const Job& job)
 				switch(dependent->type)
 				{
 				default:
-					get_worker().get_job_queue().push(dependent);
+					schedule(*dependent);
 					break;
 				case JobType::Lightweight:
 					execute(*dependent);
@@ -73,4 +91,19 @@ void detail::finish(const Job& job)
 	}
 }
 
+const Job* detail::pop_external_job()
+{
+	if(external_job_count == 0)
+		return nullptr;
+
+	std::scoped_lock lock(external_jobs_mutex);
+	if(external_jobs.empty())
+		return nullptr;
+
+	const Job* job = external_jobs.front();
+	external_jobs.pop_front();
+	external_job_count--;
+	return job;
+}
+
 }
\ No newline at end of file
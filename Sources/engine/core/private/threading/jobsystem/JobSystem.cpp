@@ -20,6 +20,9 @@ thread_local std::size_t allocated_jobs = 0;
 /** This worker id */
 thread_local size_t worker_idx = 0;
 
+/** False for threads that aren't managed by the job system */
+thread_local bool is_worker = false;
+
 void init_thread_local_idx()
 {
 	size_t idx = 0;
@@ -28,6 +31,7 @@ void init_thread_local_idx()
 		if (worker.get_thread_id() == std::this_thread::get_id())
 		{
 			worker_idx = idx;
+			is_worker = true;
 			break;
 		}
 
@@ -45,9 +49,9 @@ void initialize()
 		num_cores, worker_thread_count - 1);
 
 	/** Add main thread */
-	init_thread_local_idx();
 	new (workers.data()) WorkerThread(WorkerThreadType::Partial, 
 		std::this_thread::get_id());
+	init_thread_local_idx();
 	
 	/** Workers */
 	for(size_t i = 1; i < worker_thread_count; ++i)
@@ -132,4 +136,9 @@ size_t get_worker_count()
 	return worker_count; 
 }
 
+bool is_worker_thread()
+{
+	return is_worker;
+}
+
 }
\ No newline at end of file
@@ -58,6 +58,9 @@ void WorkerThread::flush()
 	else
 	{
 		const Job* job = try_get_or_steal_job();
+		if(!job)
+			job = detail::pop_external_job();
+
 		if(job)
 		{
 			detail::execute(*job);
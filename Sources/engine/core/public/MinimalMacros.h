@@ -37,6 +37,18 @@ namespace ze
 /** Enable Backend handle validation */
 #define ZE_FEATURE_PRIVATE_DEFINITION_BACKEND_HANDLE_VALIDATION() ZE_FEATURE_PRIVATE_DEFINITION_DEVELOPMENT()
 
+/** Enable CPU profiling zones (ZE_PROFILE_SCOPE) */
+#define ZE_FEATURE_PRIVATE_DEFINITION_PROFILING() ZE_FEATURE_PRIVATE_DEFINITION_DEVELOPMENT()
+
+/**
+ * Hitch recorder (engine/HitchRecorder.h), kept in release builds
+ * Profiling zones are compiled in for it, they only feed its ring buffers when PROFILING is disabled
+ */
+#define ZE_FEATURE_PRIVATE_DEFINITION_HITCH_RECORDER() 1
+
+/** Record the contention of ze::Mutex/ze::SharedMutex */
+#define ZE_FEATURE_PRIVATE_DEFINITION_LOCK_STATS() ZE_FEATURE_PRIVATE_DEFINITION_DEVELOPMENT()
+
 /** Return 1 if feature is enabled */
 #define ZE_FEATURE(X) ZE_FEATURE_PRIVATE_DEFINITION_##X()
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <span>
+#include <vector>
+
+/**
+ * Block compression of byte streams (LZ4)
+ * The data is split in fixed-size blocks that are compressed independently so they can be decoded in parallel
+ * or randomly accessed using the seek table
+ *
+ * Layout: [BlockStreamHeader][BlockEntry * block_count][blocks...]
+ */
+namespace ze::compression
+{
+
+static constexpr uint32_t default_block_size = 256 * 1024;
+
+struct BlockStreamHeader
+{
+	static constexpr uint32_t magic_value = 0x4342455A; /** "ZEBC" */
+	static constexpr uint32_t current_version = 1;
+
+	uint32_t magic;
+	uint32_t version;
+	uint32_t block_size;
+	uint32_t block_count;
+	uint64_t uncompressed_size;
+};
+static_assert(sizeof(BlockStreamHeader) == 24);
+
+/**
+ * Seek table entry
+ */
+struct BlockEntry
+{
+	/** Offset of the block from the start of the stream */
+	uint64_t offset;
+	uint32_t compressed_size;
+
+	/** 1 if the block didn't compress and is stored as-is */
+	uint32_t stored;
+};
+static_assert(sizeof(BlockEntry) == 16);
+
+struct BlockCompressionStats
+{
+	uint64_t uncompressed_size;
+	uint64_t compressed_size;
+	uint32_t block_count;
+
+	/** Time spent compressing/decompressing, in seconds */
+	double time;
+
+	BlockCompressionStats() : uncompressed_size(0), compressed_size(0), block_count(0), time(0.0) {}
+
+	ZE_FORCEINLINE double get_ratio() const
+	{
+		return compressed_size != 0 ? static_cast<double>(uncompressed_size) / compressed_size : 0.0;
+	}
+
+	/** Uncompressed MiB processed per second */
+	ZE_FORCEINLINE double get_throughput() const
+	{
+		return time > 0.0 ? (uncompressed_size / (1024.0 * 1024.0)) / time : 0.0;
+	}
+};
+
+/** True if the data starts with a block stream header */
+CORE_API bool is_block_compressed(std::span<const uint8_t> in_data);
+
+/**
+ * Compress data into a block stream
+ * Blocks are compressed in parallel on the job system
+ */
+CORE_API std::vector<uint8_t> compress_blocks(std::span<const uint8_t> in_data,
+	const uint32_t in_block_size = default_block_size,
+	BlockCompressionStats* out_stats = nullptr);
+
+/**
+ * Decompress a whole block stream
+ * Blocks are decompressed in parallel on the job system
+ * \return false if the stream is invalid
+ */
+CORE_API bool decompress_blocks(std::span<const uint8_t> in_data, std::vector<uint8_t>& out_data,
+	BlockCompressionStats* out_stats = nullptr);
+
+/**
+ * Decompress a single block of a block stream, out_block must be at least block_size bytes
+ * \return Decompressed size of the block, 0 on error
+ */
+CORE_API size_t decompress_block(std::span<const uint8_t> in_data, const uint32_t in_block_idx,
+	std::span<uint8_t> out_block);
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include "delegates/Delegate.h"
+
+namespace ze
+{
+
+/**
+ * A console command
+ */
+struct ConCmd
+{
+	using Function = DelegateNoRet<const std::vector<std::string_view>&>;
+
+	std::string name;
+	std::string help;
+	Function function;
+
+	ConCmd(const std::string& in_name,
+		const std::string& in_help,
+		Function&& in_function) : name(in_name), help(in_help), function(std::move(in_function)) {}
+};
+
+}
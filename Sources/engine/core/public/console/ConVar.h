@@ -5,6 +5,9 @@
 #include <string>
 #include "delegates/Delegate.h"
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
 
 namespace ze
 {
@@ -23,6 +26,8 @@ ENABLE_FLAG_ENUMS(ConVarFlagBits, ConVarFlags);
 
 /**
  * A console variable
+ * Values are written by one thread at a time (console, config files) and published to atomics,
+ *	so readers on any thread never take the console lock
  */
 struct ConVar
 {
@@ -37,6 +42,8 @@ struct ConVar
 
 	std::string name;
 	ConvarDataType default_value;
+
+	/** Writer side value, use the get_as_* functions to read the convar */
 	ConvarDataType data;
 
 	/** Only for numbers */
@@ -53,14 +60,19 @@ struct ConVar
 	DelegateNoRet<const ConvarDataType&> on_max_changed;
 	DelegateNoRet<const ConvarDataType&> on_value_changed;
 
+	/** Published values, strings are immutable and freed once the last reader released them */
+	std::atomic<float> float_value;
+	std::atomic<int32_t> int_value;
+	std::atomic<std::shared_ptr<const std::string>> string_value;
+
 	ConVar(const std::string& in_name, 
 		const float& in_default_value,
 		const std::string& in_help,
 		const ConVarFlags& in_flags = ConVarFlagBits::None) : name(in_name), data(std::in_place_index<0>,
 			in_default_value),
-			minimum(std::in_place_index<0>, std::numeric_limits<float>::min()),
+			minimum(std::in_place_index<0>, std::numeric_limits<float>::lowest()),
 			maximum(std::in_place_index<0>, std::numeric_limits<float>::max()), help(in_help), 
-		flags(in_flags) {}
+		flags(in_flags), float_value(0.f), int_value(0), string_value(nullptr) { publish(); }
 
 	ConVar(const std::string& in_name, 
 		const int32_t& in_default_value,
@@ -68,13 +80,16 @@ struct ConVar
 		const ConVarFlags& in_flags = ConVarFlagBits::None) : name(in_name), data(std::in_place_index<1>, in_default_value),
 			minimum(std::in_place_index<1>, std::numeric_limits<int32_t>::min()),
 			maximum(std::in_place_index<1>, std::numeric_limits<int32_t>::max()), help(in_help), 
-		flags(in_flags) {}
+		flags(in_flags), float_value(0.f), int_value(0), string_value(nullptr) { publish(); }
 
 	ConVar(const std::string& in_name, 
 		const std::string& in_default_value,
 		const std::string& in_help,
 		const ConVarFlags& in_flags = ConVarFlagBits::None) : name(in_name), data(std::in_place_index<2>,
-			in_default_value), help(in_help), flags(in_flags) {}
+			in_default_value), help(in_help), flags(in_flags), float_value(0.f), int_value(0),
+			string_value(nullptr) { publish(); }
+
+	ZE_FORCEINLINE DataTypeIndex get_type() const { return static_cast<DataTypeIndex>(data.index()); }
 
 	void set_min(const ConvarDataType& in_data)
 	{
@@ -91,60 +106,91 @@ struct ConVar
 	void set_float(const float& in_float)
 	{
 		data = std::clamp<float>(in_float, std::get<float>(minimum), std::get<float>(maximum));
+		publish();
 		on_value_changed.execute(data);
 	}
 
 	void set_int(const int32_t& in_int)
 	{
 		data = std::clamp<int32_t>(in_int, std::get<int32_t>(minimum), std::get<int32_t>(maximum));
+		publish();
 		on_value_changed.execute(data);
 	}
 
 	void set_string(const std::string& in_str)
 	{
 		data = in_str;
+		publish();
 		on_value_changed.execute(data);
 	}
 
+	/** The type of a convar can't be changed */
 	void set_data(const ConvarDataType& in_data)
 	{
+		if (in_data.index() != data.index())
+			return;
+
 		data = in_data;
+		publish();
 		on_value_changed.execute(data);
 	}
 
-	const float& get_min_as_float()
+	const float& get_min_as_float() const
 	{
 		return std::get<float>(minimum);
 	}
 
-	const float& get_max_as_float()
+	const float& get_max_as_float() const
 	{
 		return std::get<float>(maximum);
 	}
 
-	const int32_t& get_min_as_int()
+	const int32_t& get_min_as_int() const
 	{
 		return std::get<int32_t>(minimum);
 	}
 
-	const int32_t& get_max_as_int()
+	const int32_t& get_max_as_int() const
 	{
 		return std::get<int32_t>(maximum);
 	}
 
-	const float& get_as_float()
+	ZE_FORCEINLINE float get_as_float() const
 	{
-		return std::get<float>(data);
+		return float_value.load(std::memory_order_relaxed);
 	}
 
-	const int32_t& get_as_int()
+	ZE_FORCEINLINE int32_t get_as_int() const
 	{
-		return std::get<int32_t>(data);
+		return int_value.load(std::memory_order_relaxed);
 	}
 
-	const std::string& get_as_string()
+	/** The snapshot stays valid while it is held, even if the convar is changed meanwhile */
+	ZE_FORCEINLINE std::shared_ptr<const std::string> get_string_snapshot() const
+	{
+		return string_value.load(std::memory_order_acquire);
+	}
+
+	ZE_FORCEINLINE std::string get_as_string() const
+	{
+		return *get_string_snapshot();
+	}
+private:
+	void publish()
 	{
-		return std::get<std::string>(data);
+		switch (data.index())
+		{
+		case DataTypeFloat:
+			float_value.store(std::get<float>(data), std::memory_order_relaxed);
+			break;
+		case DataTypeInt32:
+			int_value.store(std::get<int32_t>(data), std::memory_order_relaxed);
+			break;
+		case DataTypeString:
+			string_value.store(std::make_shared<const std::string>(std::get<std::string>(data)),
+				std::memory_order_release);
+			break;
+		}
 	}
 };
 
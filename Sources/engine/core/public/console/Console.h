@@ -1,7 +1,11 @@
 #pragma once
 
 #include "ConVar.h"
+#include "ConCmd.h"
 #include "NonCopyable.h"
+#include <deque>
+#include <mutex>
+#include <robin_hood.h>
 
 namespace ze
 {
@@ -16,22 +20,79 @@ public:
 	~CConsole();
 	static CConsole& Get();
 	
+	/**
+	 * Register a convar
+	 * \return Its index, the index of the existing convar if the name is already registered
+	 */
 	template<typename... Args>
 	size_t EmplaceConVar(Args&&... InArgs)
 	{
-		ConVars.emplace_back(std::forward<Args>(InArgs)...);
-		ConVars.back().default_value = ConVars.back().data;
-		return ConVars.size() - 1;
+		std::lock_guard<std::mutex> guard(registry_mutex);
+		ConVar& convar = ConVars.emplace_back(std::forward<Args>(InArgs)...);
+		convar.default_value = convar.data;
+
+		auto [it, inserted] = ConVarMap.try_emplace(std::string_view(convar.name), ConVars.size() - 1);
+		if (!inserted)
+		{
+			ConVars.pop_back();
+			ze::logger::warn("ConVar \"{}\" is already registered", it->first);
+		}
+
+		return it->second;
 	}
 
+	/**
+	 * Register a command
+	 * \return false if a command with this name is already registered
+	 */
+	bool register_command(const std::string& in_name, const std::string& in_help, ConCmd::Function&& in_function);
+
+	/** Execute a command, or set/print a convar */
 	void Execute(const std::string_view& InCmdName, const std::vector<std::string_view>& InParams);
 
-	ConVar& GetConVar(const size_t& InIdx) { return ConVars[InIdx]; }
+	/** \return nullptr if there is no convar with this name */
+	ConVar* find_convar(const std::string_view& in_name);
+
+	/**
+	 * Apply a config, one "name value" per line, lines starting with # or // are comments
+	 * String values can be quoted
+	 * \return The number of convars changed
+	 */
+	size_t apply_config(const std::string_view& in_config);
+
+	ConVar& GetConVar(const size_t& InIdx)
+	{
+		std::lock_guard<std::mutex> guard(registry_mutex);
+		return ConVars[InIdx];
+	}
+
 	auto& get_convars() { return ConVars; }
 private:
-	/** Coherent array of convars */
-	std::vector<ConVar> ConVars;
+	/** Convars are never moved, references given to ConVarRef stay valid */
+	std::deque<ConVar> ConVars;
+
+	/** Keys are views of ConVar::name */
+	robin_hood::unordered_map<std::string_view, size_t> ConVarMap;
+
+	/** Same as convars */
+	std::deque<ConCmd> ConCmds;
+	robin_hood::unordered_map<std::string_view, size_t> ConCmdMap;
+	std::mutex registry_mutex;
+};
+/**
+ * Helper type to register a command from a static variable
+ */
+class ConCmdRef
+{
+public:
+	ConCmdRef(const std::string& in_name,
+		const std::string& in_help,
+		ConCmd::Function&& in_function)
+	{
+		CConsole::Get().register_command(in_name, in_help, std::move(in_function));
+	}
 };
+
 /**
  * Type trait that return true if the type can be used as a number for convars
  */
@@ -49,7 +110,8 @@ public:
 		const T& in_default_value,
 		const std::string& in_help,
 		const ConVarFlags& in_flags = ConVarFlagBits::None) :
-		idx(CConsole::Get().EmplaceConVar(in_name, in_default_value, in_help, in_flags)) {}
+		convar(&CConsole::Get().GetConVar(
+			CConsole::Get().EmplaceConVar(in_name, in_default_value, in_help, in_flags))) {}
 	
 	/**
 	 * Constructor with min/max, only works for valid convars numbers
@@ -60,15 +122,16 @@ public:
 		const T& in_min,
 		const T& in_max,
 		const ConVarFlags& in_flags = ConVarFlagBits::None) requires IsValidConVarNumber<T> :
-		idx(CConsole::Get().EmplaceConVar(in_name, in_default_value, in_help, in_flags)) 
+		convar(&CConsole::Get().GetConVar(
+			CConsole::Get().EmplaceConVar(in_name, in_default_value, in_help, in_flags)))
 	{
 		get_convar().set_min(in_min);
 		get_convar().set_max(in_max);
 	}
 
-	ZE_FORCEINLINE ConVar& get_convar()
+	ZE_FORCEINLINE ConVar& get_convar() const
 	{
-		return CConsole::Get().GetConVar(idx);
+		return *convar;
 	}
 
 	/**
@@ -96,47 +159,51 @@ public:
 			});
 	}
 
-	ZE_FORCEINLINE const T& get()
+	/**
+	 * Can be called from any thread, numbers are lock-free
+	 * Strings are a copy of the last published value
+	 */
+	ZE_FORCEINLINE T get() const
 	{
 		if constexpr(std::is_same_v<T, float>)
 			return get_as_float();
 		else if constexpr(std::is_same_v<T, int32_t>)
 			return get_as_int();
 		else
-			return get_as_string();
+			return convar->get_as_string();
 	}
 
-	ZE_FORCEINLINE const T& get_min()
+	ZE_FORCEINLINE const T& get_min() const
 	{
-		return std::get<T>(get_convar().minimum);
+		return std::get<T>(convar->minimum);
 	}
 
-	ZE_FORCEINLINE const T& get_max()
+	ZE_FORCEINLINE const T& get_max() const
 	{
-		return std::get<T>(get_convar().maximum);
+		return std::get<T>(convar->maximum);
 	}
 
-	ZE_FORCEINLINE const float& get_as_float()
+	ZE_FORCEINLINE float get_as_float() const
 	{
-		return get_convar().get_as_float();
+		return convar->get_as_float();
 	}
 
-	ZE_FORCEINLINE const int32_t& get_as_int()
+	ZE_FORCEINLINE int32_t get_as_int() const
 	{
-		return get_convar().get_as_int();
+		return convar->get_as_int();
 	}
 
-	ZE_FORCEINLINE const std::string& get_as_string()
+	std::string get_as_string() const
 	{
 		if constexpr(std::is_same_v<T, float>)
 			return std::to_string(get_as_float());
 		else if constexpr(std::is_same_v<T, int32_t>)
 			return std::to_string(get_as_int());
 		else
-			return get_convar().get_as_string();
+			return convar->get_as_string();
 	}
 private:
-	size_t idx;
+	ConVar* convar;
 };
 
 }
\ No newline at end of file
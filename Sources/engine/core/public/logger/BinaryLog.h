@@ -0,0 +1,283 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "Severity.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define ZE_BINARY_LOG_USE_TSC 1
+#endif
+
+/**
+ * Binary structured log
+ * Call sites register their format string once, records only store the format id, a timestamp and the raw
+ *	arguments in a per-thread buffer, formatting is done offline by the decoder (see tools/zelog)
+ * Records are written to the file by a background thread, each batch sorted by timestamp
+ * Timestamps are raw TSC ticks on x86-64 (steady clock nanoseconds otherwise), Clock entries map them to
+ *	the system time
+ *
+ * File layout: [FileHeader][entries...], each entry starts with its EntryType:
+ *	- Format: u32 id, u8 severity, u32 line, u8 arg count, ArgType * arg count, u32 size + format, u32 size + file
+ *	- Thread: u32 index, u32 size + name
+ *	- Record: u32 format id, u32 thread index, i64 timestamp, u32 size + arguments
+ *	- Dropped: u32 thread index, u64 count
+ *	- Clock: i64 timestamp, i64 system time, written before the records of each batch
+ */
+namespace ze::logger::binary
+{
+
+struct FileHeader
+{
+	static constexpr uint64_t magic_value = 0x3130474F4C42455A; /** "ZEBLOG01" */
+	static constexpr uint32_t current_version = 1;
+
+	uint64_t magic;
+	uint32_t version;
+	uint32_t padding;
+
+	/** Clocks when the log was opened, system time is in nanoseconds */
+	int64_t system_time;
+	int64_t timestamp;
+};
+static_assert(sizeof(FileHeader) == 32);
+
+enum class EntryType : uint8_t
+{
+	Format = 1,
+	Thread = 2,
+	Record = 3,
+	Dropped = 4,
+	Clock = 5,
+};
+
+enum class ArgType : uint8_t
+{
+	Bool,
+	Char,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+
+	/** u32 size + characters */
+	String,
+
+	/** Stored as u64 */
+	Pointer,
+};
+
+struct Settings
+{
+	/** Size of each thread buffer, records are dropped when it is full */
+	size_t thread_buffer_size;
+
+	/** Interval at which the writer thread collects records */
+	std::chrono::milliseconds write_interval;
+	SeverityFlags severity_flags;
+
+	Settings() : thread_buffer_size(256 * 1024), write_interval(20), severity_flags(SeverityFlagBits::All) {}
+};
+
+/**
+ * Start writing the binary log to in_stream
+ * \return false if a binary log is already open
+ */
+CORE_API bool open(std::unique_ptr<std::streambuf>&& in_stream, const Settings& in_settings = {});
+
+/**
+ * Accept records now but only create the stream and start the writer thread when the first call site
+ *	is reached, so runs without ZE_LOG_BINARY call sites don't pay for the file and the thread
+ * \param in_stream_factory Called once, from the thread reaching the first call site
+ * \return false if a binary log is already open
+ */
+CORE_API bool open_on_first_use(std::function<std::unique_ptr<std::streambuf>()>&& in_stream_factory,
+	const Settings& in_settings = {});
+
+/** Write pending records and close the stream */
+CORE_API void close();
+
+/** True if the log is open and accepts this severity */
+CORE_API bool is_enabled(SeverityFlagBits severity);
+
+/**
+ * Register a call site
+ * \return Its format id, never 0
+ */
+CORE_API uint32_t register_format(SeverityFlagBits severity, std::string_view format,
+	std::string_view file, uint32_t line, std::span<const ArgType> arg_types);
+
+/**
+ * Decode a binary log to text, one line per record
+ * Records whose format string doesn't match their arguments are written unformatted
+ * \return false if the log is invalid or truncated, lines decoded before the error are kept
+ */
+CORE_API bool decode(std::istream& in_stream, std::ostream& out_stream);
+
+namespace detail
+{
+
+ZE_FORCEINLINE int64_t get_timestamp()
+{
+#if ZE_BINARY_LOG_USE_TSC
+	return static_cast<int64_t>(__rdtsc());
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct RecordHeader
+{
+	uint32_t format_id;
+	uint32_t size;
+	int64_t timestamp;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+/**
+ * Reserve in_size bytes in the calling thread buffer
+ * \return nullptr if the buffer is full, the record is dropped
+ */
+CORE_API uint8_t* begin_record(const uint32_t in_size);
+CORE_API void end_record(const uint32_t in_size);
+
+template<typename> inline constexpr bool always_false = false;
+
+template<typename T>
+constexpr ArgType get_arg_type()
+{
+	using Type = std::remove_cvref_t<T>;
+	if constexpr (std::is_same_v<Type, bool>)
+		return ArgType::Bool;
+	else if constexpr (std::is_same_v<Type, char>)
+		return ArgType::Char;
+	else if constexpr (std::is_enum_v<Type>)
+		return get_arg_type<std::underlying_type_t<Type>>();
+	else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+		return sizeof(Type) == 1 ? ArgType::Int8 : sizeof(Type) == 2 ? ArgType::Int16 :
+			sizeof(Type) == 4 ? ArgType::Int32 : ArgType::Int64;
+	else if constexpr (std::is_integral_v<Type>)
+		return sizeof(Type) == 1 ? ArgType::UInt8 : sizeof(Type) == 2 ? ArgType::UInt16 :
+			sizeof(Type) == 4 ? ArgType::UInt32 : ArgType::UInt64;
+	else if constexpr (std::is_same_v<Type, float>)
+		return ArgType::Float;
+	else if constexpr (std::is_same_v<Type, double>)
+		return ArgType::Double;
+	else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+		return ArgType::String;
+	else if constexpr (std::is_pointer_v<Type>)
+		return ArgType::Pointer;
+	else
+		static_assert(always_false<T>, "Type not supported by the binary log");
+}
+
+template<typename T>
+ZE_FORCEINLINE uint32_t get_encoded_size(const T& in_arg)
+{
+	constexpr ArgType type = get_arg_type<T>();
+	if constexpr (type == ArgType::String)
+		return static_cast<uint32_t>(sizeof(uint32_t) + std::string_view(in_arg).size());
+	else if constexpr (type == ArgType::Pointer)
+		return sizeof(uint64_t);
+	else
+		return sizeof(T);
+}
+
+template<typename T>
+ZE_FORCEINLINE void encode(uint8_t*& out_data, const T& in_arg)
+{
+	constexpr ArgType type = get_arg_type<T>();
+	if constexpr (type == ArgType::String)
+	{
+		const std::string_view string(in_arg);
+		const uint32_t size = static_cast<uint32_t>(string.size());
+		memcpy(out_data, &size, sizeof(size));
+		memcpy(out_data + sizeof(size), string.data(), size);
+		out_data += sizeof(size) + size;
+	}
+	else if constexpr (type == ArgType::Pointer)
+	{
+		const uint64_t address = reinterpret_cast<uintptr_t>(in_arg);
+		memcpy(out_data, &address, sizeof(address));
+		out_data += sizeof(address);
+	}
+	else
+	{
+		memcpy(out_data, &in_arg, sizeof(T));
+		out_data += sizeof(T);
+	}
+}
+
+template<typename... Args>
+ZE_FORCEINLINE void write_record(const uint32_t in_format_id, const Args&... in_args)
+{
+	const uint32_t size = static_cast<uint32_t>(sizeof(RecordHeader)) + (0 + ... + get_encoded_size(in_args));
+	uint8_t* data = begin_record(size);
+	if (!data)
+		return;
+
+	RecordHeader header;
+	header.format_id = in_format_id;
+	header.size = size;
+	header.timestamp = get_timestamp();
+	memcpy(data, &header, sizeof(header));
+	data += sizeof(header);
+
+	(encode(data, in_args), ...);
+	end_record(size);
+}
+
+template<typename... Args>
+ZE_FORCEINLINE void log_at(std::atomic_uint32_t& in_format_id, SeverityFlagBits in_severity,
+	std::string_view in_format, std::string_view in_file, uint32_t in_line, const Args&... in_args)
+{
+	uint32_t format_id = in_format_id.load(std::memory_order_relaxed);
+	if (format_id == 0)
+	{
+		static constexpr ArgType arg_types[] = { get_arg_type<Args>()..., ArgType::Bool };
+		format_id = register_format(in_severity, in_format, in_file, in_line,
+			std::span<const ArgType>(arg_types, sizeof...(Args)));
+		in_format_id.store(format_id, std::memory_order_relaxed);
+	}
+
+	write_record(format_id, in_args...);
+}
+
+}
+
+}
+
+/**
+ * Log to the binary log, arguments must be arithmetic types, enums, strings or pointers
+ * The format string is registered the first time the call site is reached
+ */
+#define ZE_LOG_BINARY(severity, format, ...) \
+	do \
+	{ \
+		if (ze::logger::binary::is_enabled(severity)) \
+		{ \
+			static std::atomic_uint32_t ze_binary_log_format_id = 0; \
+			ze::logger::binary::detail::log_at(ze_binary_log_format_id, severity, format, __FILE__, __LINE__ \
+				__VA_OPT__(,) __VA_ARGS__); \
+		} \
+	} while (0)
@@ -35,8 +35,34 @@ struct Message
 		thread_id(in_id), severity(in_severity), message(in_message) {}
 };
 
+/**
+ * What to do when a message is logged while the async queue is full
+ */
+enum class OverflowPolicy
+{
+	/** Wait for the logger thread to make room */
+	Block,
+
+	/** Drop the message, the number of dropped messages is reported later */
+	Drop,
+};
+
+struct AsyncSettings
+{
+	/** Max messages waiting for the logger thread, rounded up to a power of two */
+	size_t queue_size;
+	OverflowPolicy overflow_policy;
+
+	/** Sinks are flushed at this interval, and after each batch containing a warning or worse */
+	std::chrono::milliseconds flush_interval;
+
+	AsyncSettings() : queue_size(8192), overflow_policy(OverflowPolicy::Block), flush_interval(1000) {}
+};
+
 /**
  * Print the message to the log
+ * When async logging is running, the message is queued and sinks are called from the logger thread
+ * Fatal messages flush the log before exiting
  */
 CORE_API void log(SeverityFlagBits severity, const std::string& message);
 
@@ -45,6 +71,23 @@ CORE_API void log(SeverityFlagBits severity, const std::string& message);
  */
 CORE_API void add_sink(std::unique_ptr<Sink>&& sink);
 
+/**
+ * True if a sink accepts this severity, checked before formatting so filtered messages cost nothing
+ */
+CORE_API bool is_enabled(SeverityFlagBits severity);
+
+/**
+ * Start the logger thread, sinks are called synchronously until then
+ * \return false if it is already running
+ */
+CORE_API bool start_async(const AsyncSettings& in_settings = {});
+
+/** Log the queued messages and stop the logger thread */
+CORE_API void stop_async();
+
+/** Block until every message logged before this call is written and sinks are flushed */
+CORE_API void flush();
+
 /**
  * Utils functions for logging
  */
@@ -52,6 +95,9 @@ CORE_API void add_sink(std::unique_ptr<Sink>&& sink);
 template<typename... Args>
 ZE_FORCEINLINE void logf(SeverityFlagBits severity, std::string_view format, Args&&... args)
 {
+	if (!is_enabled(severity))
+		return;
+
 	log(severity, fmt::format(format, std::forward<Args>(args)...));
 }
 
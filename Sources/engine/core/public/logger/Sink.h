@@ -20,6 +20,9 @@ public:
 
 	virtual void log(const Message& message) = 0;
 
+	/** Called after batches of messages, buffered sinks should write their buffer */
+	virtual void flush() {}
+
 	ZE_FORCEINLINE const std::string& get_name() const { return name; }
 	ZE_FORCEINLINE const SeverityFlags& get_severity_flags() const { return severity_flags; }
 protected:
@@ -14,6 +14,7 @@ public:
     StdSink(const std::string& name) : Sink(name) {}
 
     void log(const Message& message) override;
+    void flush() override;
 };
 
 }
\ No newline at end of file
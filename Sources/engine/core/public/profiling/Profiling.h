@@ -1,13 +1,192 @@
 #pragma once
 
 #include "EngineCore.h"
-#include "NonCopyable.h"
-#include <variant>
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <ostream>
+#include <string>
 #include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define ZE_PROFILING_USE_TSC 1
+#endif
 
-namespace ZE::Profiling
+/**
+ * CPU profiler
+ * Zones are only recorded while a capture is running, each thread appends them to its own buffer
+ *	without locking, buffers are collected when the capture ends
+ * The recorder is an always-on alternative: each thread keeps its last zones in a preallocated ring buffer,
+ *	a snapshot of the last frames can be taken at any time (used to dump traces of hitches)
+ * Timestamps are raw TSC ticks on x86-64 (steady clock nanoseconds otherwise)
+ * Zones are compiled in when ZE_FEATURE(PROFILING) or ZE_FEATURE(HITCH_RECORDER) is enabled,
+ *	without ZE_FEATURE(PROFILING) captures are compiled out and zones only feed the recorder
+ */
+namespace ze::profiling
 {
 
-}
\ No newline at end of file
+struct Event
+{
+	/** Must have a static storage duration */
+	const char* name;
+	int64_t begin;
+	int64_t end;
+};
+
+struct ThreadCapture
+{
+	std::thread::id thread_id;
+	std::string name;
+	std::vector<Event> events;
+
+	/** Events that didn't fit in the thread buffer */
+	uint64_t dropped;
+};
+
+struct Capture
+{
+	std::vector<ThreadCapture> threads;
+
+	/** Timestamps of each new_frame call */
+	std::vector<int64_t> frames;
+	int64_t begin;
+	int64_t end;
+	double ticks_per_microsecond;
+
+	Capture() : begin(0), end(0), ticks_per_microsecond(1.0) {}
+};
+
+struct Settings
+{
+	/** Max events recorded by each thread during a capture */
+	size_t thread_buffer_size;
+
+	Settings() : thread_buffer_size(64 * 1024) {}
+};
+
+struct RecorderSettings
+{
+	/** Events kept by the ring buffer of each thread, older events are overwritten */
+	size_t thread_buffer_size;
+
+	/** Frame timestamps kept */
+	size_t frame_count;
+
+	RecorderSettings() : thread_buffer_size(16 * 1024), frame_count(256) {}
+};
+
+/**
+ * Start recording zones, always fails when ZE_FEATURE(PROFILING) is disabled
+ * \param in_frame_count Frames to capture, new_frame returns true once they are captured. 0 to capture until end_capture
+ * \return false if a capture is already running
+ */
+CORE_API bool begin_capture(const uint32_t in_frame_count = 0, const Settings& in_settings = {});
+
+/** Stop recording and collect the events of every thread */
+CORE_API Capture end_capture();
+
+CORE_API bool is_capturing();
+
+/**
+ * Start the recorder, restarts it if it is already running
+ * Ring buffers are allocated by each thread the first time it records a zone, the buffer of an exited
+ *	thread is released by new_frame once its events are older than the recorded frames
+ */
+CORE_API void enable_recorder(const RecorderSettings& in_settings = {});
+
+/** Stop the recorder, thread buffers are released the next time their thread records a zone */
+CORE_API void disable_recorder();
+
+CORE_API bool is_recorder_enabled();
+
+/**
+ * Copy the zones recorded during the last frames, the current frame is included
+ * \param in_frame_count Frames to copy, bounded by RecorderSettings::frame_count. Older zones may already
+ *	have been overwritten on busy threads
+ */
+CORE_API Capture snapshot_recorder(const uint32_t in_frame_count);
+
+/**
+ * Mark the beginning of a frame, call it from the main loop
+ * \return true when the requested frame count has been captured, end_capture should be called
+ */
+CORE_API bool new_frame();
+
+/** Write a capture in the Chrome trace event format, can be opened by chrome://tracing and Perfetto */
+CORE_API void write_chrome_trace(const Capture& in_capture, std::ostream& out_stream);
+
+namespace detail
+{
+
+ZE_FORCEINLINE int64_t get_timestamp()
+{
+#if ZE_PROFILING_USE_TSC
+	return static_cast<int64_t>(__rdtsc());
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+CORE_API void record(const char* in_name, const int64_t in_begin, const int64_t in_end);
+
+enum RecordingFlagBits : uint32_t
+{
+	RecordingCapture = 1 << 0,
+	RecordingRecorder = 1 << 1,
+};
+
+/** Mirrors is_capturing and is_recorder_enabled so zones check both with a single load */
+extern CORE_API std::atomic_uint32_t recording_flags;
+
+#if ZE_FEATURE(PROFILING)
+inline constexpr uint32_t zone_recording_flags = RecordingCapture | RecordingRecorder;
+#else
+inline constexpr uint32_t zone_recording_flags = RecordingRecorder;
+#endif
+
+}
+
+/** A capture or the recorder is running */
+ZE_FORCEINLINE bool is_recording()
+{
+	return detail::recording_flags.load(std::memory_order_relaxed) != 0;
+}
+
+/**
+ * Record a zone from its construction to its destruction
+ */
+class Scope
+{
+public:
+	ZE_FORCEINLINE Scope(const char* in_name) : name(in_name),
+		begin(detail::recording_flags.load(std::memory_order_relaxed) & detail::zone_recording_flags ?
+			detail::get_timestamp() : 0) {}
+
+	ZE_FORCEINLINE ~Scope()
+	{
+		if (begin != 0)
+			detail::record(name, begin, detail::get_timestamp());
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+private:
+	const char* name;
+	int64_t begin;
+};
+
+}
+
+#if ZE_FEATURE(PROFILING) || ZE_FEATURE(HITCH_RECORDER)
+/** Profile the current scope, name must have a static storage duration (string literal...) */
+#define ZE_PROFILE_SCOPE(name) ze::profiling::Scope ZE_CONCAT(ze_profile_scope_, __LINE__)(name)
+#define ZE_PROFILE_FUNCTION() ZE_PROFILE_SCOPE(__func__)
+#else
+#define ZE_PROFILE_SCOPE(name)
+#define ZE_PROFILE_FUNCTION()
+#endif
@@ -19,6 +19,29 @@ struct TypeVersion
 #define ZE_SERL_TYPE_VERSION(T, Ver) \
 	template<> struct ze::serialization::TypeVersion<T> { constexpr static uint32_t version = Ver; constexpr static bool has_version = true; }; \
 
+/**
+ * Types whose serialized representation is their memory representation
+ * Contiguous containers of these types are serialized with a single save_bytes/load_bytes by binary archives
+ */
+template<typename T>
+struct IsTriviallySerializable
+{
+	/** bool is excluded: std::vector<bool> has no data() and arbitrary bytes aren't valid bools */
+	static constexpr bool value = (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>;
+};
+
+template<typename T>
+static constexpr bool is_trivially_serializable = IsTriviallySerializable<T>::value;
+
+/**
+ * Mark T as trivially serializable, T must be trivially copyable and its serialize function
+ * must write every member in declaration order without padding
+ * \warning This changes the format of containers of T (no per-element version)
+ */
+#define ZE_SERL_TRIVIALLY_SERIALIZABLE(T) \
+	static_assert(std::is_trivially_copyable_v<T>, #T " must be trivially copyable"); \
+	template<> struct ze::serialization::IsTriviallySerializable<T> { static constexpr bool value = true; };
+
 template<typename T, typename Archive>
 static constexpr bool has_serialize_function =
 	requires(Archive& archive, T& data) { serialize(archive, data); };
@@ -150,6 +173,13 @@ static constexpr bool is_output_archive = std::is_base_of_v<OutputArchive<T>, T>
 template<typename T>
 static constexpr bool is_archive = is_input_archive<T> || is_output_archive<T>;
 
+/**
+ * Archives that can load/save a contiguous array of T as raw bytes
+ */
+template<typename T, typename Archive>
+static constexpr bool can_serialize_as_bytes = is_trivially_serializable<T> && 
+	is_serializable<BinaryData<T>, Archive>;
+
 /** Pre-serialize and post-serialize, called before and after serialization. Useful for some serializers */
 template<typename Archive, typename T>
 void pre_serialize(Archive& archive, const T& data) {}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Archive.h"
+#include <type_traits>
+#include <span>
+#include <vector>
+#include <cstring>
+
+namespace ze::serialization
+{
+
+/**
+ * Input binary archive reading from a contiguous memory block
+ * Produces the same format as BinaryInputArchive but without going through a std::istream
+ * Reads are bounds-checked: reading past the end fills the destination with zeros and marks the archive as failed
+ */
+class MemoryInputArchive : public InputArchive<MemoryInputArchive>
+{
+public:
+	MemoryInputArchive(std::span<const uint8_t> in_data) : InputArchive<MemoryInputArchive>(*this),
+		data(in_data), cursor(0), failed(false) {}
+
+	ZE_FORCEINLINE void load_bytes(void* dst, const uint64_t& size)
+	{
+		if (size > data.size() - cursor) [[unlikely]]
+		{
+			on_overflow(dst, size);
+			return;
+		}
+
+		memcpy(dst, data.data() + cursor, size);
+		cursor += size;
+	}
+
+	/** Skip size bytes */
+	ZE_FORCEINLINE void skip(const uint64_t& size)
+	{
+		if (size > data.size() - cursor) [[unlikely]]
+		{
+			on_overflow(nullptr, size);
+			return;
+		}
+
+		cursor += size;
+	}
+
+	ZE_FORCEINLINE size_t get_cursor() const { return cursor; }
+	ZE_FORCEINLINE size_t get_remaining() const { return data.size() - cursor; }
+	ZE_FORCEINLINE std::span<const uint8_t> get_data() const { return data; }
+
+	/** True if a read went past the end of the data */
+	ZE_FORCEINLINE bool has_failed() const { return failed; }
+private:
+	void on_overflow(void* dst, const uint64_t& size)
+	{
+		if (!failed)
+			ze::logger::error("MemoryInputArchive: tried to read {} bytes at offset {} but only {} bytes are available",
+				size, cursor, data.size() - cursor);
+
+		if (dst)
+			memset(dst, 0, size);
+
+		failed = true;
+		cursor = data.size();
+	}
+private:
+	std::span<const uint8_t> data;
+	size_t cursor;
+	bool failed;
+};
+
+/**
+ * Output binary archive appending to a growable byte buffer
+ */
+class MemoryOutputArchive : public OutputArchive<MemoryOutputArchive>
+{
+public:
+	MemoryOutputArchive(std::vector<uint8_t>& in_buffer) : OutputArchive<MemoryOutputArchive>(*this),
+		buffer(in_buffer) {}
+
+	ZE_FORCEINLINE void save_bytes(const void* src, const uint64_t& size)
+	{
+		const size_t offset = buffer.size();
+		buffer.resize(offset + size);
+		memcpy(buffer.data() + offset, src, size);
+	}
+
+	ZE_FORCEINLINE std::vector<uint8_t>& get_buffer() { return buffer; }
+private:
+	std::vector<uint8_t>& buffer;
+};
+
+/** Serialize functions for memory archives */
+
+/** Arithmetic & enum types */
+template<typename T>
+	requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+ZE_FORCEINLINE void serialize(MemoryInputArchive& archive, T& data)
+{
+	archive.load_bytes(&data, sizeof(T));
+}
+
+template<typename T>
+	requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+ZE_FORCEINLINE void serialize(MemoryOutputArchive& archive, const T& data)
+{
+	archive.save_bytes(&data, sizeof(T));
+}
+
+/** Binary archives */
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryInputArchive& archive, BinaryData<T>& data)
+{
+	archive.load_bytes(data.data, data.size);
+}
+
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryOutputArchive& archive, const BinaryData<T>& data)
+{
+	archive.save_bytes(data.data, data.size);
+}
+
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryInputArchive& archive, NamedData<T>& data)
+{
+	archive <=> data.data;
+}
+
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryOutputArchive& archive, NamedData<T>& data)
+{
+	archive <=> data.data;
+}
+
+/** Containers size */
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryInputArchive& archive, Size<T>& data)
+{
+	archive <=> data.size;
+}
+
+template<typename T>
+ZE_FORCEINLINE void serialize(MemoryOutputArchive& archive, const Size<T>& data)
+{
+	archive <=> data.size;
+}
+
+}
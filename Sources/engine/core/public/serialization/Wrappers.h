@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 namespace ze::serialization
 {
 
@@ -22,7 +24,8 @@ ZE_FORCEINLINE Size<T> make_size(T&& in_size)
 template<typename T>
 struct BinaryData
 {
-	void* data;
+	/** Const data can only be saved */
+	std::conditional_t<std::is_const_v<T>, const void*, void*> data;
 	uint64_t size;
 
 	BinaryData(T* in_data, const uint64_t& in_size) : data(in_data), size(in_size) {}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "serialization/Archive.h"
+#include <array>
+
+namespace ze::serialization
+{
+
+/**
+ * Fixed-size arrays, the size is not serialized
+ */
+template<typename Archive, typename T, size_t N>
+ZE_FORCEINLINE void serialize(Archive& archive, std::array<T, N>& array)
+{
+	if constexpr (can_serialize_as_bytes<T, Archive>)
+	{
+		archive <=> make_binary_data(array.data(), sizeof(T) * N);
+	}
+	else
+	{
+		for (auto& elem : array)
+			archive <=> elem;
+	}
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "serialization/Archive.h"
+#include <span>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace ze::serialization
+{
+
+namespace detail
+{
+
+template<typename Archive, typename T>
+ZE_FORCEINLINE void serialize_span_elements(Archive& archive, T* data, const size_t size)
+{
+	if constexpr (can_serialize_as_bytes<std::remove_const_t<T>, Archive>)
+	{
+		if(size > 0)
+			archive <=> make_binary_data(data, sizeof(T) * size);
+	}
+	else
+	{
+		for (size_t i = 0; i < size; ++i)
+			archive <=> data[i];
+	}
+}
+
+}
+
+/**
+ * Spans are serialized like vectors
+ * When loading, the span must already point to a buffer of the serialized size, 
+ *	otherwise the serialized elements are skipped and the span is left untouched
+ */
+template<typename Archive, typename T, size_t Extent>
+ZE_FORCEINLINE void serialize(Archive& archive, std::span<T, Extent>& span)
+{
+	static_assert(!is_input_archive<Archive> || !std::is_const_v<T>, "Can't load into a span of const elements");
+
+	typename std::span<T, Extent>::size_type size = span.size();
+
+	archive <=> make_size(size);
+	if constexpr (is_input_archive<Archive>)
+	{
+		if(size != span.size())
+		{
+			ZE_CHECKF(false, "Span size mismatch (serialized: {}, span: {})", size, span.size());
+
+			/** Consume the whole record so the archive stays in sync */
+			if constexpr (can_serialize_as_bytes<std::remove_const_t<T>, Archive>)
+			{
+				/** Raw elements are read as plain bytes, no T is ever constructed */
+				std::array<std::byte, 4096> skipped;
+				for (uint64_t remaining = size * sizeof(T); remaining > 0;)
+				{
+					const size_t read_size = std::min<uint64_t>(remaining, skipped.size());
+					archive <=> make_binary_data(skipped.data(), read_size);
+					remaining -= read_size;
+				}
+			}
+			else
+			{
+				std::remove_const_t<T> skipped{};
+				for (size_t i = 0; i < size; ++i)
+					archive <=> skipped;
+			}
+			return;
+		}
+	}
+
+	detail::serialize_span_elements(archive, span.data(), size);
+}
+
+}
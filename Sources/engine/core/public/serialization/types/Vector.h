@@ -15,8 +15,26 @@ ZE_FORCEINLINE void serialize(Archive& archive, std::vector<T>& vector)
 	if constexpr (is_input_archive<Archive>)
 		vector.resize(size);
 
-	for (auto& elem : vector)
-		archive <=> elem;
+	if constexpr (can_serialize_as_bytes<T, Archive>)
+	{
+		if(size > 0)
+			archive <=> make_binary_data(vector.data(), sizeof(T) * size);
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		/** std::vector<bool> elements are proxies */
+		for (size_t i = 0; i < size; ++i)
+		{
+			bool elem = vector[i];
+			archive <=> elem;
+			vector[i] = elem;
+		}
+	}
+	else
+	{
+		for (auto& elem : vector)
+			archive <=> elem;
+	}
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+
+/**
+ * Named mutexes recording their contention
+ * Each name has its own statistics (shared by every mutex with the same name): acquisitions, contended
+ *	acquisitions and a wait time histogram, printed by the lock_stats command
+ * Statistics are sharded per thread so mutexes sharing a name don't contend on them, and are only looked
+ *	up on the first lock so mutexes can be constant-initialized
+ * Uncontended acquisitions only cost a try_lock and a relaxed increment, the wait is only timed when the
+ *	lock is contended
+ * When ZE_FEATURE(LOCK_STATS) is disabled they are plain std::mutex/std::shared_mutex
+ */
+namespace ze
+{
+
+namespace detail
+{
+
+struct LockStats
+{
+	/** Bucket 0 is below 1 us, bucket i is [2^(i - 1), 2^i[ us, the last one is everything above */
+	static constexpr size_t wait_bucket_count = 16;
+	static constexpr size_t shard_count = 16;
+
+	/** Counters of a group of threads, padded to avoid false sharing */
+	struct alignas(64) Shard
+	{
+		std::atomic_uint64_t acquisitions;
+		std::atomic_uint64_t contentions;
+		std::atomic_uint64_t total_wait_ns;
+		std::atomic_uint64_t max_wait_ns;
+		std::array<std::atomic_uint64_t, wait_bucket_count> wait_histogram;
+
+		Shard() : acquisitions(0), contentions(0), total_wait_ns(0), max_wait_ns(0), wait_histogram() {}
+	};
+
+	/** Must have a static storage duration */
+	const char* name;
+	std::array<Shard, shard_count> shards;
+
+	LockStats(const char* in_name) : name(in_name) {}
+
+	/** Threads are assigned a shard round-robin */
+	ZE_FORCEINLINE static size_t get_thread_shard()
+	{
+		static std::atomic_size_t next_shard = 0;
+		thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+		return shard;
+	}
+
+	ZE_FORCEINLINE void record_acquisition()
+	{
+		shards[get_thread_shard()].acquisitions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	CORE_API void record_contention(const std::chrono::steady_clock::duration& in_wait_time);
+};
+
+/** Get the statistics of a lock name, they live until the end of the program */
+CORE_API LockStats& get_lock_stats(const char* in_name);
+
+/**
+ * Statistics of a named lock, looked up on first use
+ */
+class LockStatsRef
+{
+public:
+	constexpr explicit LockStatsRef(const char* in_name) : name(in_name), stats(nullptr) {}
+
+	ZE_FORCEINLINE LockStats& get()
+	{
+		LockStats* lock_stats = stats.load(std::memory_order_acquire);
+		if (!lock_stats)
+		{
+			/** Every thread gets the same entry for a name, racing stores are harmless */
+			lock_stats = &get_lock_stats(name);
+			stats.store(lock_stats, std::memory_order_release);
+		}
+
+		return *lock_stats;
+	}
+private:
+	const char* name;
+	std::atomic<LockStats*> stats;
+};
+
+}
+
+#if ZE_FEATURE(LOCK_STATS)
+
+/**
+ * A std::mutex recording its contention
+ */
+class Mutex
+{
+public:
+	/** \param in_name Must have a static storage duration */
+	constexpr explicit Mutex(const char* in_name) : stats(in_name) {}
+
+	Mutex(const Mutex&) = delete;
+	Mutex& operator=(const Mutex&) = delete;
+
+	void lock()
+	{
+		detail::LockStats& lock_stats = stats.get();
+		lock_stats.record_acquisition();
+		if (mutex.try_lock())
+			return;
+
+		const auto begin = std::chrono::steady_clock::now();
+		mutex.lock();
+		lock_stats.record_contention(std::chrono::steady_clock::now() - begin);
+	}
+
+	bool try_lock()
+	{
+		if (!mutex.try_lock())
+			return false;
+
+		stats.get().record_acquisition();
+		return true;
+	}
+
+	void unlock() { mutex.unlock(); }
+private:
+	std::mutex mutex;
+	detail::LockStatsRef stats;
+};
+
+/**
+ * A std::shared_mutex recording its contention, shared and exclusive acquisitions share the same statistics
+ */
+class SharedMutex
+{
+public:
+	/** \param in_name Must have a static storage duration */
+	explicit SharedMutex(const char* in_name) : stats(in_name) {}
+
+	SharedMutex(const SharedMutex&) = delete;
+	SharedMutex& operator=(const SharedMutex&) = delete;
+
+	void lock()
+	{
+		detail::LockStats& lock_stats = stats.get();
+		lock_stats.record_acquisition();
+		if (mutex.try_lock())
+			return;
+
+		const auto begin = std::chrono::steady_clock::now();
+		mutex.lock();
+		lock_stats.record_contention(std::chrono::steady_clock::now() - begin);
+	}
+
+	bool try_lock()
+	{
+		if (!mutex.try_lock())
+			return false;
+
+		stats.get().record_acquisition();
+		return true;
+	}
+
+	void unlock() { mutex.unlock(); }
+
+	void lock_shared()
+	{
+		detail::LockStats& lock_stats = stats.get();
+		lock_stats.record_acquisition();
+		if (mutex.try_lock_shared())
+			return;
+
+		const auto begin = std::chrono::steady_clock::now();
+		mutex.lock_shared();
+		lock_stats.record_contention(std::chrono::steady_clock::now() - begin);
+	}
+
+	bool try_lock_shared()
+	{
+		if (!mutex.try_lock_shared())
+			return false;
+
+		stats.get().record_acquisition();
+		return true;
+	}
+
+	void unlock_shared() { mutex.unlock_shared(); }
+private:
+	std::shared_mutex mutex;
+	detail::LockStatsRef stats;
+};
+
+#else
+
+class Mutex : public std::mutex
+{
+public:
+	constexpr explicit Mutex([[maybe_unused]] const char* in_name) {}
+};
+
+class SharedMutex : public std::shared_mutex
+{
+public:
+	explicit SharedMutex([[maybe_unused]] const char* in_name) {}
+};
+
+#endif
+
+}
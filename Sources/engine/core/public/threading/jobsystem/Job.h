@@ -73,7 +73,11 @@ struct CORE_API alignas(job_alignement) Job
 	ZE_FORCEINLINE bool is_finished() const { return unfinished_jobs == 0; }
 };
 
-/** Schedule the job */
+/**
+ * Schedule the job
+ * Can be called from any thread, jobs scheduled from threads that aren't workers (e.g I/O threads)
+ *	are queued in a shared queue that workers poll when their own queue is empty
+ */
 CORE_API void schedule(const Job& job);
 
 /** Schedule the job after the specified job finish */
@@ -95,6 +99,11 @@ namespace detail
 	 * If this job has dependents, it will execute them
 	 */
 	CORE_API void finish(const Job& InJob);
+
+	/**
+	 * Pop a job scheduled from a thread that isn't a worker
+	 */
+	CORE_API const Job* pop_external_job();
 }
 
 
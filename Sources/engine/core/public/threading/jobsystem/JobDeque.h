@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mutex>
+#include "threading/Mutex.h"
 #include <deque>
 
 namespace ze::jobsystem
@@ -15,15 +15,17 @@ struct Job;
 class JobDeque
 {
 public:
+	JobDeque() : mutex("JobDeque") {}
+
 	void push(const Job* elem)
 	{
-		std::lock_guard<std::mutex> guard(mutex);
+		std::lock_guard<Mutex> guard(mutex);
 		deque.push_back(elem);
 	}
 
 	const Job* pop()
 	{
-		std::lock_guard<std::mutex> guard(mutex);
+		std::lock_guard<Mutex> guard(mutex);
 		if(is_empty())
 			return nullptr;
 
@@ -37,7 +39,7 @@ public:
 	 */
 	const Job* steal()
 	{
-		std::lock_guard<std::mutex> guard(mutex);
+		std::lock_guard<Mutex> guard(mutex);
 		if (is_empty())
 			return nullptr;
 
@@ -53,11 +55,11 @@ public:
 
 	size_t get_size()
 	{
-		std::lock_guard<std::mutex> guard(mutex);
+		std::lock_guard<Mutex> guard(mutex);
 		return deque.size();
 	}
 private:
-	std::mutex mutex;
+	Mutex mutex;
 	std::deque<const Job*> deque;
 };
 
@@ -103,6 +103,9 @@ CORE_API WorkerThread& get_worker();
  */
 CORE_API size_t get_worker_idx();
 CORE_API size_t get_worker_count();
+
+/** True if the calling thread is a worker (including the main thread) */
+CORE_API bool is_worker_thread();
 ZE_FORCEINLINE size_t get_main_worker_idx() { return 0; }
 
 }
\ No newline at end of file
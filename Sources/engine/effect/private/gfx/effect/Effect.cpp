@@ -3,6 +3,7 @@
 #include "gfx/BackendManager.h"
 #include "zefs/FileStream.h"
 #include "threading/jobsystem/Async.h"
+#include "threading/Mutex.h"
 #endif
 #include <bit>
 
@@ -10,7 +11,7 @@ namespace ze::gfx
 {
 
 #if ZE_WITH_EDITOR
-std::mutex permutation_lock;
+Mutex permutation_lock("Effect permutations");
 #endif
 
 Effect::Effect(const std::string& in_name,
@@ -50,7 +51,7 @@ Effect::~Effect()
 std::future<EffectCompilerResult> Effect::compile(const EffectPermutationId id, const ShaderFormat& in_format)
 {
 	{
-		std::lock_guard<std::mutex> lock(permutation_lock);
+		std::lock_guard<Mutex> lock(permutation_lock);
 
 		if(pending_compilation.contains(id))
 			return {};
@@ -69,7 +70,7 @@ std::future<EffectCompilerResult> Effect::compile(const EffectPermutationId id,
 
 			/** Apply changes to class */
 			{
-				std::lock_guard<std::mutex> lock(permutation_lock);
+				std::lock_guard<Mutex> lock(permutation_lock);
 				pending_compilation.erase(id);
 
 				if(result.succeed)
@@ -108,7 +109,7 @@ Effect::Permutation* Effect::get_permutation(const EffectPermutationId id)
 {
 #if ZE_WITH_EDITOR
 	{
-		std::lock_guard<std::mutex> lock(permutation_lock);
+		std::lock_guard<Mutex> lock(permutation_lock);
 		auto it = permutations.find(id);
 
 		if(it != permutations.end())
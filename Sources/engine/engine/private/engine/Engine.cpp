@@ -8,6 +8,11 @@
 #include "engine/InputSystem.h"
 #include "module/Module.h"
 #include "assetdatabase/AssetDatabase.h"
+#include "zefs/ZEFS.h"
+#include "engine/FrameStats.h"
+#include "engine/HitchRecorder.h"
+#include <charconv>
+#include <ostream>
 
 namespace ze
 {
@@ -27,6 +32,57 @@ static ConVarRef<int32_t> CVarSimFPS("sim_fixed_dt", 20,
 	1,
 	60);
 
+static std::string profile_capture_path;
+
+static ConCmdRef cmd_profile_capture("profile_capture",
+	"Capture CPU zones of the next frames to a Chrome trace file. profile_capture [frames = 60] [path = Logs/Profile.json]",
+	[](const std::vector<std::string_view>& in_params)
+	{
+		uint32_t frames = 60;
+		if (!in_params.empty())
+		{
+			auto result = std::from_chars(in_params[0].data(), in_params[0].data() + in_params[0].size(), frames);
+			if (result.ec != std::errc() || frames == 0)
+			{
+				ze::logger::error("Invalid frame count \"{}\"", in_params[0]);
+				return;
+			}
+		}
+
+#if ZE_FEATURE(PROFILING)
+		profile_capture_path = in_params.size() > 1 ? std::string(in_params[1]) : "Logs/Profile.json";
+		if (profiling::begin_capture(frames))
+			ze::logger::info("Capturing {} frames to {}", frames, profile_capture_path);
+		else
+			ze::logger::error("A profiler capture is already running");
+#else
+		ze::logger::error("Profiling is disabled in this build");
+#endif
+	});
+
+/** Write the capture started by profile_capture */
+void save_profiler_capture()
+{
+	const profiling::Capture capture = profiling::end_capture();
+
+	size_t event_count = 0;
+	for (const auto& thread : capture.threads)
+		event_count += thread.events.size();
+
+	std::unique_ptr<std::streambuf> buffer(filesystem::write(profile_capture_path,
+		filesystem::FileWriteFlagBits::ReplaceExisting));
+	if (!buffer)
+	{
+		ze::logger::error("Failed to write profiler capture to {}", profile_capture_path);
+		return;
+	}
+
+	std::ostream stream(buffer.get());
+	profiling::write_chrome_trace(capture, stream);
+	ze::logger::info("Wrote {} events from {} threads to {}", event_count, capture.threads.size(),
+		profile_capture_path);
+}
+
 bool bRun = true;
 
 ZE_DEFINE_MODULE(ze::module::DefaultModule, engine)
@@ -102,13 +158,28 @@ void EngineApp::exit(int in_err_code)
 double engine_elapsed_time = 0.0;
 double engine_delta_time = 0.0;
 
+/** Timings of the previous frame, its frame time is known at the start of the next one */
+framestats::FrameTimings last_frame_timings;
+
 void EngineApp::loop()
 {
+	if (profiling::new_frame())
+		save_profiler_capture();
+
+	ZE_PROFILE_SCOPE("Frame");
+
 	auto current = std::chrono::high_resolution_clock::now();
 	std::chrono::duration<double, std::milli> delta_time = current - previous;
 	previous = current;
 
 	engine_delta_time = delta_time.count();
+	if (frame_count > 0)
+	{
+		last_frame_timings.times_ms[static_cast<size_t>(framestats::Metric::Frame)] = static_cast<float>(engine_delta_time);
+		framestats::add_frame(last_frame_timings);
+		hitchrecorder::on_frame(engine_delta_time);
+	}
+
 	float delta_time_as_secs = static_cast<float>(engine_delta_time) * 0.001f;
 
 	engine_elapsed_time += delta_time_as_secs;
@@ -117,6 +188,7 @@ void EngineApp::loop()
 
 	/** Process events */
 	{
+		ZE_PROFILE_SCOPE("Process events");
 		SDL_Event event;
 		while (SDL_PollEvent(&event))
 		{
@@ -124,13 +196,26 @@ void EngineApp::loop()
 		}
 	}
 
+	const auto tick_begin = std::chrono::high_resolution_clock::now();
 	ticksystem::tick(ticksystem::TickFlagBits::Variable, delta_time_as_secs);
 	ticksystem::tick(ticksystem::TickFlagBits::Late, delta_time_as_secs);
-	post_tick(delta_time_as_secs);
+
+	const auto render_begin = std::chrono::high_resolution_clock::now();
+	{
+		ZE_PROFILE_SCOPE("Post tick");
+		post_tick(delta_time_as_secs);
+	}
+
+	const auto render_end = std::chrono::high_resolution_clock::now();
+	last_frame_timings.times_ms[static_cast<size_t>(framestats::Metric::Tick)] =
+		std::chrono::duration<float, std::milli>(render_begin - tick_begin).count();
+	last_frame_timings.times_ms[static_cast<size_t>(framestats::Metric::Render)] =
+		std::chrono::duration<float, std::milli>(render_end - render_begin).count();
 
 	/** Fps limiter */
 	if(cvar_maxfps.get() != 0)
 	{
+		ZE_PROFILE_SCOPE("Frame limiter");
 		using namespace std::chrono_literals;
 
 		focused = true;
@@ -0,0 +1,213 @@
+#include "engine/FrameStats.h"
+#include "console/Console.h"
+#include "zefs/ZEFS.h"
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <streambuf>
+#include <vector>
+
+namespace ze::framestats
+{
+
+static constexpr size_t metric_count = static_cast<size_t>(Metric::Count);
+static constexpr const char* csv_path = "Logs/FrameStats.csv";
+
+static ConVarRef<float> cvar_hitch_ms("stats_hitch_ms", 50.f,
+	"Frames slower than this (in ms) are counted as hitches",
+	1.f,
+	10000.f);
+
+static ConVarRef<int32_t> cvar_csv_interval("stats_csv_interval", 10,
+	"Seconds between two frame stats summaries written to Logs/FrameStats.csv. 0 to disable",
+	0,
+	3600);
+
+/** Rolling window, ring buffers indexed by next_sample */
+std::array<std::array<float, window_size>, metric_count> history;
+size_t next_sample = 0;
+size_t sample_count = 0;
+uint64_t total_frame_count = 0;
+uint64_t total_hitch_count = 0;
+
+/** Frames since the last CSV export */
+std::array<std::vector<float>, metric_count> interval_samples;
+uint64_t interval_hitch_count = 0;
+std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+std::chrono::steady_clock::time_point last_export_time = start_time;
+std::unique_ptr<std::streambuf> csv_file;
+bool csv_failed = false;
+
+/**
+ * Compute the statistics of in_samples, they are sorted in place
+ */
+MetricStats compute_metric(std::vector<float>& in_samples)
+{
+	MetricStats stats;
+	if (in_samples.empty())
+		return stats;
+
+	std::sort(in_samples.begin(), in_samples.end());
+
+	/** Nearest rank */
+	const auto percentile = [&](const double in_percentile)
+	{
+		const size_t rank = static_cast<size_t>(std::ceil(in_percentile * in_samples.size()));
+		return in_samples[std::clamp<size_t>(rank, 1, in_samples.size()) - 1];
+	};
+
+	stats.average_ms = static_cast<float>(std::accumulate(in_samples.begin(), in_samples.end(), 0.0) /
+		in_samples.size());
+	stats.p50_ms = percentile(0.50);
+	stats.p95_ms = percentile(0.95);
+	stats.p99_ms = percentile(0.99);
+	stats.max_ms = in_samples.back();
+	return stats;
+}
+
+void write_csv_row()
+{
+	if (!csv_file)
+	{
+		csv_file.reset(filesystem::write(csv_path, filesystem::FileWriteFlagBits::ReplaceExisting));
+		if (!csv_file)
+		{
+			ze::logger::error("Failed to open {}, frame stats won't be exported", csv_path);
+			csv_failed = true;
+			return;
+		}
+
+		std::string header = "time_s,frames,hitches";
+		for (size_t i = 0; i < metric_count; ++i)
+		{
+			const char* name = get_metric_name(static_cast<Metric>(i));
+			header += fmt::format(",{0}_avg_ms,{0}_p50_ms,{0}_p95_ms,{0}_p99_ms,{0}_max_ms", name);
+		}
+		header += '\n';
+		csv_file->sputn(header.data(), static_cast<std::streamsize>(header.size()));
+	}
+
+	const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	std::string row = fmt::format("{:.3f},{},{}", time, interval_samples[0].size(), interval_hitch_count);
+	for (auto& samples : interval_samples)
+	{
+		const MetricStats stats = compute_metric(samples);
+		row += fmt::format(",{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}", stats.average_ms, stats.p50_ms,
+			stats.p95_ms, stats.p99_ms, stats.max_ms);
+	}
+	row += '\n';
+
+	csv_file->sputn(row.data(), static_cast<std::streamsize>(row.size()));
+	csv_file->pubsync();
+}
+
+void add_frame(const FrameTimings& in_timings)
+{
+	for (size_t i = 0; i < metric_count; ++i)
+	{
+		history[i][next_sample] = in_timings.times_ms[i];
+		interval_samples[i].emplace_back(in_timings.times_ms[i]);
+	}
+
+	next_sample = (next_sample + 1) % window_size;
+	sample_count = std::min(sample_count + 1, window_size);
+	total_frame_count++;
+
+	if (in_timings.times_ms[static_cast<size_t>(Metric::Frame)] > cvar_hitch_ms.get())
+	{
+		total_hitch_count++;
+		interval_hitch_count++;
+	}
+
+	/** Periodic export */
+	const int32_t interval = cvar_csv_interval.get();
+	const auto now = std::chrono::steady_clock::now();
+	if (interval == 0 || csv_failed)
+	{
+		for (auto& samples : interval_samples)
+			samples.clear();
+		interval_hitch_count = 0;
+		last_export_time = now;
+	}
+	else if (now - last_export_time >= std::chrono::seconds(interval))
+	{
+		write_csv_row();
+		for (auto& samples : interval_samples)
+			samples.clear();
+		interval_hitch_count = 0;
+		last_export_time = now;
+	}
+}
+
+Stats compute_stats()
+{
+	Stats stats;
+	stats.frame_count = sample_count;
+	stats.total_frame_count = total_frame_count;
+	stats.total_hitch_count = total_hitch_count;
+
+	const float hitch_threshold = cvar_hitch_ms.get();
+	std::vector<float> samples;
+	samples.reserve(sample_count);
+	for (size_t i = 0; i < metric_count; ++i)
+	{
+		samples.assign(history[i].begin(), history[i].begin() + sample_count);
+		if (static_cast<Metric>(i) == Metric::Frame)
+			stats.hitch_count = std::count_if(samples.begin(), samples.end(),
+				[&](const float in_time) { return in_time > hitch_threshold; });
+
+		stats.metrics[i] = compute_metric(samples);
+	}
+
+	return stats;
+}
+
+std::span<const float> get_history(const Metric in_metric, size_t& out_offset)
+{
+	/** The ring buffer is only full once window_size frames have been recorded */
+	out_offset = sample_count == window_size ? next_sample : 0;
+	return std::span<const float>(history[static_cast<size_t>(in_metric)].data(), sample_count);
+}
+
+float get_hitch_threshold_ms()
+{
+	return cvar_hitch_ms.get();
+}
+
+const char* get_metric_name(const Metric in_metric)
+{
+	switch (in_metric)
+	{
+	case Metric::Frame:
+		return "frame";
+	case Metric::Tick:
+		return "tick";
+	case Metric::Render:
+		return "render";
+	default:
+		return "unknown";
+	}
+}
+
+static ConCmdRef cmd_stats_frame("stats_frame", "Print frame time statistics of the last frames",
+	[](const std::vector<std::string_view>& in_params)
+	{
+		const Stats stats = compute_stats();
+
+		std::string text = fmt::format("Frame stats ({} frames, {} hitches > {} ms, {} hitches in {} frames total)",
+			stats.frame_count, stats.hitch_count, cvar_hitch_ms.get(), stats.total_hitch_count,
+			stats.total_frame_count);
+		for (size_t i = 0; i < metric_count; ++i)
+		{
+			const MetricStats& metric = stats.metrics[i];
+			text += fmt::format("\n\t- {}: avg {:.2f} ms, p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms",
+				get_metric_name(static_cast<Metric>(i)), metric.average_ms, metric.p50_ms, metric.p95_ms,
+				metric.p99_ms, metric.max_ms);
+		}
+
+		ze::logger::info("{}", text);
+	});
+
+}
@@ -0,0 +1,195 @@
+#include "engine/HitchRecorder.h"
+#include "console/Console.h"
+#include "profiling/Profiling.h"
+#include "threading/jobsystem/Async.h"
+#include "zefs/ZEFS.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+
+namespace ze::hitchrecorder
+{
+
+#if ZE_FEATURE(HITCH_RECORDER)
+static ConVarRef<int32_t> cvar_enabled("hitch_recorder", 1,
+	"Keep the CPU zones of the last frames and write a trace to Logs/ when a frame is slower than hitch_recorder_ms",
+	0,
+	1);
+
+static ConVarRef<float> cvar_threshold_ms("hitch_recorder_ms", 100.f,
+	"Frames slower than this (in ms) are dumped by the hitch recorder",
+	1.f,
+	10000.f);
+
+static ConVarRef<int32_t> cvar_frames_before("hitch_recorder_frames_before", 60,
+	"Frames preceding the hitch written to the trace",
+	0,
+	1000);
+
+static ConVarRef<int32_t> cvar_frames_after("hitch_recorder_frames_after", 10,
+	"Frames following the hitch written to the trace, the trace is written once they are recorded",
+	0,
+	1000);
+
+static ConVarRef<float> cvar_cooldown("hitch_recorder_cooldown", 30.f,
+	"Min seconds between two hitch traces",
+	0.f,
+	3600.f);
+
+static ConVarRef<int32_t> cvar_thread_events("hitch_recorder_thread_events", 16 * 1024,
+	"Zones kept by each thread (rounded up to a power of two), older zones are overwritten",
+	1024,
+	1024 * 1024);
+
+/** Settings the recorder runs with */
+bool enabled = false;
+profiling::RecorderSettings settings;
+
+/** Frames left before writing a detected hitch, -1 if there is none */
+int32_t frames_until_dump = -1;
+float pending_hitch_ms = 0.f;
+
+bool has_dumped = false;
+std::chrono::steady_clock::time_point last_dump_time;
+
+/** A trace is being written by a job */
+std::atomic_bool writing_trace = false;
+
+/** Frame markers needed to cover the frames before, the hitch, the frames after and the current one */
+size_t get_required_frame_markers()
+{
+	return static_cast<size_t>(cvar_frames_before.get()) + static_cast<size_t>(cvar_frames_after.get()) + 2;
+}
+
+/** Start, stop or restart the recorder when the convars changed */
+void update_recorder()
+{
+	if (!cvar_enabled.get())
+	{
+		if (enabled)
+		{
+			profiling::disable_recorder();
+			enabled = false;
+			frames_until_dump = -1;
+		}
+		return;
+	}
+
+	const size_t thread_events = static_cast<size_t>(cvar_thread_events.get());
+	const size_t frame_count = get_required_frame_markers();
+	if (enabled && settings.thread_buffer_size == thread_events && settings.frame_count >= frame_count)
+		return;
+
+	settings.thread_buffer_size = thread_events;
+	settings.frame_count = frame_count;
+	profiling::enable_recorder(settings);
+	enabled = true;
+	frames_until_dump = -1;
+}
+
+void write_trace(const profiling::Capture& in_capture, const std::string& in_path)
+{
+	const auto begin = std::chrono::steady_clock::now();
+
+	std::unique_ptr<std::streambuf> buffer(filesystem::write(in_path, filesystem::FileWriteFlagBits::ReplaceExisting));
+	if (!buffer)
+	{
+		ze::logger::error("Failed to write hitch trace to {}", in_path);
+		return;
+	}
+
+	std::ostream stream(buffer.get());
+	profiling::write_chrome_trace(in_capture, stream);
+
+	size_t event_count = 0;
+	for (const auto& thread : in_capture.threads)
+		event_count += thread.events.size();
+
+	ze::logger::info("Wrote hitch trace {} ({} frames, {} events, took {:.2f} ms)", in_path,
+		in_capture.frames.empty() ? 0 : in_capture.frames.size() - 1, event_count,
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+}
+
+bool dump(const std::string_view& in_reason)
+{
+	if (!enabled || writing_trace)
+		return false;
+
+	/** Only the snapshot is taken on the main thread, the trace is written by a job */
+	auto capture = std::make_shared<profiling::Capture>(profiling::snapshot_recorder(
+		static_cast<uint32_t>(get_required_frame_markers())));
+
+	const std::time_t time = std::time(nullptr);
+	const std::tm local_time = *::localtime(&time);
+	const std::string path = fmt::format("Logs/Hitch_{:04}{:02}{:02}_{:02}{:02}{:02}_{}.json",
+		local_time.tm_year + 1900, local_time.tm_mon + 1, local_time.tm_mday, local_time.tm_hour, local_time.tm_min,
+		local_time.tm_sec, in_reason);
+
+	has_dumped = true;
+	last_dump_time = std::chrono::steady_clock::now();
+	writing_trace = true;
+	jobsystem::async([capture, path](const jobsystem::Job& in_job)
+	{
+		write_trace(*capture, path);
+		writing_trace = false;
+	});
+	return true;
+}
+
+void on_frame(const double in_frame_time_ms)
+{
+	update_recorder();
+	if (!enabled)
+		return;
+
+	if (frames_until_dump > 0)
+	{
+		frames_until_dump--;
+	}
+	else if (in_frame_time_ms > cvar_threshold_ms.get())
+	{
+		const bool cooling_down = has_dumped && std::chrono::steady_clock::now() - last_dump_time <
+			std::chrono::duration<float>(cvar_cooldown.get());
+		if (cooling_down)
+			return;
+
+		/** Frames following the hitch are recorded before writing the trace */
+		pending_hitch_ms = static_cast<float>(in_frame_time_ms);
+		frames_until_dump = cvar_frames_after.get();
+	}
+
+	if (frames_until_dump == 0)
+	{
+		frames_until_dump = -1;
+		dump(fmt::format("{}ms", static_cast<int32_t>(pending_hitch_ms)));
+	}
+}
+#else
+void on_frame([[maybe_unused]] const double in_frame_time_ms) {}
+
+bool dump([[maybe_unused]] const std::string_view& in_reason)
+{
+	return false;
+}
+#endif
+
+static ConCmdRef cmd_hitch_dump("hitch_recorder_dump", "Write the frames kept by the hitch recorder to a trace now",
+	[](const std::vector<std::string_view>& in_params)
+	{
+#if ZE_FEATURE(HITCH_RECORDER)
+		if (!cvar_enabled.get())
+			ze::logger::error("The hitch recorder is disabled (hitch_recorder 0)");
+		else if (!enabled)
+			ze::logger::error("The hitch recorder starts with the next frame");
+		else if (!dump("manual"))
+			ze::logger::error("A hitch trace is already being written");
+#else
+		ze::logger::error("The hitch recorder is disabled in this build");
+#endif
+	});
+
+}
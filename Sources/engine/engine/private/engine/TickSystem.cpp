@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "engine/Engine.h"
 #include <queue>
+#include "profiling/Profiling.h"
 
 namespace ze::ticksystem
 {
@@ -47,8 +48,26 @@ void unregister_tickable(Tickable* in_tickable)
 	}
 }
 
+/** Static names for profiling zones */
+const char* get_tick_zone_name(TickFlagBits in_flag_bit)
+{
+	switch(in_flag_bit)
+	{
+	case TickFlagBits::Fixed:
+		return "Fixed tick";
+	case TickFlagBits::Variable:
+		return "Variable tick";
+	case TickFlagBits::Late:
+		return "Late tick";
+	default:
+		return "Tick";
+	}
+}
+
 void tick(TickFlagBits in_flag_bit, const float in_delta_time)
 {
+	ZE_PROFILE_SCOPE(get_tick_zone_name(in_flag_bit));
+
 	/**
 	 * Process tickables that wait for registration
 	 */
@@ -48,6 +48,8 @@ void TexturePlatformData::load(Texture* in_texture)
 				+ std::to_string(mip.width) + "_"
 				+ std::to_string(mip.height) + "_"
 				+ std::to_string(mip.depth);
+
+			/** Copied as recooking the texture rewrites the cache entry */
 			mip.data = assetdatacache::get_sync(key);
 		}
 #endif
@@ -29,55 +29,39 @@ void* ComponentManager::add_component(Entity in_entity, const reflection::Class*
 	if(archetypes.size() > entity_data.archetype_idx)
 		old_archetype = archetypes[entity_data.archetype_idx].get();
 
-	/** Create the new archetype */
-	EntityArchetype* new_archetype = nullptr;
+	if(old_archetype && old_archetype->id.has(in_class))
 	{
-		EntityArchetypeId new_id;
-		if(old_archetype)
-			new_id.append(old_archetype->id);
-		new_id.add(in_class);
-		auto [new_archetype_ptr, idx] = get_or_create_archetype(new_id);
-		new_archetype = new_archetype_ptr;
+		ZE_CHECKF(false, "Entity already has this component");
+		return get_component(in_entity, in_class);
 	}
 
+	EntityArchetype* new_archetype = get_add_transition(old_archetype, in_class);
+
 	size_t dst_chunk_idx = get_free_chunk(*new_archetype);
 	EntityArchetypeChunk& dst_chunk = new_archetype->chunks[dst_chunk_idx];
 	size_t dst_component_type_idx = new_archetype->class_to_chunk_type_idx[in_class];
-	dst_chunk.data[dst_component_type_idx].size++;
-	size_t dst_component_idx = dst_chunk.data[dst_component_type_idx].get_end_idx();
+	size_t dst_component_idx = dst_chunk.entities.size();
+	for(auto& data : dst_chunk.data)
+		data.size++;
+	dst_chunk.entities.emplace_back(in_entity);
 
 	if(old_archetype)
 	{
 		/** Move old data before instantiating the new component */
 		EntityArchetypeChunk& src_chunk = old_archetype->chunks[entity_data.chunk_idx];
-		
-		old_archetype->entities.erase(std::find(old_archetype->entities.begin(), old_archetype->entities.end(), in_entity));
-		
 		for(const auto& type : old_archetype->id.classes)
 		{
-			dst_chunk.data[new_archetype->class_to_chunk_type_idx[type]].size++;
-
 			move_component_data(src_chunk, dst_chunk,
 				old_archetype->class_to_chunk_type_idx[type],
 				new_archetype->class_to_chunk_type_idx[type],
 				entity_data.components_idx,
 				dst_component_idx);
-		
-			/** If a hole was created, fill hole */
-			if(entity_data.components_idx == src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size - 1)
-			{
-				move_component_data(src_chunk, src_chunk,
-					old_archetype->class_to_chunk_type_idx[type],
-					old_archetype->class_to_chunk_type_idx[type],
-					src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size - 1,
-					entity_data.components_idx);
-			}
-
-			src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size--;
 		}
+
+		remove_from_archetype(*old_archetype, entity_data);
 	}
 	
-	void* out_data = dst_chunk.data[dst_component_type_idx].get_end();
+	void* out_data = dst_chunk.data[dst_component_type_idx].at(dst_component_idx);
 	if(in_instantiate)
 	{
 		in_class->placement_new(out_data);
@@ -86,6 +70,7 @@ void* ComponentManager::add_component(Entity in_entity, const reflection::Class*
 	entity_data.archetype_idx = new_archetype->idx;
 	entity_data.chunk_idx = dst_chunk_idx;
 	entity_data.components_idx = dst_component_idx;
+	entity_data.archetype_entity_idx = new_archetype->entities.size();
 
 	new_archetype->entities.emplace_back(in_entity);
 
@@ -104,71 +89,126 @@ void ComponentManager::remove_component(Entity in_entity, const reflection::Clas
 	if(archetypes.size() > entity_data.archetype_idx)
 		old_archetype = archetypes[entity_data.archetype_idx].get();
 
-	/** Create the new archetype */
-	EntityArchetype* new_archetype = nullptr;
+	if(!old_archetype || !old_archetype->id.has(in_class))
 	{
-		EntityArchetypeId new_id = old_archetype->id;
-		new_id.remove(in_class);
-		auto [new_archetype_ptr, idx] = get_or_create_archetype(new_id);
-		new_archetype = new_archetype_ptr;
+		ZE_CHECKF(false, "Entity doesn't have this component");
+		return;
 	}
 
-	size_t src_chunk_idx = entity_data.chunk_idx;
+	EntityArchetype* new_archetype = get_remove_transition(*old_archetype, in_class);
+
 	EntityArchetypeChunk& src_chunk = old_archetype->chunks[entity_data.chunk_idx];
-	old_archetype->entities.erase(std::find(old_archetype->entities.begin(), old_archetype->entities.end(), in_entity));
-	
+	free_component_data(in_class, src_chunk, 
+		old_archetype->class_to_chunk_type_idx[in_class],
+		entity_data.components_idx);
+
 	if(new_archetype)
 	{
 		/** Move the existing data minus the data of the component we remove */
 		size_t dst_chunk_idx = get_free_chunk(*new_archetype);
 		EntityArchetypeChunk& dst_chunk = new_archetype->chunks[dst_chunk_idx];
-		size_t dst_component_idx = dst_chunk.data[0].size;
-		new_archetype->entities.emplace_back(in_entity);
+		size_t dst_component_idx = dst_chunk.entities.size();
+		for(auto& data : dst_chunk.data)
+			data.size++;
+		dst_chunk.entities.emplace_back(in_entity);
 		
 		for(const auto& type : new_archetype->id.classes)
 		{
-			dst_chunk.data[new_archetype->class_to_chunk_type_idx[type]].size++;
-
 			move_component_data(src_chunk, dst_chunk,
 				old_archetype->class_to_chunk_type_idx[type],
 				new_archetype->class_to_chunk_type_idx[type],
 				entity_data.components_idx,
 				dst_component_idx);
-
-			/** If a hole was created, fill hole */
-			if(entity_data.components_idx == src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size - 1)
-			{
-				move_component_data(src_chunk, src_chunk,
-					old_archetype->class_to_chunk_type_idx[type],
-					old_archetype->class_to_chunk_type_idx[type],
-					src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size - 1,
-					entity_data.components_idx);
-			}
-
-			src_chunk.data[old_archetype->class_to_chunk_type_idx[type]].size--;
 		}
 
-		free_component_data(in_class, src_chunk, 
-			old_archetype->class_to_chunk_type_idx[in_class],
-			entity_data.components_idx);
-
-		src_chunk.data[old_archetype->class_to_chunk_type_idx[in_class]].size--;
+		remove_from_archetype(*old_archetype, entity_data);
 
 		entity_data.archetype_idx = new_archetype->idx;
 		entity_data.chunk_idx = dst_chunk_idx;
 		entity_data.components_idx = dst_component_idx;
+		entity_data.archetype_entity_idx = new_archetype->entities.size();
+		new_archetype->entities.emplace_back(in_entity);
+
+		if(dst_chunk.is_full())
+			new_archetype->free_chunk = dst_chunk.next_free_chunk;
 	}
 	else
 	{
-		/** No components to move, free all of them */
-		free_component_data(in_class, src_chunk, 
-			old_archetype->class_to_chunk_type_idx[in_class],
-			entity_data.components_idx);
-		src_chunk.data[old_archetype->class_to_chunk_type_idx[in_class]].size--;
-		entity_data.archetype_idx = -1;
+		/** No components to move */
+		remove_from_archetype(*old_archetype, entity_data);
+		entity_data = EntityData();
 	}
+}
+
+void ComponentManager::remove_from_archetype(EntityArchetype& in_archetype, const EntityData& in_entity_data)
+{
+	EntityArchetypeChunk& chunk = in_archetype.chunks[in_entity_data.chunk_idx];
+	const bool was_full = chunk.is_full();
+
+	/** Fill the hole with the last components of the chunk */
+	const size_t last_idx = chunk.entities.size() - 1;
+	if(in_entity_data.components_idx != last_idx)
+	{
+		for(size_t i = 0; i < chunk.data.size(); ++i)
+			move_component_data(chunk, chunk, i, i, last_idx, in_entity_data.components_idx);
 
-	old_archetype->free_chunk = src_chunk_idx;
+		const Entity moved_entity = chunk.entities[last_idx];
+		chunk.entities[in_entity_data.components_idx] = moved_entity;
+		entity_data_map.find(moved_entity)->second.components_idx = in_entity_data.components_idx;
+	}
+
+	for(auto& data : chunk.data)
+		data.size--;
+	chunk.entities.pop_back();
+
+	const Entity last_entity = in_archetype.entities.back();
+	in_archetype.entities[in_entity_data.archetype_entity_idx] = last_entity;
+	entity_data_map.find(last_entity)->second.archetype_entity_idx = in_entity_data.archetype_entity_idx;
+	in_archetype.entities.pop_back();
+
+	/** The chunk has room again */
+	if(was_full)
+	{
+		chunk.next_free_chunk = in_archetype.free_chunk;
+		in_archetype.free_chunk = in_entity_data.chunk_idx;
+	}
+}
+
+EntityArchetype* ComponentManager::get_add_transition(EntityArchetype* in_archetype, const reflection::Class* in_class)
+{
+	auto& edges = in_archetype ? in_archetype->add_edges : root_add_edges;
+	auto edge = edges.find(in_class);
+	if(edge != edges.end())
+		return archetypes[edge->second].get();
+
+	EntityArchetypeId new_id;
+	if(in_archetype)
+		new_id = in_archetype->id;
+	new_id.add(in_class);
+
+	auto [new_archetype, idx] = get_or_create_archetype(new_id);
+	edges.insert({ in_class, idx });
+	new_archetype->remove_edges.insert({ in_class, in_archetype ? in_archetype->idx : EntityArchetypeId::invalid_idx });
+	return new_archetype;
+}
+
+EntityArchetype* ComponentManager::get_remove_transition(EntityArchetype& in_archetype, const reflection::Class* in_class)
+{
+	auto edge = in_archetype.remove_edges.find(in_class);
+	if(edge != in_archetype.remove_edges.end())
+		return edge->second != EntityArchetypeId::invalid_idx ? archetypes[edge->second].get() : nullptr;
+
+	EntityArchetypeId new_id = in_archetype.id;
+	new_id.remove(in_class);
+
+	auto [new_archetype, idx] = get_or_create_archetype(new_id);
+	in_archetype.remove_edges.insert({ in_class, idx });
+	if(new_archetype)
+		new_archetype->add_edges.insert({ in_class, in_archetype.idx });
+	else
+		root_add_edges.insert({ in_class, in_archetype.idx });
+
+	return new_archetype;
 }
 
 void ComponentManager::move_component_data(EntityArchetypeChunk& in_src, EntityArchetypeChunk& in_dst, 
@@ -253,17 +293,16 @@ std::pair<EntityArchetype*, size_t> ComponentManager::get_or_create_archetype(co
 	if(in_id.classes.empty())
 		return { nullptr, -1 };
 
-	for(size_t i = 0; i < archetypes.size(); ++i)
-	{
-		if(archetypes[i]->id == in_id)
-			return { archetypes[i].get(), i };
-	}
+	auto it = archetype_map.find(in_id);
+	if(it != archetype_map.end())
+		return { archetypes[it->second].get(), it->second };
 
 	archetypes.emplace_back(std::make_unique<EntityArchetype>());
 	auto& archetype = archetypes.back();
 	archetype->idx = archetypes.size() - 1;
 	archetype->id = in_id;
 	archetype->free_chunk = get_free_chunk(*archetype);
+	archetype_map.insert({ in_id, archetype->idx });
 
 	return { archetypes.back().get(), archetypes.size() - 1 };
 }
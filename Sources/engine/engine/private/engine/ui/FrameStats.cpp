@@ -0,0 +1,51 @@
+#include "engine/ui/FrameStats.h"
+#include "engine/FrameStats.h"
+#include "gfx/Gfx.h"
+#include "imgui/ImGui.h"
+#include <algorithm>
+
+namespace ze::ui
+{
+
+void draw_frame_stats(const float in_graph_height)
+{
+	const framestats::Stats stats = framestats::compute_stats();
+	const float hitch_threshold = framestats::get_hitch_threshold_ms();
+
+	ImGui::Text("%zu frames, %zu hitches (> %.1f ms), %llu hitches total", stats.frame_count, stats.hitch_count,
+		hitch_threshold, static_cast<unsigned long long>(stats.total_hitch_count));
+
+	for (size_t i = 0; i < static_cast<size_t>(framestats::Metric::Count); ++i)
+	{
+		const framestats::Metric metric = static_cast<framestats::Metric>(i);
+		const framestats::MetricStats& metric_stats = stats.get(metric);
+
+		size_t offset = 0;
+		const std::span<const float> history = framestats::get_history(metric, offset);
+
+		/** The frame graph always shows the hitch threshold so hitches stand out */
+		const float scale_max = metric == framestats::Metric::Frame ?
+			std::max(metric_stats.max_ms, hitch_threshold) : metric_stats.max_ms;
+
+		const std::string overlay = fmt::format("{} p50 {:.2f} p95 {:.2f} p99 {:.2f} max {:.2f} ms",
+			framestats::get_metric_name(metric), metric_stats.p50_ms, metric_stats.p95_ms, metric_stats.p99_ms,
+			metric_stats.max_ms);
+
+		ImGui::PushID(static_cast<int>(i));
+		ImGui::PlotLines("", history.data(), static_cast<int>(history.size()), static_cast<int>(offset),
+			overlay.c_str(), 0.f, std::max(scale_max, 0.001f),
+			ImVec2(ImGui::GetContentRegionAvail().x, in_graph_height));
+		ImGui::PopID();
+	}
+
+	if (ImGui::TreeNode("Gfx (last frame)"))
+	{
+		const gfx::DeviceStats& gfx_stats = gfx::Device::get().get_last_frame_stats();
+		for (size_t i = 0; i < static_cast<size_t>(gfx::DeviceCounter::Count); ++i)
+			ImGui::Text("%s: %llu", gfx::get_device_counter_name(static_cast<gfx::DeviceCounter>(i)),
+				static_cast<unsigned long long>(gfx_stats.counters[i]));
+		ImGui::TreePop();
+	}
+}
+
+}
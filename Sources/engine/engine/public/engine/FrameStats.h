@@ -0,0 +1,87 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <array>
+#include <span>
+
+/**
+ * Frame time statistics
+ * Keeps a rolling window of the last frames, computes percentiles on demand and periodically
+ *	appends a summary to Logs/FrameStats.csv (see stats_csv_interval)
+ * Must only be used from the main thread
+ */
+namespace ze::framestats
+{
+
+enum class Metric : uint8_t
+{
+	/** Time between two frames */
+	Frame,
+
+	/** Variable and late ticks, the main loop doesn't run fixed ticks */
+	Tick,
+
+	/** EngineApp::post_tick, draws and submits the frame */
+	Render,
+
+	Count
+};
+
+/** Frames kept in the rolling window */
+static constexpr size_t window_size = 1024;
+
+struct FrameTimings
+{
+	std::array<float, static_cast<size_t>(Metric::Count)> times_ms;
+
+	FrameTimings() : times_ms() {}
+};
+
+struct MetricStats
+{
+	float average_ms;
+	float p50_ms;
+	float p95_ms;
+	float p99_ms;
+	float max_ms;
+
+	MetricStats() : average_ms(0.f), p50_ms(0.f), p95_ms(0.f), p99_ms(0.f), max_ms(0.f) {}
+};
+
+struct Stats
+{
+	std::array<MetricStats, static_cast<size_t>(Metric::Count)> metrics;
+
+	/** Frames in the window */
+	size_t frame_count;
+
+	/** Frames of the window slower than the hitch threshold */
+	size_t hitch_count;
+
+	/** Since the start of the engine */
+	uint64_t total_frame_count;
+	uint64_t total_hitch_count;
+
+	Stats() : frame_count(0), hitch_count(0), total_frame_count(0), total_hitch_count(0) {}
+
+	ZE_FORCEINLINE const MetricStats& get(const Metric in_metric) const { return metrics[static_cast<size_t>(in_metric)]; }
+};
+
+/** Record a frame, called by EngineApp */
+ENGINE_API void add_frame(const FrameTimings& in_timings);
+
+/** Compute the statistics of the window */
+ENGINE_API Stats compute_stats();
+
+/**
+ * Get the rolling window of a metric
+ * \param out_offset Index of the oldest sample, values are a ring buffer (like ImGui::PlotLines values_offset)
+ */
+ENGINE_API std::span<const float> get_history(const Metric in_metric, size_t& out_offset);
+
+/** Frames slower than this are counted as hitches (stats_hitch_ms) */
+ENGINE_API float get_hitch_threshold_ms();
+
+ENGINE_API const char* get_metric_name(const Metric in_metric);
+
+}
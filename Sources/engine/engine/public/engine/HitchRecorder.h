@@ -0,0 +1,27 @@
+#pragma once
+
+#include "EngineCore.h"
+
+/**
+ * Always-on hitch recorder
+ * Keeps the CPU zones of the last frames with profiling's recorder, when a frame is slower than
+ *	hitch_recorder_ms a Chrome trace of the frames around it is written to Logs/ by a job
+ * Enabled in every build configuration, the functions do nothing when ZE_FEATURE(HITCH_RECORDER) is disabled
+ * Must only be used from the main thread
+ */
+namespace ze::hitchrecorder
+{
+
+/**
+ * Called by EngineApp at the start of each frame
+ * \param in_frame_time_ms Duration of the previous frame
+ */
+ENGINE_API void on_frame(const double in_frame_time_ms);
+
+/**
+ * Snapshot the recorded frames now and write them to a trace file from a job
+ * \return false if the recorder is disabled or the previous trace is still being written
+ */
+ENGINE_API bool dump(const std::string_view& in_reason);
+
+}
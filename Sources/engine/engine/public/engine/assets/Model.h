@@ -57,6 +57,7 @@ struct ModelVertex
     }
 };
 ZE_SERL_TYPE_VERSION(ModelVertex, ModelVertex::Ver0);
+ZE_SERL_TRIVIALLY_SERIALIZABLE(ModelVertex);
 
 /**
  * A view to a vertex buffer
@@ -77,11 +78,14 @@ struct ModelLod
     enum Version
     {
         Ver0,
+
+        /** Vertices and indices are raw aligned bulk regions */
+        Ver1,
     };
 
     /** Actual vertex, index data. Only available in editor/when keep_in_ram is true */
-    std::vector<ModelVertex> vertices;
-    std::vector<uint32_t> indices;
+    AssetBulkData<ModelVertex> vertices;
+    AssetBulkData<uint32_t> indices;
 
     /** Map each material to a view of the vertex buffer */
     std::vector<ModelVertexView> material_views;
@@ -99,13 +103,19 @@ struct ModelLod
         index_buffer_idx(0), vertex_count(0), index_count(0) {}
 
     template<typename ArchiveType>
-    void serialize(ArchiveType& in_archive, const uint32_t& in_version)
+    void serialize(AssetArchive<ArchiveType>& in_archive, const uint32_t& in_version)
     {
+        if (in_version < Ver1)
+        {
+            in_archive.reject("ModelLod data predates raw bulk vertices, the model must be reimported");
+            return;
+        }
+
         in_archive <=> vertices;
         in_archive <=> indices;
     }
 };
-ZE_SERL_TYPE_VERSION(ModelLod, ModelLod::Ver0);
+ZE_SERL_TYPE_VERSION(ModelLod, ModelLod::Ver1);
 
 ZCLASS()
 class ENGINE_API Model : public Asset
@@ -125,6 +135,8 @@ public:
 	  
     }
 
+    bool use_block_compression() const override { return true; }
+
     /**
      * \return Handle to the large vertex buffer array containing all models vertex buffers
      */
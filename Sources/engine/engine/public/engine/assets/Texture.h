@@ -77,8 +77,8 @@ struct TextureMipmap
 	uint32_t height;
 	uint32_t depth;
 
-	/** Actual texture data */
-	std::vector<uint8_t> data;
+	/** Actual texture data, a view into the asset file when loaded */
+	AssetBulkData<uint8_t> data;
 	
 	/** View to this mipmap */
 	gfx::UniqueTextureView view;
@@ -89,8 +89,8 @@ struct TextureMipmap
 	TextureMipmap(const uint32_t in_width,
 		const uint32_t in_height,
 		const uint32_t in_depth,
-		const std::vector<uint8_t>& in_data) : width(in_width),
-		height(in_height), depth(in_depth), data(in_data) {}
+		std::vector<uint8_t> in_data) : width(in_width),
+		height(in_height), depth(in_depth), data(std::move(in_data)) {}
 
 	template<typename ArchiveType>
 	void serialize(AssetArchive<ArchiveType>& in_archive)
@@ -202,6 +202,9 @@ public:
 	enum Version
 	{
 		Ver0 = 0,
+
+		/** Mipmap data are raw aligned bulk regions */
+		Ver1,
 	};
 
 	enum TextureAssetFormat
@@ -237,6 +240,12 @@ public:
 	template<typename ArchiveType>
 	void serialize(AssetArchive<ArchiveType>& in_archive, const uint32_t& in_version)
 	{
+		if (in_version < Ver1)
+		{
+			in_archive.reject("Texture data predates raw bulk mipmaps, the texture must be reimported");
+			return;
+		}
+
 		in_archive <=> type;
 		in_archive <=> filter;
 		in_archive <=> compression_mode;
@@ -257,6 +266,8 @@ public:
 			update_resource();
 	}
 	 
+	bool use_block_compression() const override { return true; }
+
 	/**
 	 * Recreate the underlying texture resource
 	 * This will recook the asset if in editor
@@ -316,6 +327,6 @@ private:
 	gfx::UniqueTexture texture;
 	gfx::UniqueTextureView texture_view;
 };
-ZE_SERL_TYPE_VERSION(Texture, Texture::Ver0);
+ZE_SERL_TYPE_VERSION(Texture, Texture::Ver1);
 
 }
\ No newline at end of file
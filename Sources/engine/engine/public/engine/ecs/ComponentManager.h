@@ -2,6 +2,7 @@
 
 #include "ECS.h"
 #include "engine/ecs/Component.h"
+#include "maths/MathCore.h"
 #include <robin_hood.h>
 #include <array>
 #include "ComponentManager.gen.h"
@@ -73,6 +74,27 @@ struct EntityArchetypeId
 	ZE_FORCEINLINE bool operator==(const EntityArchetypeId& other) const { return classes == other.classes; }
 };
 
+}
+
+namespace std
+{
+	template<> struct hash<ze::EntityArchetypeId>
+	{
+		ZE_FORCEINLINE uint64_t operator()(const ze::EntityArchetypeId& in_id) const
+		{
+			uint64_t hash = 0;
+
+			for(const auto& class_ : in_id.classes)
+				ze::hash_combine(hash, class_);
+
+			return hash;
+		}
+	};
+}
+
+namespace ze
+{
+
 struct EntityArchetypeChunk
 {
 	static constexpr uint64_t chunk_data_size = 16384;
@@ -101,6 +123,11 @@ struct EntityArchetypeChunk
 	};
 
 	std::vector<ComponentData> data;
+
+	/** Entity owning the components at each index */
+	std::vector<Entity> entities;
+
+	/** Next chunk of the archetype free list, only chunks that are not full are in the list */
 	size_t next_free_chunk = -1;
 
 	ZE_FORCEINLINE bool is_full() const
@@ -120,6 +147,13 @@ struct EntityArchetype
 	std::vector<EntityArchetypeChunk> chunks;
 	robin_hood::unordered_map<const reflection::Class*, size_t> class_to_chunk_type_idx;
 	size_t free_chunk = -1;
+
+	/**
+	 * Archetype reached when adding/removing a component type, filled by the first transition
+	 * EntityArchetypeId::invalid_idx when removing the last component
+	 */
+	robin_hood::unordered_flat_map<const reflection::Class*, size_t> add_edges;
+	robin_hood::unordered_flat_map<const reflection::Class*, size_t> remove_edges;
 };
 
 /*
@@ -138,6 +172,9 @@ class ENGINE_API ComponentManager final
 		size_t archetype_idx = invalid_idx;
 		size_t chunk_idx = invalid_idx;
 		size_t components_idx = invalid_idx;
+
+		/** Index in EntityArchetype::entities */
+		size_t archetype_entity_idx = invalid_idx;
 	};
 
 public:
@@ -186,6 +223,24 @@ public:
 	ZE_FORCEINLINE const auto& get_archetypes() const { return archetypes; }
 private:
 	std::pair<EntityArchetype*, size_t> get_or_create_archetype(const EntityArchetypeId& in_id);
+
+	/**
+	 * Get the archetype of an entity of in_archetype once in_class is added
+	 * \param in_archetype nullptr for entities without components
+	 */
+	EntityArchetype* get_add_transition(EntityArchetype* in_archetype, const reflection::Class* in_class);
+
+	/**
+	 * Get the archetype of an entity of in_archetype once in_class is removed
+	 * \return nullptr if the entity has no components left
+	 */
+	EntityArchetype* get_remove_transition(EntityArchetype& in_archetype, const reflection::Class* in_class);
+
+	/**
+	 * Remove an entity from its archetype and chunk without destroying its components
+	 * The last components of the chunk are moved to fill the hole
+	 */
+	void remove_from_archetype(EntityArchetype& in_archetype, const EntityData& in_entity_data);
 	
 	/**
 	 * Get a free chunk from this archetype
@@ -218,6 +273,11 @@ private:
 		size_t in_component_idx);
 private:
 	std::vector<std::unique_ptr<EntityArchetype>> archetypes;
+	robin_hood::unordered_map<EntityArchetypeId, size_t> archetype_map;
+
+	/** Archetypes of entities without components once a component type is added */
+	robin_hood::unordered_flat_map<const reflection::Class*, size_t> root_add_edges;
+
 	robin_hood::unordered_flat_map<Entity, EntityData> entity_data_map;
 };
 
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "EngineCore.h"
+
+namespace ze::ui
+{
+
+/**
+ * Draw a compact summary and graphs of the frame stats and the gfx counters in the current ImGui window
+ * \param in_graph_height Height of each graph in pixels
+ */
+ENGINE_API void draw_frame_stats(const float in_graph_height = 50.f);
+
+}
@@ -29,6 +29,8 @@ void CommandList::reset()
 	pipeline_layout = {};
 	render_pass = {};
 	gfx_pipeline = {};
+	sets_to_update.clear();
+	stats = {};
 }
 
 void CommandList::begin_render_pass(const RenderPassInfo& in_render_pass,
@@ -127,6 +129,7 @@ void CommandList::texture_barrier(const DeviceResourceHandle& in_texture,
 {
 	ZE_CHECKF(std::this_thread::get_id() == thread, "Can't record commands from another thread that the thread that created this list");
 	Texture* texture = Device::get().get_texture(in_texture);
+	stats.add(DeviceCounter::Barriers);
 
 	Backend::get().cmd_pipeline_barrier(handle,
 		in_src_flags,
@@ -273,11 +276,14 @@ void CommandList::process_gfx_pipeline()
 	ZE_CHECKF(pipeline_layout, "No pipeline layout binded !");
 
 	PipelineLayout* layout = Device::get().get_pipeline_layout(pipeline_layout);
+	bool cache_hit = false;
 	ResourceHandle pipeline = Device::get().create_or_find_gfx_pipeline(render_pass_state, instance_state,
-		render_pass, layout->get_handle());
+		render_pass, layout->get_handle(), cache_hit);
+	stats.add(cache_hit ? DeviceCounter::PipelineCacheHits : DeviceCounter::PipelineCacheMisses);
 	if(gfx_pipeline != pipeline)
 	{
 		gfx_pipeline = pipeline;
+		stats.add(DeviceCounter::PipelineBinds);
 		Backend::get().cmd_bind_pipeline(handle,
 			PipelineBindPoint::Gfx,
 			gfx_pipeline);
@@ -305,9 +311,12 @@ void CommandList::process_descriptor_sets()
 			}
 		}
 
+		bool cache_hit = false;
 		handles.emplace_back(Backend::get().pipeline_layout_allocate_descriptor_set(layout->get_handle(),
 			set,
-			descriptors));
+			descriptors,
+			cache_hit));
+		stats.add(cache_hit ? DeviceCounter::DescriptorSetCacheHits : DeviceCounter::DescriptorSetAllocations);
 	}
 
 	if(!handles.empty())
@@ -330,6 +339,7 @@ void CommandList::draw(const uint32_t in_vertex_count,
 	ZE_CHECKF(std::this_thread::get_id() == thread, "Can't record commands from another thread that the thread that created this list");
 	process_gfx_pipeline();
 	process_descriptor_sets();
+	stats.add(DeviceCounter::Draws);
 	Backend::get().cmd_draw(handle, in_vertex_count, in_instance_count, in_first_vertex, in_first_instance);
 }
 
@@ -342,6 +352,7 @@ void CommandList::draw_indexed(const uint32_t in_index_count,
 	ZE_CHECKF(std::this_thread::get_id() == thread, "Can't record commands from another thread that the thread that created this list");
 	process_gfx_pipeline();
 	process_descriptor_sets();
+	stats.add(DeviceCounter::Draws);
 	Backend::get().cmd_draw_indexed(handle, 
 		in_index_count, 
 		in_instance_count, 
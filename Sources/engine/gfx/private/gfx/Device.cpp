@@ -1,8 +1,52 @@
 #include "gfx/Gfx.h"
+#include "console/Console.h"
+#include "profiling/Profiling.h"
 
 namespace ze::gfx
 {
 
+static ConCmdRef cmd_gfx_stats("gfx_stats", "Print the gfx counters of the last frame",
+	[](const std::vector<std::string_view>& in_params)
+	{
+		const DeviceStats& stats = Device::get().get_last_frame_stats();
+
+		std::string text = "Gfx stats (last frame)";
+		for(size_t i = 0; i < static_cast<size_t>(DeviceCounter::Count); ++i)
+			text += fmt::format("\n\t- {}: {}", get_device_counter_name(static_cast<DeviceCounter>(i)),
+				stats.counters[i]);
+
+		ze::logger::info("{}", text);
+	});
+
+const char* get_device_counter_name(const DeviceCounter in_counter)
+{
+	switch(in_counter)
+	{
+	case DeviceCounter::Draws:
+		return "draws";
+	case DeviceCounter::PipelineBinds:
+		return "pipeline binds";
+	case DeviceCounter::PipelineCacheHits:
+		return "pipeline cache hits";
+	case DeviceCounter::PipelineCacheMisses:
+		return "pipeline cache misses";
+	case DeviceCounter::DescriptorSetAllocations:
+		return "descriptor set allocations";
+	case DeviceCounter::DescriptorSetCacheHits:
+		return "descriptor set cache hits";
+	case DeviceCounter::Barriers:
+		return "barriers";
+	case DeviceCounter::BytesUploaded:
+		return "bytes uploaded";
+	case DeviceCounter::ResourcesCreated:
+		return "resources created";
+	case DeviceCounter::ResourcesDestroyed:
+		return "resources destroyed";
+	default:
+		return "unknown";
+	}
+}
+
 TextureViewInfo TextureViewInfo::make_2d_view(const DeviceResourceHandle& in_texture,
 	const Format in_format, const TextureSubresourceRange& in_subresource)
 {
@@ -118,7 +162,7 @@ void Device::Frame::free_resources()
 Device* device = nullptr;
 
 Device::Device()
-	: current_frame(0)
+	: resources_mutex("Gfx resources"), current_frame(0)
 {
 	device = this;
 }
@@ -162,8 +206,13 @@ void Device::destroy()
 
 void Device::new_frame()
 {
+	ZE_PROFILE_SCOPE("Gfx new frame");
 	Backend::get().new_frame();
 
+	/** Publish the counters of the frame that just ended */
+	for(size_t i = 0; i < counters.size(); ++i)
+		last_frame_stats.counters[i] = counters[i].exchange(0, std::memory_order_relaxed);
+
 	static bool first_frame = true;
 	
 	/** On the first frame, don't do anything. They maybe some commands list/resources queued that waits for submission */
@@ -202,6 +251,7 @@ void Device::new_frame()
 
 void Device::end_frame()
 {
+	ZE_PROFILE_SCOPE("Gfx end frame");
 	if(!get_current_frame().frame_cancelled)
 	{
 		/** Submit to queues if required */
@@ -241,6 +291,13 @@ void Device::submit(CommandList* list, const std::vector<DeviceResourceHandle>&
 	list->end();
 	lists->emplace_back(list);
 
+	const DeviceStats& list_stats = list->get_stats();
+	for(size_t i = 0; i < counters.size(); ++i)
+	{
+		if(list_stats.counters[i] != 0)
+			counters[i].fetch_add(list_stats.counters[i], std::memory_order_relaxed);
+	}
+
 	for(const auto& signal : in_signal_semaphores)
 		get_current_frame().gfx_signal_semaphores.emplace_back(signal);
 }
@@ -266,6 +323,7 @@ void Device::wait_gpu_idle()
 
 void Device::submit_queue(const CommandListType& in_type)
 {
+	ZE_PROFILE_SCOPE("Gfx submit queue");
 	std::vector<CommandList*>* lists = nullptr;
 	ResourceHandle fence;
 	std::vector<ResourceHandle> signal_semaphores;
@@ -323,10 +381,11 @@ std::pair<Result, DeviceResourceHandle> Device::create_buffer(const BufferInfo&
 	
 	DeviceResourceHandle buffer;
 	{
-		std::lock_guard<std::mutex> guard(resources_mutex);
+		std::lock_guard<Mutex> guard(resources_mutex);
 		buffer = DeviceResourceHandle::make(buffers.emplace(in_info, handle),
 			DeviceResourceType::Buffer);
 	}
+	add_counter(DeviceCounter::ResourcesCreated);
 
 	if(!in_initial_data.empty())
 	{
@@ -346,6 +405,7 @@ std::pair<Result, DeviceResourceHandle> Device::create_buffer(const BufferInfo&
 			auto [map_result, map_data] = map_buffer(buffer);
 			memcpy(map_data, in_initial_data.data(), in_initial_data.size());
 			unmap_buffer(buffer);
+			add_counter(DeviceCounter::BytesUploaded, in_initial_data.size());
 		}
 	}
 
@@ -381,10 +441,11 @@ std::pair<Result, DeviceResourceHandle> Device::create_texture(TextureInfo in_in
 
 	DeviceResourceHandle texture;
 	{
-		std::lock_guard<std::mutex> guard(resources_mutex);
+		std::lock_guard<Mutex> guard(resources_mutex);
 		texture = DeviceResourceHandle::make(textures.emplace(in_info, handle),
 			DeviceResourceType::Texture);
 	}
+	add_counter(DeviceCounter::ResourcesCreated);
 
 	if(!in_initial_data.data.empty())
 	{
@@ -393,6 +454,7 @@ std::pair<Result, DeviceResourceHandle> Device::create_texture(TextureInfo in_in
 		auto [map_result, map_data] = map_buffer(staging_buf);
 		memcpy(map_data, in_initial_data.data.data(), in_initial_data.data.size());
 		unmap_buffer(staging_buf);
+		add_counter(DeviceCounter::BytesUploaded, in_initial_data.data.size());
 
 		/**
 		 * Transition the texture to the TransferDst layout so we can copy to it and later on transfer it
@@ -438,7 +500,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_texture_view(const Textur
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(texture_views.emplace(in_info, handle), DeviceResourceType::TextureView) };
 }
 
@@ -449,7 +512,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_shader(const ShaderCreate
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(shaders.emplace(in_info, handle), DeviceResourceType::Shader) };
 }
 
@@ -460,7 +524,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_pipeline_layout(const gfx
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(pipeline_layouts.emplace(in_info, handle), DeviceResourceType::PipelineLayout) };
 }
 
@@ -471,7 +536,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_sampler(const gfx::Sample
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(samplers.emplace(in_info, handle), DeviceResourceType::Sampler) };
 }
 
@@ -482,7 +548,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_swapchain(const gfx::Swap
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(swapchains.emplace(in_info, handle), DeviceResourceType::SwapChain) };
 }
 
@@ -492,7 +559,8 @@ std::pair<Result, DeviceResourceHandle> Device::create_semaphore()
 	if(!handle)
 		return { result, {} };
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	add_counter(DeviceCounter::ResourcesCreated);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	return { result, DeviceResourceHandle::make(semaphores.emplace(handle), DeviceResourceType::Semaphore) };
 }
 
@@ -536,6 +604,7 @@ uint32_t Device::get_swapchain_current_idx(const DeviceResourceHandle& in_swapch
 
 void Device::present(const DeviceResourceHandle& in_swapchain, const std::vector<DeviceResourceHandle>& in_wait_semaphores)
 {
+	ZE_PROFILE_SCOPE("Gfx present");
 	Swapchain* swapchain = get_swapchain(in_swapchain);
 
 	std::vector<ResourceHandle> handles;
@@ -560,14 +629,15 @@ ResourceHandle Device::create_or_find_render_pass(const RenderPassCreateInfo& in
 	if(render_pass)
 		return ResourceHandle(render_pass->handle);
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	auto [result, handle] = Backend::get().render_pass_create(in_create_info);
 	render_passes.insert(in_create_info, { handle });
 	return handle;
 }
 
 ResourceHandle Device::create_or_find_gfx_pipeline(const GfxPipelineRenderPassState& in_render_pass_state,
-	const GfxPipelineInstanceState& in_instance_state, ResourceHandle in_render_pass, ResourceHandle in_pipeline_layout)
+	const GfxPipelineInstanceState& in_instance_state, ResourceHandle in_render_pass, ResourceHandle in_pipeline_layout,
+	bool& out_cache_hit)
 {
 	GfxPipelineCreateInfo create_info;
 	create_info.multisampling_state = in_render_pass_state.multisampling;
@@ -584,10 +654,11 @@ ResourceHandle Device::create_or_find_gfx_pipeline(const GfxPipelineRenderPassSt
 	create_info.pipeline_layout = in_pipeline_layout;
 
 	auto pipeline = gfx_pipelines.find(create_info);
-	if(pipeline != gfx_pipelines.end())
+	out_cache_hit = pipeline != gfx_pipelines.end();
+	if(out_cache_hit)
 		return pipeline->second;
 
-	std::lock_guard<std::mutex> guard(resources_mutex);
+	std::lock_guard<Mutex> guard(resources_mutex);
 	auto [result, handle] = Backend::get().gfx_pipeline_create(create_info);
 	gfx_pipelines.insert({ create_info, handle });
 	return handle;
@@ -597,48 +668,56 @@ void Device::destroy_buffer(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_buffers.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_texture(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_textures.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_texture_view(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_texture_views.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_shader(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_shaders.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_pipeline_layout(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_pipeline_layouts.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_sampler(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_samplers.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_swapchain(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_swapchains.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 void Device::destroy_semaphore(const DeviceResourceHandle& in_handle)
 {
 	std::lock_guard<std::mutex> guard(get_current_frame().frame_lock);
 	get_current_frame().expired_semaphores.emplace_back(in_handle);
+	add_counter(DeviceCounter::ResourcesDestroyed);
 }
 
 /** Useful getters */
@@ -3,9 +3,11 @@
 #include "gfx/Backend.h"
 #include <robin_hood.h>
 #include "containers/SparseArray.h"
+#include "threading/Mutex.h"
 #include <queue>
 #include <bitset>
 #include <mutex>
+#include <atomic>
 
 namespace std
 {
@@ -148,6 +150,52 @@ enum class CommandListType
 	Transfer
 };
 
+/**
+ * CPU-side counters of the gfx frontend, reset each frame
+ */
+enum class DeviceCounter : uint8_t
+{
+	Draws,
+	PipelineBinds,
+
+	/** Pipeline lookups of draws */
+	PipelineCacheHits,
+	PipelineCacheMisses,
+
+	/** Descriptor sets allocated or written by the backend, sets it returned from its cache are cache hits */
+	DescriptorSetAllocations,
+	DescriptorSetCacheHits,
+
+	Barriers,
+
+	/** Initial data of buffers and textures */
+	BytesUploaded,
+
+	ResourcesCreated,
+	ResourcesDestroyed,
+
+	Count
+};
+
+struct DeviceStats
+{
+	std::array<uint64_t, static_cast<size_t>(DeviceCounter::Count)> counters;
+
+	DeviceStats() : counters() {}
+
+	ZE_FORCEINLINE uint64_t get(const DeviceCounter in_counter) const
+	{
+		return counters[static_cast<size_t>(in_counter)];
+	}
+
+	ZE_FORCEINLINE void add(const DeviceCounter in_counter, const uint64_t in_value = 1)
+	{
+		counters[static_cast<size_t>(in_counter)] += in_value;
+	}
+};
+
+const char* get_device_counter_name(const DeviceCounter in_counter);
+
 /**
  * A command list
  */
@@ -230,6 +278,9 @@ public:
 
 	ZE_FORCEINLINE ResourceHandle get_backend_handle() const { return handle; }
 	ZE_FORCEINLINE CommandListType get_type() const { return type; }
+
+	/** Counters recorded since the list has been submitted or reset */
+	ZE_FORCEINLINE const DeviceStats& get_stats() const { return stats; }
 private:
 	void process_gfx_pipeline();
 	void process_descriptor_sets();
@@ -250,11 +301,11 @@ private:
 	/** Sets to update */
 	robin_hood::unordered_set<uint32_t> sets_to_update;
 
-	/** Descriptor set cache */
-	robin_hood::unordered_map<uint64_t, ResourceHandle> descriptor_sets;
-
 	/** The thread that owns the list */
 	std::thread::id thread;
+
+	/** Only written by the owning thread, merged into the device counters at submit */
+	DeviceStats stats;
 };
 
 /**
@@ -909,11 +960,20 @@ public:
 
 	ResourceHandle get_backend_texture(const DeviceResourceHandle& in_texture) const;
 	ResourceHandle get_backend_texture_view(const DeviceResourceHandle& in_texture_view) const;
+
+	/** Counters of the last completed frame, must be read from the thread calling new_frame */
+	ZE_FORCEINLINE const DeviceStats& get_last_frame_stats() const { return last_frame_stats; }
 private:
 	ResourceHandle create_or_find_render_pass(const RenderPassCreateInfo& in_create_info);
 	ResourceHandle create_or_find_gfx_pipeline(const GfxPipelineRenderPassState& in_render_pass_state,
-		const GfxPipelineInstanceState& in_instance_state, ResourceHandle in_render_pass, ResourceHandle in_pipeline_layout);
+		const GfxPipelineInstanceState& in_instance_state, ResourceHandle in_render_pass, ResourceHandle in_pipeline_layout,
+		bool& out_cache_hit);
 	void submit_queue(const CommandListType& in_type);
+
+	ZE_FORCEINLINE void add_counter(const DeviceCounter in_counter, const uint64_t in_value = 1)
+	{
+		counters[static_cast<size_t>(in_counter)].fetch_add(in_value, std::memory_order_relaxed);
+	}
 	
 	Buffer* get_buffer(const DeviceResourceHandle& in_handle);
 	PipelineLayout* get_pipeline_layout(const DeviceResourceHandle& in_handle);
@@ -936,8 +996,12 @@ private:
 	SparseArray<Swapchain> swapchains;
 	SparseArray<Semaphore> semaphores;
 	std::array<Frame, max_frames_in_flight> frames;
-	std::mutex resources_mutex;
+	Mutex resources_mutex;
 	size_t current_frame;
+
+	/** Counters of the current frame */
+	std::array<std::atomic_uint64_t, static_cast<size_t>(DeviceCounter::Count)> counters;
+	DeviceStats last_frame_stats;
 };
 
 /** Smart handles */
@@ -1560,11 +1560,13 @@ public:
 	/**
 	 * Allocate a descriptor set from a pipeline layout
 	 * \remark Backend may use recycled descriptor sets or may use pools and therefore not perform any heap allocation.
+	 * \param out_cache_hit Set to true if a set already written with these descriptors is returned
 	 * \return Allocated descriptor set
 	 */
 	virtual ResourceHandle pipeline_layout_allocate_descriptor_set(const ResourceHandle& in_pipeline_layout,
 		const uint32_t in_set,
-		const std::vector<Descriptor>& descriptors) = 0;
+		const std::vector<Descriptor>& descriptors,
+		bool& out_cache_hit) = 0;
 
 	/** BUFFER RELATED FUNCTIONS */
 	virtual std::pair<Result, void*> buffer_map(const ResourceHandle& in_buffer) = 0;
@@ -3,5 +3,392 @@
 namespace ze::serialization
 {
 
+/**
+ * rapidjson handler that stores the parsed token
+ */
+struct JsonSaxHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonSaxHandler>
+{
+	using TokenType = JsonSaxReader::TokenType;
+
+	JsonSaxReader::Token& token;
+
+	JsonSaxHandler(JsonSaxReader::Token& in_token) : token(in_token) {}
+
+	bool Null() { token.type = TokenType::Null; return true; }
+	bool Bool(bool in_value) { token.type = TokenType::Bool; token.boolean = in_value; return true; }
+	bool Int(int in_value) { return Int64(in_value); }
+	bool Uint(unsigned in_value) { return Uint64(in_value); }
+
+	bool Int64(int64_t in_value)
+	{
+		token.type = TokenType::Int;
+		token.integer = in_value;
+		token.uinteger = static_cast<uint64_t>(in_value);
+		token.number = static_cast<double>(in_value);
+		return true;
+	}
+
+	bool Uint64(uint64_t in_value)
+	{
+		token.type = TokenType::Uint;
+		token.integer = static_cast<int64_t>(in_value);
+		token.uinteger = in_value;
+		token.number = static_cast<double>(in_value);
+		return true;
+	}
+
+	bool Double(double in_value)
+	{
+		token.type = TokenType::Double;
+		token.integer = static_cast<int64_t>(in_value);
+		token.uinteger = static_cast<uint64_t>(in_value);
+		token.number = in_value;
+		return true;
+	}
+
+	bool String(const char* in_str, rapidjson::SizeType in_length, bool)
+	{
+		token.type = TokenType::String;
+		token.string.assign(in_str, in_length);
+		return true;
+	}
+
+	bool Key(const char* in_str, rapidjson::SizeType in_length, bool)
+	{
+		token.type = TokenType::Key;
+		token.string.assign(in_str, in_length);
+		return true;
+	}
+
+	bool StartObject() { token.type = TokenType::StartObject; return true; }
+	bool EndObject(rapidjson::SizeType) { token.type = TokenType::EndObject; return true; }
+	bool StartArray() { token.type = TokenType::StartArray; return true; }
+	bool EndArray(rapidjson::SizeType) { token.type = TokenType::EndArray; return true; }
+};
+
+JsonSaxReader::JsonSaxReader(std::istream& in_stream) : stream(in_stream), has_current(false)
+{
+	reader.IterativeParseInit();
+
+	/** Enter the root object */
+	Token root = next();
+	if(root.type == TokenType::StartObject)
+		frames.emplace_back(FrameType::Object);
+	else
+		frames.emplace_back(FrameType::Missing);
+}
+
+const JsonSaxReader::Token& JsonSaxReader::peek()
+{
+	if(!has_current)
+	{
+		current = next();
+		has_current = true;
+	}
+
+	return current;
+}
+
+JsonSaxReader::Token JsonSaxReader::next()
+{
+	if(has_current)
+	{
+		has_current = false;
+		return std::move(current);
+	}
+
+	if(!replay.empty())
+	{
+		Token token = std::move(replay.front());
+		replay.pop_front();
+		return token;
+	}
+
+	Token token;
+	if(reader.IterativeParseComplete())
+	{
+		token.type = reader.HasParseError() ? TokenType::Error : TokenType::End;
+		return token;
+	}
+
+	JsonSaxHandler handler(token);
+	if(!reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(stream, handler))
+	{
+		token.type = reader.HasParseError() ? TokenType::Error : TokenType::End;
+		if(reader.HasParseError())
+			ze::logger::error("Json parse error {} at offset {}",
+				static_cast<int>(reader.GetParseErrorCode()),
+				reader.GetErrorOffset());
+	}
+
+	return token;
+}
+
+void JsonSaxReader::skip_value(std::vector<Token>* out_tokens)
+{
+	size_t depth = 0;
+	do
+	{
+		Token token = next();
+		switch(token.type)
+		{
+		case TokenType::StartObject:
+		case TokenType::StartArray:
+			depth++;
+			break;
+		case TokenType::EndObject:
+		case TokenType::EndArray:
+			if(depth == 0)
+				return;
+			depth--;
+			break;
+		case TokenType::End:
+		case TokenType::Error:
+			return;
+		default:
+			break;
+		}
+
+		if(out_tokens)
+			out_tokens->emplace_back(std::move(token));
+	} while(depth > 0);
+}
+
+void JsonSaxReader::replay_tokens(std::vector<Token>&& in_tokens)
+{
+	if(has_current)
+	{
+		replay.push_front(std::move(current));
+		has_current = false;
+	}
+
+	replay.insert(replay.begin(), std::make_move_iterator(in_tokens.begin()), 
+		std::make_move_iterator(in_tokens.end()));
+}
+
+bool JsonSaxReader::find_member(const std::string& in_name)
+{
+	Frame& frame = frames.back();
+	switch(frame.type)
+	{
+	case FrameType::Missing:
+		return false;
+	case FrameType::Array:
+	{
+		const TokenType type = peek().type;
+		return type != TokenType::EndArray && type != TokenType::End && type != TokenType::Error;
+	}
+	case FrameType::Object:
+		break;
+	}
+
+	/** The member may have been skipped while looking for a previous one */
+	if(!in_name.empty() && !frame.skipped_members.empty())
+	{
+		auto it = frame.skipped_members.find(in_name);
+		if(it != frame.skipped_members.end())
+		{
+			replay_tokens(std::move(it->second));
+			frame.skipped_members.erase(it);
+			return true;
+		}
+	}
+
+	/** Skip members until we find the requested one, keeping them in case they are requested later */
+	while(peek().type == TokenType::Key)
+	{
+		if(in_name.empty() || peek().string == in_name)
+		{
+			next();
+			return true;
+		}
+
+		Token key = next();
+		std::vector<Token> tokens;
+		skip_value(&tokens);
+		frame.skipped_members.insert_or_assign(std::move(key.string), std::move(tokens));
+	}
+
+	/** Not in the file (e.g. older file), the caller keeps its default value */
+	return false;
+}
+
+bool JsonSaxReader::read_value(const std::string& in_name, Token& out_token)
+{
+	if(!find_member(in_name))
+		return false;
+
+	out_token = next();
+	if(out_token.type == TokenType::StartObject || out_token.type == TokenType::StartArray)
+	{
+		/** Not a value, skip the whole object/array */
+		size_t depth = 1;
+		while(depth > 0)
+		{
+			Token token = next();
+			if(token.type == TokenType::StartObject || token.type == TokenType::StartArray)
+				depth++;
+			else if(token.type == TokenType::EndObject || token.type == TokenType::EndArray)
+				depth--;
+			else if(token.type == TokenType::End || token.type == TokenType::Error)
+				break;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+bool JsonSaxReader::read_int(const std::string& in_name, int64_t& out_value)
+{
+	Token token;
+	if(!read_value(in_name, token))
+		return false;
+
+	if(token.type != TokenType::Int && token.type != TokenType::Uint && token.type != TokenType::Double)
+		return false;
+
+	out_value = token.integer;
+	return true;
+}
+
+bool JsonSaxReader::read_uint(const std::string& in_name, uint64_t& out_value)
+{
+	Token token;
+	if(!read_value(in_name, token))
+		return false;
+
+	if(token.type != TokenType::Int && token.type != TokenType::Uint && token.type != TokenType::Double)
+		return false;
+
+	out_value = token.uinteger;
+	return true;
+}
+
+bool JsonSaxReader::read_double(const std::string& in_name, double& out_value)
+{
+	Token token;
+	if(!read_value(in_name, token))
+		return false;
+
+	if(token.type != TokenType::Int && token.type != TokenType::Uint && token.type != TokenType::Double)
+		return false;
+
+	out_value = token.number;
+	return true;
+}
+
+bool JsonSaxReader::read_bool(const std::string& in_name, bool& out_value)
+{
+	Token token;
+	if(!read_value(in_name, token) || token.type != TokenType::Bool)
+		return false;
+
+	out_value = token.boolean;
+	return true;
+}
+
+bool JsonSaxReader::read_string(const std::string& in_name, std::string& out_value)
+{
+	Token token;
+	if(!read_value(in_name, token) || token.type != TokenType::String)
+		return false;
+
+	out_value = std::move(token.string);
+	return true;
+}
+
+void JsonSaxReader::start_object(const std::string& in_name)
+{
+	if(!find_member(in_name))
+	{
+		frames.emplace_back(FrameType::Missing);
+		return;
+	}
+
+	switch(peek().type)
+	{
+	case TokenType::StartObject:
+		next();
+		frames.emplace_back(FrameType::Object);
+		break;
+	case TokenType::StartArray:
+		next();
+		frames.emplace_back(FrameType::Array);
+		break;
+	default:
+		skip_value();
+		frames.emplace_back(FrameType::Missing);
+		break;
+	}
+}
+
+void JsonSaxReader::end_object()
+{
+	if(frames.back().type != FrameType::Missing)
+	{
+		/** Skip what was not read */
+		while(true)
+		{
+			const TokenType type = peek().type;
+			if(type == TokenType::EndObject || type == TokenType::EndArray)
+			{
+				next();
+				break;
+			}
+			else if(type == TokenType::End || type == TokenType::Error)
+			{
+				break;
+			}
+			else if(type == TokenType::Key)
+			{
+				next();
+			}
+
+			skip_value();
+		}
+	}
+
+	frames.pop_back();
+}
+
+bool JsonSaxReader::has_next_member()
+{
+	if(frames.back().type == FrameType::Missing)
+		return false;
+
+	const TokenType type = peek().type;
+	return type != TokenType::EndObject && type != TokenType::EndArray &&
+		type != TokenType::End && type != TokenType::Error;
+}
+
+std::string JsonSaxReader::get_current_name()
+{
+	if(frames.back().type == FrameType::Object && peek().type == TokenType::Key)
+		return peek().string;
+
+	return "";
+}
+
+JsonInputArchive::JsonInputArchive(std::istream& in_stream, const JsonReadMode in_mode) : InputArchive(*this),
+	current_member_count(0)
+{
+	if(in_mode == JsonReadMode::Sequential)
+	{
+		sax_reader = std::make_unique<JsonSaxReader>(in_stream);
+	}
+	else
+	{
+		rapidjson::IStreamWrapper stream(in_stream);
+		document.ParseStream(stream);
+		if(document.IsObject())
+			it_stack.emplace_back(document.MemberBegin(), document.MemberEnd());
+		else
+			it_stack.emplace_back();
+	}
+}
+
+JsonInputArchive::~JsonInputArchive() = default;
 
-}
\ No newline at end of file
+}
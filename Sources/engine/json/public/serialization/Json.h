@@ -4,6 +4,7 @@
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
 #include <rapidjson/reader.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/istreamwrapper.h>
@@ -11,6 +12,11 @@
 #include <stack>
 #include <uuid.h>
 #include <robin_hood.h>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <string_view>
+#include <variant>
 
 namespace ze::serialization
 {
@@ -20,7 +26,113 @@ namespace ze::serialization
  */
 class JsonArchive {};
 
-class JsonInputArchive : public JsonArchive,
+/**
+ * How a JsonInputArchive reads the document
+ */
+enum class JsonReadMode
+{
+	/** Parse the whole document to a DOM, members can be read in any order */
+	Dom,
+
+	/** 
+	 * Stream the document with a SAX parser, only the current token is kept in memory
+	 * Members should be read in the order they appear, members skipped to find another one are buffered
+	 * until the end of their object so out-of-order reads still work, missing members are left untouched
+	 */
+	Sequential,
+};
+
+/**
+ * Pull parser used by sequential JsonInputArchive
+ */
+class JSON_API JsonSaxReader
+{
+public:
+	enum class TokenType
+	{
+		None,
+		Null,
+		Bool,
+		Int,
+		Uint,
+		Double,
+		String,
+		Key,
+		StartObject,
+		EndObject,
+		StartArray,
+		EndArray,
+
+		/** End of document */
+		End,
+		Error,
+	};
+
+	struct Token
+	{
+		TokenType type = TokenType::None;
+		bool boolean = false;
+		int64_t integer = 0;
+		uint64_t uinteger = 0;
+		double number = 0.0;
+		std::string string;
+	};
+
+	JsonSaxReader(std::istream& in_stream);
+
+	/** Read the value of the member in_name (or the next value if in_name is empty) */
+	bool read_int(const std::string& in_name, int64_t& out_value);
+	bool read_uint(const std::string& in_name, uint64_t& out_value);
+	bool read_double(const std::string& in_name, double& out_value);
+	bool read_bool(const std::string& in_name, bool& out_value);
+	bool read_string(const std::string& in_name, std::string& out_value);
+
+	void start_object(const std::string& in_name);
+	void end_object();
+
+	bool has_next_member();
+	std::string get_current_name();
+private:
+	enum class FrameType
+	{
+		Object,
+		Array,
+
+		/** The requested member was not found, reads are ignored until the frame ends */
+		Missing,
+	};
+
+	struct Frame
+	{
+		FrameType type;
+
+		/** Members skipped while looking for another one, replayed if they are requested later */
+		robin_hood::unordered_map<std::string, std::vector<Token>> skipped_members;
+
+		Frame(const FrameType in_type) : type(in_type) {}
+	};
+
+	const Token& peek();
+	Token next();
+
+	/** Skip the next value, storing its tokens to out_tokens if not null */
+	void skip_value(std::vector<Token>* out_tokens = nullptr);
+
+	/** Make in_tokens the next tokens returned by next() */
+	void replay_tokens(std::vector<Token>&& in_tokens);
+
+	bool find_member(const std::string& in_name);
+	bool read_value(const std::string& in_name, Token& out_token);
+private:
+	rapidjson::IStreamWrapper stream;
+	rapidjson::Reader reader;
+	Token current;
+	bool has_current;
+	std::deque<Token> replay;
+	std::vector<Frame> frames;
+};
+
+class JSON_API JsonInputArchive : public JsonArchive,
 	public InputArchive<JsonInputArchive>,
 	public traits::TextArchive
 {
@@ -38,19 +150,16 @@ public:
 			Member,
 		};
 	public:
-		Iterator(MemberIterator in_beg, MemberIterator in_end)
-			: begin(in_beg), end(in_end), index(0), type(Member)
-		{
-			if(std::distance(begin, end) == 0)
-				type = Null;
-		}
+		/** Objects with more members than this get a hashed member index on the first out-of-order lookup */
+		static constexpr size_t hashed_lookup_threshold = 8;
+
+		Iterator() : count(0), index(0), type(Null) {}
+
+		Iterator(MemberIterator in_begin, MemberIterator in_end)
+			: begin(in_begin), count(std::distance(in_begin, in_end)), index(0), type(Member) {}
 
 		Iterator(ValueIterator in_begin, ValueIterator in_end)
-			: val_begin(in_begin), index(0), type(Value)
-		{
-			if(std::distance(val_begin, in_end) == 0)
-				type = Null;
-		}
+			: val_begin(in_begin), count(std::distance(in_begin, in_end)), index(0), type(Value) {}
 
 		Iterator& operator++()
 		{
@@ -58,99 +167,197 @@ public:
 			return *this;
 		}
 
+		ZE_FORCEINLINE bool is_valid() const { return type != Null && index < count; }
+
 		void jump_to(const std::string& in_name)
 		{
-			size_t idx = 0;
-			for(auto it = begin; it != end; ++it, ++idx)
+			/** Array values have no names */
+			if(type != Member)
+				return;
+
+			const std::string_view name(in_name);
+			if(!member_index && count > hashed_lookup_threshold)
+				build_member_index();
+
+			if(member_index)
 			{
-				if(std::strncmp(in_name.c_str(), it->name.GetString(), std::strlen(in_name.c_str())) == 0)
+				auto it = member_index->find(name);
+				if(it != member_index->end())
 				{
-					index = idx;
+					index = it->second;
 					return;
 				}
 			}
+			else
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(get_member_name(i) == name)
+					{
+						index = i;
+						return;
+					}
+				}
+			}
 
 			ZE_CHECKF(false, "Can't find {}!", in_name);
+			index = count;
 		}
 
-		const rapidjson::Document::GenericValue& get_value()
+		const JsonValue& get_value() const
 		{
-			switch(type)
-			{
-			case Value:
-				return val_begin[index];
-			case Member:
-				return begin[index].value;
-			default:
-				ZE_CHECKF(false, "Null iterator!");
-				return begin[0].value; // To remove warning
-			}
+			ZE_CHECKF(is_valid(), "Invalid iterator!");
+			return type == Value ? val_begin[index] : begin[index].value;
 		}
 
 		const char* get_name() const
 		{
-			auto current_name = begin[index].name.GetString();
-
- 			if(type == Member && (begin + index) != end)
-			{
-				current_name = begin[index].name.GetString();
+			if(type == Member && index < count)
 				return begin[index].name.GetString();
-			}
 
 			return nullptr;
 		}
+	private:
+		ZE_FORCEINLINE std::string_view get_member_name(const size_t in_idx) const
+		{
+			return std::string_view(begin[in_idx].name.GetString(), begin[in_idx].name.GetStringLength());
+		}
+
+		void build_member_index()
+		{
+			member_index = std::make_unique<robin_hood::unordered_flat_map<std::string_view, size_t>>();
+			member_index->reserve(count);
+			for(size_t i = 0; i < count; ++i)
+				member_index->insert({ get_member_name(i), i });
+		}
 	private:
 		MemberIterator begin;
-		MemberIterator end;
 		ValueIterator val_begin;
+		size_t count;
 		size_t index;
 		Type type;
+		std::unique_ptr<robin_hood::unordered_flat_map<std::string_view, size_t>> member_index;
 	};
 
-	JsonInputArchive(std::istream& in_stream) : InputArchive(*this), stream(in_stream), current_member_count(0)
+	JsonInputArchive(std::istream& in_stream, const JsonReadMode in_mode = JsonReadMode::Dom);
+	~JsonInputArchive();
+
+	template<typename T>
+		requires std::is_integral_v<T> && std::is_signed_v<T>
+	void read(T& in_data)
 	{
-		document.ParseStream(stream);
-		it_stack.emplace_back(document.MemberBegin(), document.MemberEnd());
+		if(sax_reader)
+		{
+			int64_t value = 0;
+			if(sax_reader->read_int(next_name, value))
+				in_data = static_cast<T>(value);
+			next_name.clear();
+			return;
+		}
+
+		read_dom(in_data, [](const JsonValue& in_value) { return static_cast<T>(in_value.GetInt64()); });
 	}
 
-	~JsonInputArchive()
+	template<typename T>
+		requires std::is_integral_v<T> && std::is_unsigned_v<T> && (!std::is_same_v<T, bool>)
+	void read(T& in_data)
 	{
+		if(sax_reader)
+		{
+			uint64_t value = 0;
+			if(sax_reader->read_uint(next_name, value))
+				in_data = static_cast<T>(value);
+			next_name.clear();
+			return;
+		}
+
+		read_dom(in_data, [](const JsonValue& in_value) { return static_cast<T>(in_value.GetUint64()); });
 	}
 
 	template<typename T>
-		requires (std::is_same_v<T, long> && !std::is_same_v<T, int> && !std::is_same_v<T, int64_t>)
-	void read(T& in_data) { jump_to(); in_data = it_stack.back().get_value().GetUint64(in_data); ++it_stack.back(); }
+		requires std::is_floating_point_v<T>
+	void read(T& in_data)
+	{
+		if(sax_reader)
+		{
+			double value = 0.0;
+			if(sax_reader->read_double(next_name, value))
+				in_data = static_cast<T>(value);
+			next_name.clear();
+			return;
+		}
 
-	template<typename T>
-		requires (std::is_same_v<T, unsigned long> && !std::is_same_v<T, unsigned int> && !std::is_same_v<T, uint64_t>)
-	void read(int64_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetInt64(); ++it_stack.back(); }
-
-	void read(int8_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetInt(); ++it_stack.back(); }
-	void read(int16_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetInt(); ++it_stack.back(); }
-	void read(int32_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetInt(); ++it_stack.back(); }
-	void read(uint8_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetUint(); ++it_stack.back(); }
-	void read(uint16_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetUint(); ++it_stack.back(); }
-	void read(uint32_t& in_data) { jump_to(); in_data = it_stack.back().get_value().GetUint(); ++it_stack.back(); }
-	void read(std::string& in_data) { jump_to(); in_data = it_stack.back().get_value().GetString(); ++it_stack.back(); }
-	void read(bool& in_data) { jump_to(); in_data = it_stack.back().get_value().GetBool(); ++it_stack.back(); }
+		read_dom(in_data, [](const JsonValue& in_value) { return static_cast<T>(in_value.GetDouble()); });
+	}
+
+	void read(std::string& in_data)
+	{
+		if(sax_reader)
+		{
+			sax_reader->read_string(next_name, in_data);
+			next_name.clear();
+			return;
+		}
+
+		read_dom(in_data, [](const JsonValue& in_value) { return std::string(in_value.GetString(), in_value.GetStringLength()); });
+	}
+
+	void read(bool& in_data)
+	{
+		if(sax_reader)
+		{
+			sax_reader->read_bool(next_name, in_data);
+			next_name.clear();
+			return;
+		}
+
+		read_dom(in_data, [](const JsonValue& in_value) { return in_value.GetBool(); });
+	}
 
 	void start_object()
 	{
+		if(sax_reader)
+		{
+			sax_reader->start_object(next_name);
+			next_name.clear();
+			return;
+		}
+
 		jump_to();
 
-		if(it_stack.back().get_value().IsArray())
+		if(!it_stack.back().is_valid())
+		{
+			current_member_count = 0;
+			it_stack.emplace_back();
+			return;
+		}
+
+		const JsonValue& value = it_stack.back().get_value();
+		if(value.IsArray())
 		{
-			it_stack.emplace_back(it_stack.back().get_value().Begin(), it_stack.back().get_value().End());
+			current_member_count = value.Size();
+			it_stack.emplace_back(value.Begin(), value.End());
+		}
+		else if(value.IsObject())
+		{
+			current_member_count = value.MemberCount();
+			it_stack.emplace_back(value.MemberBegin(), value.MemberEnd());
 		}
 		else
 		{
-			current_member_count = it_stack.back().get_value().MemberCount();
-			it_stack.emplace_back(it_stack.back().get_value().MemberBegin(), it_stack.back().get_value().MemberEnd());
+			current_member_count = 0;
+			it_stack.emplace_back();
 		}
 	}
 	
 	void end_object()
 	{
+		if(sax_reader)
+		{
+			sax_reader->end_object();
+			return;
+		}
+
 		current_member_count = 0;
 		it_stack.pop_back();
 		++it_stack.back();
@@ -161,9 +368,34 @@ public:
 		next_name = in_next_name;
 	}
 
+	/** Are there members/values left in the current object/array */
+	[[nodiscard]] bool has_next_member() 
+	{ 
+		return sax_reader ? sax_reader->has_next_member() : it_stack.back().is_valid(); 
+	}
+
+	/** Member count of the current object (DOM mode only) */
 	[[nodiscard]] const size_t get_current_member_count() const { return current_member_count; }
-	[[nodiscard]] std::string get_current_name() const { return it_stack.back().get_name(); }
+
+	[[nodiscard]] std::string get_current_name() const 
+	{
+		if(sax_reader)
+			return sax_reader->get_current_name();
+
+		const char* name = it_stack.back().get_name();
+		return name ? name : "";
+	}
 private:
+	template<typename T, typename Getter>
+	ZE_FORCEINLINE void read_dom(T& in_data, Getter&& in_getter)
+	{
+		jump_to();
+		Iterator& it = it_stack.back();
+		if(it.is_valid())
+			in_data = in_getter(it.get_value());
+		++it;
+	}
+
 	void jump_to()
 	{
 		if(!next_name.empty())
@@ -174,18 +406,17 @@ private:
 				it_stack.back().jump_to(next_name);
 		}
 
-		next_name = "";
+		next_name.clear();
 	}
 private:
 	std::vector<Iterator> it_stack;
 	std::string next_name;
-	rapidjson::IStreamWrapper stream;
 	rapidjson::Document document;
+	std::unique_ptr<JsonSaxReader> sax_reader;
 	size_t current_member_count;
-	std::string current_name;
 };
 
-class JsonOutputArchive : public JsonArchive,
+class JSON_API JsonOutputArchive : public JsonArchive,
 	public OutputArchive<JsonOutputArchive>,
 	public traits::TextArchive
 {
@@ -202,9 +433,20 @@ public:
 		InsideObject
 	};
 
-	JsonOutputArchive(std::ostream& in_stream) : OutputArchive(*this), stream(in_stream), writer(stream)
+	using CompactWriter = rapidjson::Writer<rapidjson::OStreamWrapper>;
+	using PrettyWriter = rapidjson::PrettyWriter<rapidjson::OStreamWrapper>;
+
+	/**
+	 * \param in_pretty Indent the output. When false, a compact writer is used
+	 */
+	JsonOutputArchive(std::ostream& in_stream, const bool in_pretty = true) : OutputArchive(*this), stream(in_stream)
 	{
-		writer.StartObject();
+		if(in_pretty)
+			writer.emplace<PrettyWriter>(stream);
+		else
+			writer.emplace<CompactWriter>(stream);
+
+		with_writer([](auto& in_writer) { in_writer.StartObject(); });
 		object_stack.push(ObjectType::Root);
 		object_stack.push(ObjectType::None);
 		name_counter.push(0);
@@ -213,23 +455,31 @@ public:
 	~JsonOutputArchive()
 	{
 		end_object();
-		writer.EndObject();
+		with_writer([](auto& in_writer) { in_writer.EndObject(); });
 	}
 
 	template<typename T>
-		requires (std::is_same_v<T, long> && !std::is_same_v<T, int> && !std::is_same_v<T, int64_t>)
-	void write(T in_data) { writer.Uint64(in_data); }
-	
+		requires std::is_integral_v<T> && std::is_signed_v<T>
+	void write(const T in_data) { with_writer([in_data](auto& in_writer) { in_writer.Int64(in_data); }); }
+
 	template<typename T>
-		requires (std::is_same_v<T, unsigned long> && !std::is_same_v<T, unsigned int> && !std::is_same_v<T, uint64_t>)
-	void write(int64_t in_data) { writer.Int64(in_data); }
+		requires std::is_integral_v<T> && std::is_unsigned_v<T> && (!std::is_same_v<T, bool>)
+	void write(const T in_data) { with_writer([in_data](auto& in_writer) { in_writer.Uint64(in_data); }); }
 
-	void write(int in_data) { writer.Int(in_data); }
-	void write(unsigned int in_data) { writer.Uint(in_data); }
-	void write(const std::string& in_data) { writer.String(in_data.c_str()); }
-	void write(bool in_bool) { writer.Bool(in_bool); }
+	template<typename T>
+		requires std::is_floating_point_v<T>
+	void write(const T in_data) { with_writer([in_data](auto& in_writer) { in_writer.Double(in_data); }); }
 
-	auto& get_writer() { return writer; }
+	void write(const std::string& in_data) 
+	{ 
+		with_writer([&in_data](auto& in_writer) { in_writer.String(in_data.c_str(), static_cast<rapidjson::SizeType>(in_data.size())); }); 
+	}
+
+	void write(const bool in_bool) { with_writer([in_bool](auto& in_writer) { in_writer.Bool(in_bool); }); }
+
+	/** Call in_func with the underlying rapidjson writer */
+	template<typename Func>
+	ZE_FORCEINLINE void with_writer(Func&& in_func) { std::visit(std::forward<Func>(in_func), writer); }
 
 	/** Json manip */
 	void set_next_name(const std::string& in_name) { next_name = in_name; }
@@ -250,11 +500,11 @@ public:
 	{
 		if(object_stack.top() == ObjectType::InsideArray)
 		{
-			writer.EndArray();
+			with_writer([](auto& in_writer) { in_writer.EndArray(); });
 		}
 		else if(object_stack.top() == ObjectType::InsideObject || object_stack.top() == ObjectType::Root)
 		{
-			writer.EndObject();
+			with_writer([](auto& in_writer) { in_writer.EndObject(); });
 		}
 		object_stack.pop();
 		name_counter.pop();
@@ -271,12 +521,12 @@ public:
 		{
 			if(object == ObjectType::Object)
 			{
-				writer.StartObject();
+				with_writer([](auto& in_writer) { in_writer.StartObject(); });
 				object = ObjectType::InsideObject;
 			}
 			else if(object == ObjectType::Array)
 			{
-				writer.StartArray();
+				with_writer([](auto& in_writer) { in_writer.StartArray(); });
 				object = ObjectType::InsideArray;
 			}
 		}
@@ -299,7 +549,7 @@ private:
 	std::stack<uint32_t> name_counter;
 	std::string next_name;
 	rapidjson::OStreamWrapper stream;
-	rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer;
+	std::variant<CompactWriter, PrettyWriter> writer;
 };
 
 /**
@@ -478,8 +728,7 @@ inline void post_serialize(JsonOutputArchive& archive, const std::pair<T1, T2>&
 template<typename T1, typename T2>
 inline void serialize(JsonInputArchive& archive, robin_hood::unordered_map<T1, T2>& data)
 {
-
-	for(int i = 0; i < archive.get_current_member_count(); ++i)
+	while(archive.has_next_member())
 	{
 		std::pair<T1, T2> pair;
 		auto name = archive.get_current_name();
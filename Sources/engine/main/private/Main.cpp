@@ -2,6 +2,7 @@
 #include "EngineCore.h"
 #include "logger/Logger.h"
 #include "logger/sinks/StdSink.h"
+#include "logger/BinaryLog.h"
 #include <SDL.h>
 #include "engine/Engine.h"
 #include <chrono>
@@ -16,6 +17,7 @@
 #include "logger/sinks/WinDbgSink.h"
 #include "zefs/sinks/FileSink.h"
 #include "zefs/ZEFS.h"
+#include "zefs/AsyncIO.h"
 #if ZE_PLATFORM(WINDOWS)
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -132,7 +134,17 @@ void PreInit()
             std::filesystem::create_directories("Logs/");
 
             ze::logger::add_sink(std::make_unique<FS::FileSink>("File", "Logs/Latest.log"));
+
+            /** High frequency diagnostics (ZE_LOG_BINARY), decoded with ZELog, the file is only created when used */
+            ze::logger::binary::open_on_first_use([]()
+            {
+                return std::unique_ptr<std::streambuf>(FS::write("Logs/Latest.zblog",
+                    FS::FileWriteFlagBits::Binary | FS::FileWriteFlagBits::ReplaceExisting));
+            });
         }
+        /** Sinks are called from the logger thread from now on */
+        ze::logger::start_async();
+
         ze::logger::info("=== ZinoEngine {} Build ===", ZE_CONFIGURATION_NAME);
 
 #ifdef ZE_DEBUG
@@ -176,6 +188,14 @@ void PreInit()
         LoadRequiredModule("shadercompiler");
         LoadRequiredModule("effect");
         LoadRequiredModule("imgui");
+
+        /** Apply user convars once all modules registered theirs */
+        if(FS::MappedRegion config = FS::map("Config/Engine.cfg"))
+        {
+            const size_t count = ze::CConsole::Get().apply_config(std::string_view(
+                reinterpret_cast<const char*>(config.get_data()), config.get_size()));
+            ze::logger::info("Applied {} convars from Config/Engine.cfg", count);
+        }
     }
 
     /** INITIALIZE RENDER SYSTEM **/
@@ -226,6 +246,9 @@ void Exit()
     /** Delete engine */
     engine_app.reset();
 
+    /** Drain the reads in flight while the job system and the render device can still run their callbacks */
+    ze::filesystem::asyncio::shutdown();
+
     ze::module::unload_module("effect");
 
     ze::gfx::Device::get().destroy();
@@ -238,6 +261,10 @@ void Exit()
 
     ze::reflection::serialization::free_archive_map();
 
+    /** Sinks may live in modules being unloaded */
+    ze::logger::stop_async();
+    ze::logger::binary::close();
+
     /** Clear all modules */
     ze::module::unload_modules();
 
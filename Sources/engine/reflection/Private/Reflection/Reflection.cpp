@@ -12,30 +12,33 @@ namespace ze::reflection
 
 ZE_REFL_BUILDER_FUNC(Reflection_Primitives)
 {
-	builders::TypeBuilder<bool>();
-	builders::TypeBuilder<float>();
-	builders::TypeBuilder<double>();
-
-	builders::TypeBuilder<uint8_t>();
-	builders::TypeBuilder<uint16_t>();
-	builders::TypeBuilder<uint32_t>();
-	builders::TypeBuilder<uint64_t>();
-
-	builders::TypeBuilder<int8_t>();
-	builders::TypeBuilder<int16_t>();
-	builders::TypeBuilder<int32_t>();
-	builders::TypeBuilder<int64_t>();
-
-	builders::ClassBuilder<ze::maths::Vector3f>();
-	builders::ClassBuilder<ze::maths::Vector3d>();
+	/** Sorted by name */
+	static constexpr TypeDescriptor types[] =
+	{
+		{ "bool", &builders::build_type<bool> },
+		{ "double", &builders::build_type<double> },
+		{ "float", &builders::build_type<float> },
+		{ "int16_t", &builders::build_type<int16_t> },
+		{ "int32_t", &builders::build_type<int32_t> },
+		{ "int64_t", &builders::build_type<int64_t> },
+		{ "int8_t", &builders::build_type<int8_t> },
+		{ "uint16_t", &builders::build_type<uint16_t> },
+		{ "uint32_t", &builders::build_type<uint32_t> },
+		{ "uint64_t", &builders::build_type<uint64_t> },
+		{ "uint8_t", &builders::build_type<uint8_t> },
+		{ "ze::maths::Vector3d", &builders::build_class<ze::maths::Vector3d> },
+		{ "ze::maths::Vector3f", &builders::build_class<ze::maths::Vector3f> },
+	};
+
+	RegistrationManager::get().register_table(types);
 }
 
 namespace serialization
 {
 
-robin_hood::unordered_map<std::string, robin_hood::unordered_map<std::string, std::function<void(void*, void*)>>> archive_map;
+robin_hood::unordered_map<std::string, robin_hood::unordered_map<std::string, ArchiveSerializeFunc>> archive_map;
 
-robin_hood::unordered_map<std::string, std::function<void(void*, void*)>>& get_archive_map(const char* in_archive)
+robin_hood::unordered_map<std::string, ArchiveSerializeFunc>& get_archive_map(const char* in_archive)
 {
 	return archive_map[in_archive];
 }
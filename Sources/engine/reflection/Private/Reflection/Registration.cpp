@@ -1,10 +1,12 @@
 #include "reflection/Registration.h"
 #include "reflection/Type.h"
+#include <algorithm>
+#include <cstring>
 
 namespace ze::reflection
 {
 
-RegistrationManager::RegistrationManager()
+RegistrationManager::RegistrationManager() : built_tables(0)
 {
 	register_registration_mgr(this);
 }
@@ -16,8 +18,13 @@ RegistrationManager::~RegistrationManager()
 
 const Type* RegistrationManager::register_type(OwnerPtr<Type> in_type)
 {
+	std::scoped_lock lock(mutex);
+
 	types.emplace_back(in_type);
-	type_name_to_ptr.insert({ types.back()->get_name(), types.back().get() });
+	{
+		std::unique_lock map_lock(map_mutex);
+		type_name_to_ptr.insert({ types.back()->get_name(), types.back().get() });
+	}
 
 	if(types.back()->is_class())
 		classes.emplace_back(static_cast<const Class*>(types.back().get()));
@@ -25,15 +32,100 @@ const Type* RegistrationManager::register_type(OwnerPtr<Type> in_type)
 	return types.back().get();
 }
 
-const Type* RegistrationManager::get_type(const std::string& in_name) const
+void RegistrationManager::register_table(const TypeTable& in_table)
+{
+	ZE_CHECK(std::is_sorted(in_table.begin(), in_table.end(), 
+		[](const TypeDescriptor& left, const TypeDescriptor& right)
+		{
+			return strcmp(left.name, right.name) < 0;
+		}));
+
+	std::scoped_lock lock(mutex);
+	tables.emplace_back(in_table);
+}
+
+const Type* RegistrationManager::find_built_type(const std::string& in_name)
 {
+	std::shared_lock map_lock(map_mutex);
 	auto type = type_name_to_ptr.find(in_name);
-	if(type != type_name_to_ptr.end())
-		return type->second;
+	return type != type_name_to_ptr.end() ? type->second : nullptr;
+}
+
+const Type* RegistrationManager::get_type(const std::string& in_name)
+{
+	if(const Type* type = find_built_type(in_name))
+		return type;
+
+	std::scoped_lock lock(mutex);
+
+	/** May have been built by another thread while waiting */
+	if(const Type* type = find_built_type(in_name))
+		return type;
+
+	/**
+	 * Not built yet, the descriptor build function will call register_type
+	 * before resolving any other type so recursive lookups are safe
+	 */
+	if(const TypeDescriptor* descriptor = find_descriptor(in_name))
+	{
+		descriptor->build(*this, *descriptor);
+		return find_built_type(in_name);
+	}
+
+	return nullptr;
+}
+
+const TypeDescriptor* RegistrationManager::find_descriptor(const std::string& in_name) const
+{
+	for(const auto& table : tables)
+	{
+		auto it = std::lower_bound(table.begin(), table.end(), in_name,
+			[](const TypeDescriptor& left, const std::string& right)
+			{
+				return left.name < std::string_view(right);
+			});
+
+		if(it != table.end() && in_name == it->name)
+			return &*it;
+	}
 
 	return nullptr;
 }
 
+void RegistrationManager::build_all_types()
+{
+	std::scoped_lock lock(mutex);
+
+	for(; built_tables < tables.size(); ++built_tables)
+	{
+		for(const auto& descriptor : tables[built_tables])
+		{
+			if(!find_built_type(descriptor.name))
+				descriptor.build(*this, descriptor);
+		}
+	}
+}
+
+std::vector<const Type*> RegistrationManager::get_types()
+{
+	std::scoped_lock lock(mutex);
+	build_all_types();
+
+	std::vector<const Type*> out_types;
+	out_types.reserve(types.size());
+	for(const auto& type : types)
+		out_types.emplace_back(type.get());
+
+	return out_types;
+}
+
+std::vector<const Class*> RegistrationManager::get_classes()
+{
+	std::scoped_lock lock(mutex);
+	build_all_types();
+	return classes;
+}
+
 std::vector<RegistrationManager*> reg_mgrs;
 
 void register_registration_mgr(RegistrationManager* in_mgr)
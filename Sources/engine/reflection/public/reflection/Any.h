@@ -42,7 +42,7 @@ public:
 	template<typename ArchiveType>
 	ZE_FORCEINLINE void serialize(ArchiveType& in_archive)
 	{
-		std::tuple<const char*, void*, detail::AnyDataType&> tuple = { serialization::ArchiveName<ArchiveType>, &in_archive, data };
+		std::tuple<const char*, void*, detail::AnyDataType&> tuple = { serialization::archive_name<ArchiveType>, &in_archive, data };
 		visit_func(detail::VisitType::Serialize, 
 			*reinterpret_cast<detail::AnyDataType*>(&tuple));
 	}
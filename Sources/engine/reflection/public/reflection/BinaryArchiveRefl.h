@@ -2,6 +2,9 @@
 
 #include "Serialization.h"
 #include "serialization/BinaryArchive.h"
+#include "serialization/MemoryArchive.h"
 
 ZE_REFL_REGISTER_ARCHIVE(ze::serialization::BinaryInputArchive);
-ZE_REFL_REGISTER_ARCHIVE(ze::serialization::BinaryOutputArchive);
\ No newline at end of file
+ZE_REFL_REGISTER_ARCHIVE(ze::serialization::BinaryOutputArchive);
+ZE_REFL_REGISTER_ARCHIVE(ze::serialization::MemoryInputArchive);
+ZE_REFL_REGISTER_ARCHIVE(ze::serialization::MemoryOutputArchive);
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Class.h"
 #include "Enum.h"
 #include "Registration.h"
+#include "TypeTable.h"
 #include <type_traits>
 #include "reflection/detail/PropertyImpl.h"
 
@@ -28,7 +29,7 @@ namespace ze::reflection::builders
 template<typename T, typename U = Type>
 struct TypeBuilder
 {
-	TypeBuilder() 
+	TypeBuilder(RegistrationManager& in_manager = RegistrationManager::get()) 
 	{
 		TypeFlags flags;
 
@@ -42,19 +43,41 @@ struct TypeBuilder
 		if constexpr(is_refl_enum<T>)
 			flags |= TypeFlagBits::Enum; 
 
-		type = RegistrationManager::get().register_type(new U(type_name<T>, sizeof(T), flags));
+		type = in_manager.register_type(new U(type_name<T>, sizeof(T), flags));
 	}
 
 	const Type* type;
 };
 
+template<typename PropType>
+void emplace_property(std::vector<Property>& in_properties, const std::string& in_name,
+	const size_t in_offset, const robin_hood::unordered_map<std::string, std::string>& in_metadatas)
+{
+	in_properties.emplace_back(in_name, type_name<PropType>, in_offset, in_metadatas);
+
+	auto& property_impl = const_cast<std::unique_ptr<detail::PropertyImplBase>&>(in_properties.back().get_impl());
+	property_impl = std::make_unique<detail::PropertyImplMember<PropType>>(in_properties.back().get_offset());
+}
+
+template<typename T, typename... Args>
+void add_constructor(const Class* in_class)
+{
+	if constexpr(!std::is_abstract_v<T>)
+	{
+		std::vector<ze::reflection::Constructor>& constructors = 
+			const_cast<std::vector<ze::reflection::Constructor>&>(in_class->get_constructors());
+		constructors.push_back(ze::reflection::Constructor::make_constructor<T, Args...>());
+	}
+}
+
 /**
  * Builder for registering and building a struct/class
  */
 template<typename T>
 struct ClassBuilder : public TypeBuilder<T, Class>
 {
-	ClassBuilder(ClassFlags in_flags = ClassFlags()) : TypeBuilder<T, Class>() 
+	ClassBuilder(ClassFlags in_flags = ClassFlags(), 
+		RegistrationManager& in_manager = RegistrationManager::get()) : TypeBuilder<T, Class>(in_manager) 
 	{
 		class_ = static_cast<const Class*>(this->type);
 
@@ -106,25 +129,16 @@ struct ClassBuilder : public TypeBuilder<T, Class>
 	{
 		std::vector<ze::reflection::Property>& properties = 
 			const_cast<std::vector<ze::reflection::Property>&>(class_->get_properties());
-		properties.emplace_back(in_name, type_name<PropType>, 
+		emplace_property<PropType>(properties, in_name, 
 			(char*)&((T*)nullptr->*in_ptr) - (char*)nullptr, in_metadatas);
 
-		auto& property_impl = const_cast<std::unique_ptr<detail::PropertyImplBase>&>(properties.back().get_impl());
-		property_impl = std::make_unique<detail::PropertyImplMember<PropType>>(properties.back().get_offset());
-
 		return *this;
 	}
 
 	template<typename... Args>
 	ClassBuilder& constructor()
 	{
-		if constexpr(!std::is_abstract_v<T>)
-		{
-			std::vector<ze::reflection::Constructor>& constructors = 
-				const_cast<std::vector<ze::reflection::Constructor>&>(class_->get_constructors());
-			constructors.push_back(ze::reflection::Constructor::make_constructor<T, Args...>());
-		}
-		
+		add_constructor<T, Args...>(class_);
 		return *this;
 	}
 
@@ -137,8 +151,8 @@ struct EnumBuilder : public TypeBuilder<T, Enum>
 public:
     using UnderlyingType = typename std::underlying_type<T>::type;
 
-    EnumBuilder() : 
-		TypeBuilder<T, Enum>()
+    EnumBuilder(RegistrationManager& in_manager = RegistrationManager::get()) : 
+		TypeBuilder<T, Enum>(in_manager)
     {
         enum_ = static_cast<const Enum*>(this->type);
 
@@ -161,4 +175,78 @@ public:
 	const Enum* enum_;
 };
 
+/**
+ * Build functions referenced by TypeDescriptor/PropertyDescriptor tables
+ */
+template<typename T, typename PropType, auto Member>
+void build_property(std::vector<Property>& in_properties, const PropertyDescriptor& in_desc)
+{
+	robin_hood::unordered_map<std::string, std::string> metadatas;
+	metadatas.reserve(in_desc.metadatas.size());
+	for(const auto& metadata : in_desc.metadatas)
+		metadatas.insert({ metadata.key, metadata.value });
+
+	emplace_property<PropType>(in_properties, in_desc.name, 
+		(char*)&((T*)nullptr->*Member) - (char*)nullptr, metadatas);
+}
+
+/**
+ * Name of the last reflected parent (non-reflected parents are ignored)
+ */
+template<typename... Parents>
+constexpr const char* parent_name()
+{
+	const char* name = nullptr;
+	([&]()
+	{
+		if constexpr(is_refl_type<Parents>)
+			name = type_name<Parents>;
+	}(), ...);
+	return name;
+}
+
+template<typename T>
+void build_type(RegistrationManager& in_manager, const TypeDescriptor& in_desc)
+{
+	TypeBuilder<T>{ in_manager };
+}
+
+template<typename T>
+void build_class(RegistrationManager& in_manager, const TypeDescriptor& in_desc)
+{
+	ClassBuilder<T> builder(ClassFlags(), in_manager);
+
+	if(in_desc.constructors.empty())
+		builder.template constructor<>();
+
+	for(const auto& constructor : in_desc.constructors)
+		constructor(builder.class_);
+
+	if(in_desc.parent)
+		builder.parent(in_desc.parent);
+
+	std::vector<ze::reflection::Property>& properties = 
+		const_cast<std::vector<ze::reflection::Property>&>(builder.class_->get_properties());
+	properties.reserve(in_desc.properties.size());
+	for(const auto& property : in_desc.properties)
+		property.build(properties, property);
+
+#if ZE_WITH_EDITOR
+	if(in_desc.documentation)
+		builder.documentation(in_desc.documentation);
+#endif
+}
+
+template<typename T>
+void build_enum(RegistrationManager& in_manager, const TypeDescriptor& in_desc)
+{
+	EnumBuilder<T> builder(in_manager);
+
+	auto& values = 
+		const_cast<std::vector<std::pair<std::string, Any>>&>(builder.enum_->get_values());
+	values.reserve(in_desc.values.size());
+	for(const auto& value : in_desc.values)
+		builder.value(value.name, static_cast<T>(value.value));
+}
+
 }
\ No newline at end of file
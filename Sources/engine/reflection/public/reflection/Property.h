@@ -48,7 +48,7 @@ public:
 	{
 		reflection::Any value = get_value(instance);
 		value.serialize(in_archive);
-		if constexpr(ze::serialization::IsInputArchive<ArchiveType>)
+		if constexpr(ze::serialization::is_input_archive<ArchiveType>)
 		{
 			memmove(get_value_ptr(instance), 
 				value.get_value_ptr(), type.get()->get_size());
@@ -2,7 +2,10 @@
 
 #include "EngineCore.h"
 #include "Macros.h"
+#include "TypeTable.h"
 #include <robin_hood.h>
+#include <mutex>
+#include <shared_mutex>
 
 namespace ze::reflection
 {
@@ -12,7 +15,7 @@ class Class;
 
 /**
  * Registration manager singleton
- * Store types
+ * Store types, built lazily from the type tables registered by ZERT generated code
  * WARNING: Only one per module on modular builds, RegistrationManager::get() 
  *	will return the RegistrationManager for the current module
  */
@@ -25,9 +28,16 @@ public:
 	const Type* register_type(OwnerPtr<Type> in_type);
 
 	/**
-	 * Tries to get the specified type
+	 * Register a table of type descriptors (must be sorted by name and have static storage)
+	 * Types are only built when first requested
 	 */
-	const Type* get_type(const std::string& in_name) const;
+	void register_table(const TypeTable& in_table);
+
+	/**
+	 * Tries to get the specified type, building it from its descriptor if required
+	 * Lookups of built types only take a shared lock
+	 */
+	const Type* get_type(const std::string& in_name);
 
 	/**
 	 * Get the registration manager for the specified module (on modular builds)
@@ -41,12 +51,27 @@ public:
 	RegistrationManager(const RegistrationManager&) = delete;
 	void operator=(const RegistrationManager&) = delete;
 
-	const auto& get_types() const { return types; }
-	const auto& get_classes() const { return classes; }
+	/**
+	 * Get all types/classes, this will build every type still pending
+	 * Returns a copy as types can be built lazily by other threads while iterating
+	 */
+	std::vector<const Type*> get_types();
+	std::vector<const Class*> get_classes();
 private:
 	RegistrationManager();
 	~RegistrationManager();
+
+	const TypeDescriptor* find_descriptor(const std::string& in_name) const;
+	const Type* find_built_type(const std::string& in_name);
+	void build_all_types();
 private:
+	/** Held while registering and building types, build functions recursively look up types */
+	std::recursive_mutex mutex;
+
+	/** Protects type_name_to_ptr, exclusively locked only to insert */
+	std::shared_mutex map_mutex;
+	std::vector<TypeTable> tables;
+	size_t built_tables;
 	std::vector<std::unique_ptr<Type>> types;
 	std::vector<const Class*> classes;
 	robin_hood::unordered_map<std::string, const Type*> type_name_to_ptr;
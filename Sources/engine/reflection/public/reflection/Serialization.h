@@ -13,10 +13,13 @@ static constexpr const char* archive_name = "";
 template<typename T>
 static constexpr bool is_serializable_with_reflection = false;
 
+/** Serialize function stored in archive maps (archive, object) */
+using ArchiveSerializeFunc = void(*)(void*, void*);
+
 /**
  * Get the binding map for the specified archive
  */
-REFLECTION_API robin_hood::unordered_map<std::string, std::function<void(void*, void*)>>& get_archive_map(const char* in_archive);
+REFLECTION_API robin_hood::unordered_map<std::string, ArchiveSerializeFunc>& get_archive_map(const char* in_archive);
 void free_archive_map();
 
 /**
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <span>
+#include <vector>
+
+namespace ze::reflection
+{
+
+class RegistrationManager;
+class Class;
+class Property;
+struct TypeDescriptor;
+
+/**
+ * Read-only type descriptors
+ * ZERT emits them as constexpr tables (one per generated file) that are handed to the
+ * RegistrationManager with a single pointer. The actual Type objects are only built
+ * the first time they are requested.
+ */
+
+struct PropertyMetadataDescriptor
+{
+	const char* key;
+	const char* value;
+};
+
+struct PropertyDescriptor
+{
+	using BuildFunc = void(*)(std::vector<Property>&, const PropertyDescriptor&);
+
+	const char* name;
+	std::span<const PropertyMetadataDescriptor> metadatas;
+	BuildFunc build;
+};
+
+using ConstructorDescriptor = void(*)(const Class*);
+
+struct EnumValueDescriptor
+{
+	const char* name;
+
+	/** Value casted to uint64_t, casted back to the enum underlying type when built */
+	uint64_t value;
+};
+
+struct TypeDescriptor
+{
+	using BuildFunc = void(*)(RegistrationManager&, const TypeDescriptor&);
+
+	/** Full type name, tables must be sorted by this */
+	const char* name;
+	BuildFunc build;
+
+	/** Class-only data */
+	const char* parent = nullptr;
+	std::span<const ConstructorDescriptor> constructors = {};
+	std::span<const PropertyDescriptor> properties = {};
+	const char* documentation = nullptr;
+
+	/** Enum-only data */
+	std::span<const EnumValueDescriptor> values = {};
+};
+
+using TypeTable = std::span<const TypeDescriptor>;
+
+/** Documentation strings are only kept on editor builds */
+#if ZE_WITH_EDITOR
+#define ZE_REFL_DOCUMENTATION(Doc) Doc
+#else
+#define ZE_REFL_DOCUMENTATION(Doc) nullptr
+#endif
+
+}
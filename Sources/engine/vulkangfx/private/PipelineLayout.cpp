@@ -41,12 +41,13 @@ void VulkanBackend::pipeline_layout_destroy(const ResourceHandle& in_handle)
 
 ResourceHandle VulkanBackend::pipeline_layout_allocate_descriptor_set(const ResourceHandle& in_pipeline_layout,
 	const uint32_t in_set,
-	const std::vector<Descriptor>& descriptors)
+	const std::vector<Descriptor>& descriptors,
+	bool& out_cache_hit)
 {
 	PipelineLayout* layout = PipelineLayout::get(in_pipeline_layout);
 	ZE_CHECKF(layout, "Invalid pipeline layout given to pipeline_layout_allocate_descriptor_set");
 
-	return layout->allocate_set(in_set, descriptors);
+	return layout->allocate_set(in_set, descriptors, out_cache_hit);
 }
 
 PipelineLayout::PipelineLayout(Device& in_device, 
@@ -162,7 +163,8 @@ void PipelineLayout::allocate_pool()
 	descriptor_pools.emplace_back(std::move(handle));
 }
 
-ResourceHandle PipelineLayout::allocate_set(const uint32_t in_set, const std::vector<Descriptor>& in_descriptors)
+ResourceHandle PipelineLayout::allocate_set(const uint32_t in_set, const std::vector<Descriptor>& in_descriptors,
+	bool& out_cache_hit)
 {
 	ResourceHandle handle;
 
@@ -171,7 +173,8 @@ ResourceHandle PipelineLayout::allocate_set(const uint32_t in_set, const std::ve
 		hash_combine(hash, desc);
 
 	auto it = descriptor_sets[in_set].find(hash);
-	if(it != descriptor_sets[in_set].end())
+	out_cache_hit = it != descriptor_sets[in_set].end();
+	if(out_cache_hit)
 		return it->second.get_set();
 
 	/** Search for set to recycle */
@@ -44,8 +44,10 @@ public:
 	/**
 	 * Will allocate a set matching this pipeline layout
 	 * This function may recycle an already allocated descriptor set
+	 * \param out_cache_hit Set to true if a set already written with these descriptors is returned
 	 */
-	ResourceHandle allocate_set(const uint32_t in_set, const std::vector<Descriptor>& in_descriptors);
+	ResourceHandle allocate_set(const uint32_t in_set, const std::vector<Descriptor>& in_descriptors,
+		bool& out_cache_hit);
 	void free_set(const uint32_t in_set_idx, const ResourceHandle& in_set);
 
 	static PipelineLayout* get(const ResourceHandle& in_handle);
@@ -52,7 +52,8 @@ public:
 
 	ResourceHandle pipeline_layout_allocate_descriptor_set(const ResourceHandle& in_pipeline_layout,
 		const uint32_t in_set,
-		const std::vector<Descriptor>& descriptors) override;
+		const std::vector<Descriptor>& descriptors,
+		bool& out_cache_hit) override;
 
 	/** Buffer */
 	std::pair<Result, void*> buffer_map(const ResourceHandle& in_buffer) override;
@@ -0,0 +1,640 @@
+#include "zefs/AsyncIO.h"
+#include "zefs/ZEFS.h"
+#include "threading/jobsystem/Async.h"
+#include "threading/Thread.h"
+#include <robin_hood.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <thread>
+#if ZE_PLATFORM(LINUX)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ze::filesystem::asyncio
+{
+
+ReadBatch::ReadBatch(std::vector<ReadRequest>&& in_requests, OnCompleted&& in_on_completed) :
+	requests(std::move(in_requests)), on_completed(std::move(in_on_completed)), pending(requests.size()),
+	completed(false), failed(false) {}
+
+void ReadBatch::wait() const
+{
+	std::unique_lock lock(mutex);
+	condition_var.wait(lock, [this]() { return completed.load(); });
+}
+
+/**
+ * A read waiting for a slot or in flight
+ */
+struct PendingRead
+{
+	ReadBatchPtr batch;
+	size_t request_idx;
+
+	/** OS file for io_uring reads, -1 for thread pool reads */
+	int file;
+
+	/** Bytes already read, io_uring reads can be short */
+	uint64_t done;
+
+#if ZE_PLATFORM(LINUX)
+	iovec vec;
+#endif
+
+	PendingRead() : request_idx(0), file(-1), done(0) {}
+	PendingRead(const ReadBatchPtr& in_batch, const size_t in_request_idx) : batch(in_batch),
+		request_idx(in_request_idx), file(-1), done(0) {}
+
+	ZE_FORCEINLINE ReadRequest& get_request() const { return batch->requests[request_idx]; }
+};
+
+class Service
+{
+public:
+	Service(const Settings& in_settings);
+	~Service();
+
+	void submit(const ReadBatchPtr& in_batch);
+
+	Stats get_stats();
+	void reset_stats();
+
+	ZE_FORCEINLINE Backend get_backend() const { return backend; }
+private:
+	void thread_pool_loop();
+	void begin_read();
+	void end_read();
+	void complete(const PendingRead& in_read, const bool in_succeeded, const uint64_t in_bytes_read);
+	static void finish_batch(const ReadBatchPtr& in_batch);
+#if ZE_PLATFORM(LINUX)
+	bool initialize_io_uring();
+	void destroy_io_uring();
+	void io_uring_loop();
+
+	/** Move queued reads to the submission queue and submit them, io_uring_mutex must be locked */
+	void submit_io_uring();
+	void push_sqe(const uint8_t in_opcode, const int in_file, const uint64_t in_offset,
+		const iovec* in_vec, const uint64_t in_user_data);
+#endif
+private:
+	Settings settings;
+	Backend backend;
+	std::atomic_bool running;
+
+	std::mutex pool_mutex;
+	std::condition_variable pool_condition_var;
+	std::deque<PendingRead> pool_queue;
+	std::vector<std::thread> pool_threads;
+
+	std::atomic_uint64_t submitted_reads;
+	std::atomic_uint64_t completed_reads;
+	std::atomic_uint64_t failed_reads;
+	std::atomic_uint64_t bytes_read;
+	std::atomic_uint32_t in_flight;
+	std::atomic_uint32_t max_in_flight;
+	std::mutex stats_mutex;
+	std::chrono::steady_clock::time_point stats_start;
+
+#if ZE_PLATFORM(LINUX)
+	static constexpr uint64_t wake_user_data = std::numeric_limits<uint64_t>::max();
+
+	int ring_fd;
+	void* sq_ring;
+	size_t sq_ring_size;
+	void* cq_ring;
+	size_t cq_ring_size;
+	io_uring_sqe* sqes;
+	size_t sqes_size;
+	unsigned* sq_head;
+	unsigned* sq_tail;
+	unsigned* sq_mask;
+	unsigned* sq_array;
+	unsigned sq_entries;
+	unsigned* cq_head;
+	unsigned* cq_tail;
+	unsigned* cq_mask;
+	io_uring_cqe* cqes;
+
+	std::mutex io_uring_mutex;
+	std::deque<PendingRead> io_uring_queue;
+
+	/** Reads in flight, the slot index is the user data of the submission */
+	std::vector<PendingRead> slots;
+	std::vector<uint32_t> free_slots;
+	bool stopping;
+	std::thread io_uring_thread;
+#endif
+};
+
+Service::Service(const Settings& in_settings) : settings(in_settings), backend(Backend::ThreadPool),
+	running(true), submitted_reads(0), completed_reads(0), failed_reads(0), bytes_read(0), in_flight(0),
+	max_in_flight(0), stats_start(std::chrono::steady_clock::now())
+{
+	settings.queue_depth = std::max<uint32_t>(settings.queue_depth, 1);
+	settings.thread_count = std::clamp<uint32_t>(settings.thread_count, 1, settings.queue_depth);
+
+#if ZE_PLATFORM(LINUX)
+	ring_fd = -1;
+	stopping = false;
+	if (settings.use_io_uring && initialize_io_uring())
+	{
+		backend = Backend::IoUring;
+		io_uring_thread = std::thread([this]() { io_uring_loop(); });
+	}
+#endif
+
+	/** The thread pool is also used by the io_uring backend for files that aren't OS files */
+	for (uint32_t i = 0; i < settings.thread_count; ++i)
+		pool_threads.emplace_back([this]() { thread_pool_loop(); });
+
+	ze::logger::info("Async I/O using {} backend (queue depth {}, {} threads)",
+		backend == Backend::IoUring ? "io_uring" : "thread pool",
+		settings.queue_depth,
+		settings.thread_count);
+}
+
+Service::~Service()
+{
+	running = false;
+	pool_condition_var.notify_all();
+	for (auto& thread : pool_threads)
+		thread.join();
+
+#if ZE_PLATFORM(LINUX)
+	if (backend == Backend::IoUring)
+	{
+		{
+			std::scoped_lock lock(io_uring_mutex);
+			stopping = true;
+			push_sqe(IORING_OP_NOP, -1, 0, nullptr, wake_user_data);
+			submit_io_uring();
+		}
+
+		io_uring_thread.join();
+		destroy_io_uring();
+	}
+#endif
+}
+
+void Service::submit(const ReadBatchPtr& in_batch)
+{
+	submitted_reads += in_batch->requests.size();
+	if (in_batch->requests.empty())
+	{
+		finish_batch(in_batch);
+		return;
+	}
+
+	std::vector<PendingRead> pool_reads;
+#if ZE_PLATFORM(LINUX)
+	std::vector<PendingRead> io_uring_reads;
+	robin_hood::unordered_map<std::string, int> opened_files;
+#endif
+
+	for (size_t i = 0; i < in_batch->requests.size(); ++i)
+	{
+		PendingRead read(in_batch, i);
+
+#if ZE_PLATFORM(LINUX)
+		if (backend == Backend::IoUring)
+		{
+			const std::filesystem::path native_path = get_native_path(read.get_request().path);
+			if (!native_path.empty())
+			{
+				auto [it, inserted] = opened_files.insert({ native_path.string(), -1 });
+				if (inserted)
+				{
+					it->second = open(native_path.c_str(), O_RDONLY | O_CLOEXEC);
+					if (it->second >= 0)
+						in_batch->files.emplace_back(it->second);
+				}
+
+				read.file = it->second;
+			}
+
+			if (read.file >= 0)
+			{
+				io_uring_reads.emplace_back(std::move(read));
+				continue;
+			}
+		}
+#endif
+
+		pool_reads.emplace_back(std::move(read));
+	}
+
+	if (!pool_reads.empty())
+	{
+		{
+			std::scoped_lock lock(pool_mutex);
+			for (auto& read : pool_reads)
+				pool_queue.emplace_back(std::move(read));
+		}
+		pool_condition_var.notify_all();
+	}
+
+#if ZE_PLATFORM(LINUX)
+	if (!io_uring_reads.empty())
+	{
+		std::scoped_lock lock(io_uring_mutex);
+		for (auto& read : io_uring_reads)
+			io_uring_queue.emplace_back(std::move(read));
+		submit_io_uring();
+	}
+#endif
+}
+
+void Service::begin_read()
+{
+	const uint32_t count = ++in_flight;
+	uint32_t max_count = max_in_flight;
+	while (count > max_count && !max_in_flight.compare_exchange_weak(max_count, count)) {}
+}
+
+void Service::end_read()
+{
+	in_flight--;
+}
+
+void Service::complete(const PendingRead& in_read, const bool in_succeeded, const uint64_t in_bytes_read)
+{
+	ReadRequest& request = in_read.get_request();
+	request.succeeded = in_succeeded;
+	request.bytes_read = in_bytes_read;
+
+	completed_reads++;
+	bytes_read += in_bytes_read;
+	if (!in_succeeded)
+	{
+		failed_reads++;
+		in_read.batch->failed = true;
+		ze::logger::error("Async read of {} failed", request.path.string());
+	}
+
+	if (in_read.batch->pending.fetch_sub(1) == 1)
+		finish_batch(in_read.batch);
+}
+
+void Service::finish_batch(const ReadBatchPtr& in_batch)
+{
+#if ZE_PLATFORM(LINUX)
+	for (const int file : in_batch->files)
+		close(file);
+	in_batch->files.clear();
+#endif
+
+	{
+		std::scoped_lock lock(in_batch->mutex);
+		in_batch->completed = true;
+	}
+	in_batch->condition_var.notify_all();
+
+	if (!in_batch->on_completed)
+		return;
+
+	if (jobsystem::get_worker_count() > 0)
+	{
+		jobsystem::async([in_batch](const jobsystem::Job& in_job)
+		{
+			in_batch->on_completed(*in_batch);
+		});
+	}
+	else
+	{
+		in_batch->on_completed(*in_batch);
+	}
+}
+
+void Service::thread_pool_loop()
+{
+	threading::set_thread_name("Async I/O Thread");
+
+	while (true)
+	{
+		PendingRead read;
+		{
+			std::unique_lock lock(pool_mutex);
+			pool_condition_var.wait(lock, [this]() { return !pool_queue.empty() || !running; });
+
+			/** Queued reads are still processed when stopping */
+			if (pool_queue.empty())
+				return;
+
+			read = std::move(pool_queue.front());
+			pool_queue.pop_front();
+		}
+
+		begin_read();
+
+		ReadRequest& request = read.get_request();
+		std::unique_ptr<std::streambuf> buffer(filesystem::read(request.path, FileReadFlagBits::Binary));
+		std::streamsize size = -1;
+		if (buffer && buffer->pubseekpos(request.offset, std::ios::in) ==
+			std::streampos(static_cast<std::streamoff>(request.offset)))
+		{
+			size = buffer->sgetn(reinterpret_cast<char*>(request.buffer.data()),
+				static_cast<std::streamsize>(request.buffer.size()));
+		}
+
+		end_read();
+		complete(read, size >= 0, static_cast<uint64_t>(std::max<std::streamsize>(size, 0)));
+	}
+}
+
+Stats Service::get_stats()
+{
+	Stats stats;
+	stats.submitted_reads = submitted_reads;
+	stats.completed_reads = completed_reads;
+	stats.failed_reads = failed_reads;
+	stats.bytes_read = bytes_read;
+	stats.in_flight = in_flight;
+	stats.max_in_flight = max_in_flight;
+
+	{
+		std::scoped_lock lock(stats_mutex);
+		stats.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats_start).count();
+	}
+
+	{
+		std::scoped_lock lock(pool_mutex);
+		stats.queued += static_cast<uint32_t>(pool_queue.size());
+	}
+
+#if ZE_PLATFORM(LINUX)
+	{
+		std::scoped_lock lock(io_uring_mutex);
+		stats.queued += static_cast<uint32_t>(io_uring_queue.size());
+	}
+#endif
+
+	return stats;
+}
+
+void Service::reset_stats()
+{
+	submitted_reads = 0;
+	completed_reads = 0;
+	failed_reads = 0;
+	bytes_read = 0;
+	max_in_flight = in_flight.load();
+
+	std::scoped_lock lock(stats_mutex);
+	stats_start = std::chrono::steady_clock::now();
+}
+
+#if ZE_PLATFORM(LINUX)
+int io_uring_setup(const unsigned in_entries, io_uring_params* in_params)
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, in_entries, in_params));
+}
+
+int io_uring_enter(const int in_fd, const unsigned in_to_submit, const unsigned in_min_complete,
+	const unsigned in_flags)
+{
+	return static_cast<int>(syscall(__NR_io_uring_enter, in_fd, in_to_submit, in_min_complete, in_flags,
+		nullptr, 0));
+}
+
+bool Service::initialize_io_uring()
+{
+	/** One more entry for the shutdown wake up */
+	io_uring_params params = {};
+	ring_fd = io_uring_setup(settings.queue_depth + 1, &params);
+	if (ring_fd < 0)
+	{
+		ze::logger::verbose("io_uring unavailable ({}), falling back to the thread pool", strerror(errno));
+		return false;
+	}
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+	sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+		IORING_OFF_SQ_RING);
+	cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? sq_ring :
+		mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+			IORING_OFF_CQ_RING);
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	void* sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+		IORING_OFF_SQES);
+	if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes_ptr == MAP_FAILED)
+	{
+		ze::logger::error("Failed to map io_uring rings: {}", strerror(errno));
+		sqes = sqes_ptr == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes_ptr);
+		destroy_io_uring();
+		return false;
+	}
+
+	uint8_t* sq = static_cast<uint8_t*>(sq_ring);
+	sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+	sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+	sq_entries = params.sq_entries;
+	sqes = static_cast<io_uring_sqe*>(sqes_ptr);
+
+	uint8_t* cq = static_cast<uint8_t*>(cq_ring);
+	cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+	slots.resize(settings.queue_depth);
+	free_slots.reserve(settings.queue_depth);
+	for (uint32_t i = settings.queue_depth; i > 0; --i)
+		free_slots.emplace_back(i - 1);
+
+	return true;
+}
+
+void Service::destroy_io_uring()
+{
+	if (sqes)
+		munmap(sqes, sqes_size);
+	if (cq_ring && cq_ring != MAP_FAILED && cq_ring != sq_ring)
+		munmap(cq_ring, cq_ring_size);
+	if (sq_ring && sq_ring != MAP_FAILED)
+		munmap(sq_ring, sq_ring_size);
+	close(ring_fd);
+
+	sqes = nullptr;
+	sq_ring = nullptr;
+	cq_ring = nullptr;
+	ring_fd = -1;
+}
+
+void Service::push_sqe(const uint8_t in_opcode, const int in_file, const uint64_t in_offset,
+	const iovec* in_vec, const uint64_t in_user_data)
+{
+	/** Only written with io_uring_mutex locked, the kernel only moves the head */
+	const unsigned tail = *sq_tail;
+	const unsigned idx = tail & *sq_mask;
+
+	io_uring_sqe& sqe = sqes[idx];
+	sqe = {};
+	sqe.opcode = in_opcode;
+	sqe.fd = in_file;
+	sqe.off = in_offset;
+	sqe.addr = reinterpret_cast<uint64_t>(in_vec);
+	sqe.len = in_vec ? 1 : 0;
+	sqe.user_data = in_user_data;
+	sq_array[idx] = idx;
+
+	std::atomic_ref<unsigned>(*sq_tail).store(tail + 1, std::memory_order_release);
+}
+
+void Service::submit_io_uring()
+{
+	while (!io_uring_queue.empty() && !free_slots.empty())
+	{
+		const uint32_t slot = free_slots.back();
+		free_slots.pop_back();
+
+		PendingRead& read = slots[slot];
+		read = std::move(io_uring_queue.front());
+		io_uring_queue.pop_front();
+
+		const ReadRequest& request = read.get_request();
+		read.vec.iov_base = request.buffer.data() + read.done;
+		read.vec.iov_len = request.buffer.size() - read.done;
+		push_sqe(IORING_OP_READV, read.file, request.offset + read.done, &read.vec, slot);
+		begin_read();
+	}
+
+	/** Also resubmit entries a previous io_uring_enter didn't consume */
+	const unsigned to_submit = *sq_tail - std::atomic_ref<unsigned>(*sq_head).load(std::memory_order_acquire);
+	if (to_submit > 0)
+		io_uring_enter(ring_fd, to_submit, 0, 0);
+}
+
+void Service::io_uring_loop()
+{
+	threading::set_thread_name("Async I/O io_uring Thread");
+
+	struct Completion
+	{
+		uint32_t slot;
+		int32_t result;
+	};
+	std::vector<Completion> completions;
+	completions.reserve(settings.queue_depth);
+
+	while (true)
+	{
+		if (io_uring_enter(ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+			errno != EINTR && errno != EAGAIN && errno != EBUSY)
+		{
+			ze::logger::error("io_uring_enter failed: {}", strerror(errno));
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		/** The kernel only moves the tail */
+		unsigned head = *cq_head;
+		const unsigned tail = std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire);
+		completions.clear();
+		for (; head != tail; ++head)
+		{
+			const io_uring_cqe& cqe = cqes[head & *cq_mask];
+			if (cqe.user_data != wake_user_data)
+				completions.push_back({ static_cast<uint32_t>(cqe.user_data), cqe.res });
+		}
+		std::atomic_ref<unsigned>(*cq_head).store(head, std::memory_order_release);
+
+		std::vector<std::pair<PendingRead, int32_t>> finished_reads;
+		bool stop = false;
+		{
+			std::scoped_lock lock(io_uring_mutex);
+			for (const auto& completion : completions)
+			{
+				PendingRead read = std::move(slots[completion.slot]);
+				free_slots.emplace_back(completion.slot);
+				end_read();
+
+				/** Short read before the end of the file, read the rest */
+				if (completion.result > 0 &&
+					read.done + completion.result < read.get_request().buffer.size())
+				{
+					read.done += completion.result;
+					io_uring_queue.emplace_front(std::move(read));
+					continue;
+				}
+
+				finished_reads.emplace_back(std::move(read), completion.result);
+			}
+
+			submit_io_uring();
+			stop = stopping && io_uring_queue.empty() && free_slots.size() == slots.size();
+		}
+
+		for (const auto& [read, result] : finished_reads)
+			complete(read, result >= 0, read.done + std::max(result, 0));
+
+		if (stop)
+			break;
+	}
+}
+#endif
+
+std::mutex service_mutex;
+std::unique_ptr<Service> service;
+
+Service& get_service()
+{
+	std::scoped_lock lock(service_mutex);
+	if (!service)
+		service = std::make_unique<Service>(Settings());
+
+	return *service;
+}
+
+bool initialize(const Settings& in_settings)
+{
+	std::scoped_lock lock(service_mutex);
+	if (service)
+		return false;
+
+	service = std::make_unique<Service>(in_settings);
+	return true;
+}
+
+void shutdown()
+{
+	std::scoped_lock lock(service_mutex);
+	service.reset();
+}
+
+Backend get_backend()
+{
+	return get_service().get_backend();
+}
+
+ReadBatchPtr submit(std::vector<ReadRequest>&& in_requests, ReadBatch::OnCompleted&& in_on_completed)
+{
+	ReadBatchPtr batch = std::make_shared<ReadBatch>(std::move(in_requests), std::move(in_on_completed));
+	get_service().submit(batch);
+	return batch;
+}
+
+Stats get_stats()
+{
+	return get_service().get_stats();
+}
+
+void reset_stats()
+{
+	get_service().reset_stats();
+}
+
+}
@@ -0,0 +1,28 @@
+#include "zefs/FileSystem.h"
+#include <istream>
+
+namespace ze::filesystem
+{
+
+MappedRegion FileSystem::map(const std::filesystem::path& path, const MapAccessHint& hint)
+{
+	std::unique_ptr<std::streambuf> buffer(read(path, FileReadFlagBits::Binary | FileReadFlagBits::End));
+	if (!buffer)
+		return {};
+
+	std::istream stream(buffer.get());
+	const int64_t size = stream.tellg();
+	if (size < 0)
+		return {};
+
+	stream.seekg(0, std::ios::beg);
+
+	std::vector<uint8_t> data(static_cast<size_t>(size));
+	stream.read(reinterpret_cast<char*>(data.data()), size);
+	if (stream.gcount() != size)
+		return {};
+
+	return MappedRegion(std::move(data));
+}
+
+}
@@ -0,0 +1,600 @@
+#include "zefs/FileWatcher.h"
+#include "zefs/ZEFS.h"
+#include "threading/Thread.h"
+#include <robin_hood.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if ZE_PLATFORM(LINUX)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace ze::filesystem
+{
+
+/** Directories are polled at this interval when there is no native backend */
+static constexpr std::chrono::milliseconds poll_interval(1000);
+
+struct PathHash
+{
+	size_t operator()(const std::filesystem::path& in_path) const noexcept
+	{
+		return std::filesystem::hash_value(in_path);
+	}
+};
+
+/** True if in_path is in_directory or inside it */
+bool is_same_or_inside(const std::filesystem::path& in_path, const std::filesystem::path& in_directory)
+{
+	if (in_directory.empty())
+		return true;
+
+	const std::filesystem::path relative_path = in_path.lexically_relative(in_directory);
+	return !relative_path.empty() && *relative_path.begin() != "..";
+}
+
+struct PolledEntry
+{
+	std::filesystem::file_time_type last_write_time;
+	bool is_directory;
+};
+using PolledSnapshot = robin_hood::unordered_map<std::filesystem::path, PolledEntry, PathHash>;
+
+struct Watch
+{
+	std::filesystem::path path;
+	std::filesystem::path native_path;
+	bool recursive;
+	std::shared_ptr<FileWatchCallback> callback;
+
+	/** Last state of the directory, only used when polling */
+	PolledSnapshot snapshot;
+};
+
+using PendingEvents = std::vector<std::pair<FileWatchHandle, FileWatchEvent>>;
+
+class FileWatcher
+{
+public:
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatchHandle add(const std::filesystem::path& in_path, const std::filesystem::path& in_native_path,
+		FileWatchCallback&& in_callback, const bool in_recursive);
+	void remove(const FileWatchHandle in_handle);
+private:
+	void dispatch(const PendingEvents& in_events);
+	void poll_loop();
+	void poll_watch(const FileWatchHandle in_handle, Watch& in_watch, PendingEvents* out_events);
+#if ZE_PLATFORM(LINUX)
+	struct WatchedDirectory
+	{
+		FileWatchHandle handle;
+
+		/** Relative to the watch root */
+		std::filesystem::path relative_path;
+	};
+
+	struct PendingMove
+	{
+		FileWatchHandle handle;
+		std::filesystem::path relative_path;
+		bool is_directory;
+	};
+
+	void inotify_loop();
+	void process_inotify_events(const uint8_t* in_data, const size_t in_size, PendingEvents& out_events);
+	void add_directory(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path);
+
+	/**
+	 * Watch a directory and all its sub directories
+	 * \param out_events Receives creation events for entries that already exist
+	 */
+	void add_directory_tree(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path,
+		PendingEvents* out_events);
+	void rename_directories(const FileWatchHandle in_handle, const std::filesystem::path& in_old_relative_path,
+		const std::filesystem::path& in_new_relative_path);
+	void remove_directories(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path);
+#endif
+private:
+	std::mutex mutex;
+
+	/** Held while callbacks are called, recursive so callbacks can unwatch */
+	std::recursive_mutex dispatch_mutex;
+	robin_hood::unordered_node_map<FileWatchHandle, Watch> watches;
+	FileWatchHandle next_handle;
+	std::atomic_bool running;
+	std::condition_variable wake_condition_var;
+	std::thread thread;
+
+#if ZE_PLATFORM(LINUX)
+	int inotify_fd;
+	int wake_fd;
+
+	/** inotify watch descriptor -> watched directories, a directory can be part of several watches */
+	robin_hood::unordered_map<int, std::vector<WatchedDirectory>> directories;
+#endif
+};
+
+FileWatcher::FileWatcher() : next_handle(invalid_file_watch_handle + 1), running(true)
+{
+#if ZE_PLATFORM(LINUX)
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	wake_fd = inotify_fd >= 0 ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+	if (inotify_fd >= 0 && wake_fd >= 0)
+	{
+		thread = std::thread([this]() { inotify_loop(); });
+		return;
+	}
+
+	ze::logger::warn("inotify unavailable ({}), polling watched directories", strerror(errno));
+	if (inotify_fd >= 0)
+		close(inotify_fd);
+	inotify_fd = -1;
+#endif
+
+	thread = std::thread([this]() { poll_loop(); });
+}
+
+FileWatcher::~FileWatcher()
+{
+	{
+		std::scoped_lock lock(mutex);
+		running = false;
+	}
+
+#if ZE_PLATFORM(LINUX)
+	if (inotify_fd >= 0)
+	{
+		const uint64_t value = 1;
+		::write(wake_fd, &value, sizeof(value));
+	}
+#endif
+	wake_condition_var.notify_all();
+	thread.join();
+
+#if ZE_PLATFORM(LINUX)
+	if (inotify_fd >= 0)
+	{
+		close(inotify_fd);
+		close(wake_fd);
+	}
+#endif
+}
+
+FileWatchHandle FileWatcher::add(const std::filesystem::path& in_path, const std::filesystem::path& in_native_path,
+	FileWatchCallback&& in_callback, const bool in_recursive)
+{
+	std::scoped_lock lock(mutex);
+
+	const FileWatchHandle handle = next_handle++;
+	Watch& watch = watches[handle];
+	watch.path = in_path;
+	watch.native_path = in_native_path;
+	watch.recursive = in_recursive;
+	watch.callback = std::make_shared<FileWatchCallback>(std::move(in_callback));
+
+#if ZE_PLATFORM(LINUX)
+	if (inotify_fd >= 0)
+	{
+		if (in_recursive)
+			add_directory_tree(handle, "", nullptr);
+		else
+			add_directory(handle, "");
+
+		return handle;
+	}
+#endif
+
+	/** First snapshot, following polls report the differences */
+	poll_watch(handle, watch, nullptr);
+	return handle;
+}
+
+void FileWatcher::remove(const FileWatchHandle in_handle)
+{
+	{
+		std::scoped_lock lock(mutex);
+#if ZE_PLATFORM(LINUX)
+		if (inotify_fd >= 0)
+			remove_directories(in_handle, "");
+#endif
+		watches.erase(in_handle);
+	}
+
+	/** Wait for callbacks being called */
+	std::scoped_lock dispatch_lock(dispatch_mutex);
+}
+
+void FileWatcher::dispatch(const PendingEvents& in_events)
+{
+	std::scoped_lock dispatch_lock(dispatch_mutex);
+	for (const auto& [handle, event] : in_events)
+	{
+		/** Files appeared or disappeared, resolved paths are outdated */
+		if (event.type != FileWatchEventType::Modified)
+		{
+			if (event.is_directory)
+			{
+				clear_resolve_cache();
+			}
+			else
+			{
+				invalidate_resolved_path(event.path);
+				invalidate_resolved_path(event.old_path);
+			}
+		}
+
+		std::shared_ptr<FileWatchCallback> callback;
+		{
+			std::scoped_lock lock(mutex);
+			auto it = watches.find(handle);
+			if (it != watches.end())
+				callback = it->second.callback;
+		}
+
+		if (callback)
+			(*callback)(event);
+	}
+}
+
+void FileWatcher::poll_loop()
+{
+	threading::set_thread_name("File Watcher Thread");
+
+	while (running)
+	{
+		PendingEvents events;
+		{
+			std::unique_lock lock(mutex);
+			wake_condition_var.wait_for(lock, poll_interval, [this]() { return !running; });
+			if (!running)
+				break;
+
+			for (auto& [handle, watch] : watches)
+				poll_watch(handle, watch, &events);
+		}
+
+		dispatch(events);
+	}
+}
+
+void FileWatcher::poll_watch(const FileWatchHandle in_handle, Watch& in_watch, PendingEvents* out_events)
+{
+	PolledSnapshot snapshot;
+	std::error_code error;
+	auto add_entry = [&](const std::filesystem::directory_entry& in_entry)
+	{
+		PolledEntry entry;
+		entry.is_directory = in_entry.is_directory(error);
+		entry.last_write_time = in_entry.last_write_time(error);
+		snapshot.insert({ in_entry.path().lexically_relative(in_watch.native_path), entry });
+	};
+
+	if (in_watch.recursive)
+	{
+		for (auto it = std::filesystem::recursive_directory_iterator(in_watch.native_path,
+			std::filesystem::directory_options::skip_permission_denied, error);
+			!error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+			add_entry(*it);
+	}
+	else
+	{
+		for (auto it = std::filesystem::directory_iterator(in_watch.native_path, error);
+			!error && it != std::filesystem::directory_iterator(); it.increment(error))
+			add_entry(*it);
+	}
+
+	if (out_events)
+	{
+		for (const auto& [path, entry] : snapshot)
+		{
+			auto it = in_watch.snapshot.find(path);
+			if (it == in_watch.snapshot.end())
+			{
+				out_events->emplace_back(in_handle,
+					FileWatchEvent(FileWatchEventType::Created, in_watch.path / path, entry.is_directory));
+			}
+			else if (!entry.is_directory && it->second.last_write_time != entry.last_write_time)
+			{
+				out_events->emplace_back(in_handle,
+					FileWatchEvent(FileWatchEventType::Modified, in_watch.path / path, false));
+			}
+		}
+
+		for (const auto& [path, entry] : in_watch.snapshot)
+		{
+			if (!snapshot.contains(path))
+			{
+				out_events->emplace_back(in_handle,
+					FileWatchEvent(FileWatchEventType::Deleted, in_watch.path / path, entry.is_directory));
+			}
+		}
+	}
+
+	in_watch.snapshot = std::move(snapshot);
+}
+
+#if ZE_PLATFORM(LINUX)
+void FileWatcher::inotify_loop()
+{
+	threading::set_thread_name("File Watcher Thread");
+
+	pollfd fds[2] = {};
+	fds[0].fd = inotify_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = wake_fd;
+	fds[1].events = POLLIN;
+
+	alignas(inotify_event) uint8_t buffer[64 * 1024];
+	while (running)
+	{
+		if (::poll(fds, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			ze::logger::error("Failed to poll inotify events: {}", strerror(errno));
+			break;
+		}
+
+		if (!(fds[0].revents & POLLIN))
+			continue;
+
+		const ssize_t size = ::read(inotify_fd, buffer, sizeof(buffer));
+		if (size <= 0)
+			continue;
+
+		PendingEvents events;
+		{
+			std::scoped_lock lock(mutex);
+			process_inotify_events(buffer, static_cast<size_t>(size), events);
+		}
+
+		dispatch(events);
+	}
+}
+
+void FileWatcher::process_inotify_events(const uint8_t* in_data, const size_t in_size, PendingEvents& out_events)
+{
+	/** Both halves of a move share a cookie, moves without a destination left the watched directories */
+	robin_hood::unordered_map<uint64_t, PendingMove> moves;
+
+	for (size_t offset = 0; offset < in_size; )
+	{
+		const inotify_event* event = reinterpret_cast<const inotify_event*>(in_data + offset);
+		offset += sizeof(inotify_event) + event->len;
+
+		if (event->mask & IN_Q_OVERFLOW)
+		{
+			ze::logger::warn("File watcher event queue overflowed, watched directories will be rescanned");
+			for (const auto& [handle, watch] : watches)
+			{
+				out_events.emplace_back(handle, FileWatchEvent(FileWatchEventType::Overflowed, watch.path, true));
+
+				/** Creation of sub directories may have been lost too, already watched ones are skipped */
+				if (watch.recursive)
+					add_directory_tree(handle, "", nullptr);
+			}
+			continue;
+		}
+
+		auto directory_it = directories.find(event->wd);
+		if (directory_it == directories.end())
+			continue;
+
+		if (event->mask & IN_IGNORED)
+		{
+			directories.erase(directory_it);
+			continue;
+		}
+
+		/** Events about the directory itself are also reported to its parent */
+		if (event->len == 0)
+			continue;
+
+		const bool is_directory = event->mask & IN_ISDIR;
+		const std::filesystem::path name = event->name;
+
+		/** Copy as adding watches can rehash the map */
+		const std::vector<WatchedDirectory> watched_directories = directory_it->second;
+		for (const auto& directory : watched_directories)
+		{
+			auto watch_it = watches.find(directory.handle);
+			if (watch_it == watches.end())
+				continue;
+
+			const Watch& watch = watch_it->second;
+			const std::filesystem::path relative_path = directory.relative_path / name;
+			const uint64_t move_key = (static_cast<uint64_t>(event->cookie) << 32) | directory.handle;
+
+			if (event->mask & IN_CREATE)
+			{
+				out_events.emplace_back(directory.handle,
+					FileWatchEvent(FileWatchEventType::Created, watch.path / relative_path, is_directory));
+				if (is_directory && watch.recursive)
+					add_directory_tree(directory.handle, relative_path, &out_events);
+			}
+			else if (event->mask & IN_CLOSE_WRITE)
+			{
+				out_events.emplace_back(directory.handle,
+					FileWatchEvent(FileWatchEventType::Modified, watch.path / relative_path, false));
+			}
+			else if (event->mask & IN_DELETE)
+			{
+				out_events.emplace_back(directory.handle,
+					FileWatchEvent(FileWatchEventType::Deleted, watch.path / relative_path, is_directory));
+			}
+			else if (event->mask & IN_MOVED_FROM)
+			{
+				moves[move_key] = { directory.handle, relative_path, is_directory };
+			}
+			else if (event->mask & IN_MOVED_TO)
+			{
+				auto move_it = moves.find(move_key);
+				if (move_it != moves.end())
+				{
+					FileWatchEvent renamed_event(FileWatchEventType::Renamed, watch.path / relative_path, is_directory);
+					renamed_event.old_path = watch.path / move_it->second.relative_path;
+					out_events.emplace_back(directory.handle, std::move(renamed_event));
+					if (is_directory && watch.recursive)
+						rename_directories(directory.handle, move_it->second.relative_path, relative_path);
+					moves.erase(move_it);
+				}
+				else
+				{
+					/** Moved from outside the watched directories */
+					out_events.emplace_back(directory.handle,
+						FileWatchEvent(FileWatchEventType::Created, watch.path / relative_path, is_directory));
+					if (is_directory && watch.recursive)
+						add_directory_tree(directory.handle, relative_path, &out_events);
+				}
+			}
+		}
+	}
+
+	for (const auto& [key, move] : moves)
+	{
+		auto watch_it = watches.find(move.handle);
+		if (watch_it == watches.end())
+			continue;
+
+		out_events.emplace_back(move.handle,
+			FileWatchEvent(FileWatchEventType::Deleted, watch_it->second.path / move.relative_path, move.is_directory));
+		if (move.is_directory)
+			remove_directories(move.handle, move.relative_path);
+	}
+}
+
+void FileWatcher::add_directory(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path)
+{
+	const Watch& watch = watches[in_handle];
+	const std::filesystem::path native_path = watch.native_path / in_relative_path;
+	const int wd = inotify_add_watch(inotify_fd, native_path.c_str(),
+		IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+	if (wd < 0)
+	{
+		ze::logger::error("Failed to watch {}: {}", native_path.string(), strerror(errno));
+		return;
+	}
+
+	auto& watched_directories = directories[wd];
+	for (const auto& directory : watched_directories)
+		if (directory.handle == in_handle)
+			return;
+
+	watched_directories.push_back({ in_handle, in_relative_path });
+}
+
+void FileWatcher::add_directory_tree(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path,
+	PendingEvents* out_events)
+{
+	add_directory(in_handle, in_relative_path);
+
+	/** Entries created before the watch was added would be missed otherwise, they may be reported twice */
+	const Watch& watch = watches[in_handle];
+	const std::filesystem::path root = watch.native_path / in_relative_path;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(root,
+		std::filesystem::directory_options::skip_permission_denied, error);
+		!error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+	{
+		const std::filesystem::path relative_path = in_relative_path / it->path().lexically_relative(root);
+		const bool is_directory = it->is_directory(error);
+		if (is_directory)
+			add_directory(in_handle, relative_path);
+
+		if (out_events)
+		{
+			out_events->emplace_back(in_handle,
+				FileWatchEvent(FileWatchEventType::Created, watch.path / relative_path, is_directory));
+		}
+	}
+}
+
+void FileWatcher::rename_directories(const FileWatchHandle in_handle, const std::filesystem::path& in_old_relative_path,
+	const std::filesystem::path& in_new_relative_path)
+{
+	for (auto& [wd, watched_directories] : directories)
+	{
+		for (auto& directory : watched_directories)
+		{
+			if (directory.handle == in_handle && is_same_or_inside(directory.relative_path, in_old_relative_path))
+			{
+				const std::filesystem::path sub_path = directory.relative_path.lexically_relative(in_old_relative_path);
+				directory.relative_path = sub_path == "." ? in_new_relative_path : in_new_relative_path / sub_path;
+			}
+		}
+	}
+}
+
+void FileWatcher::remove_directories(const FileWatchHandle in_handle, const std::filesystem::path& in_relative_path)
+{
+	for (auto it = directories.begin(); it != directories.end(); )
+	{
+		auto& watched_directories = it->second;
+		std::erase_if(watched_directories, [&](const WatchedDirectory& in_directory)
+		{
+			return in_directory.handle == in_handle && is_same_or_inside(in_directory.relative_path, in_relative_path);
+		});
+
+		if (watched_directories.empty())
+		{
+			inotify_rm_watch(inotify_fd, it->first);
+			it = directories.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+#endif
+
+std::mutex watcher_mutex;
+std::unique_ptr<FileWatcher> watcher;
+
+FileWatchHandle watch(const std::filesystem::path& path, FileWatchCallback&& callback,
+	const FileWatchFlags& flags)
+{
+	const std::filesystem::path native_path = get_native_path(path);
+	if (native_path.empty() || !std::filesystem::is_directory(native_path))
+	{
+		ze::logger::error("Can't watch {}: not a directory on disk", path.string());
+		return invalid_file_watch_handle;
+	}
+
+	std::scoped_lock lock(watcher_mutex);
+	if (!watcher)
+		watcher = std::make_unique<FileWatcher>();
+
+	return watcher->add(path, native_path, std::move(callback),
+		static_cast<bool>(flags & FileWatchFlagBits::Recursive));
+}
+
+void unwatch(const FileWatchHandle handle)
+{
+	/**
+	 * remove() waits for the callbacks being called, don't hold watcher_mutex meanwhile
+	 * as a callback could call watch() or unwatch()
+	 * The watcher is only destroyed at exit so the pointer stays valid
+	 */
+	FileWatcher* current_watcher = nullptr;
+	{
+		std::scoped_lock lock(watcher_mutex);
+		current_watcher = watcher.get();
+	}
+
+	if (current_watcher && handle != invalid_file_watch_handle)
+		current_watcher->remove(handle);
+}
+
+}
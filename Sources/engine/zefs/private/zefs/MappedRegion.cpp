@@ -0,0 +1,201 @@
+#include "zefs/MappedRegion.h"
+#include <algorithm>
+#include <utility>
+#if ZE_PLATFORM(WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ze::filesystem
+{
+
+MappedRegion::~MappedRegion()
+{
+	unmap();
+}
+
+MappedRegion::MappedRegion(MappedRegion&& other) noexcept : data(other.data), size(other.size),
+	mapping(other.mapping), mapping_size(other.mapping_size), buffer(std::move(other.buffer)), 
+	owner(std::move(other.owner)), valid(other.valid)
+{
+	other.data = nullptr;
+	other.size = 0;
+	other.mapping = nullptr;
+	other.mapping_size = 0;
+	other.valid = false;
+}
+
+MappedRegion& MappedRegion::operator=(MappedRegion&& other) noexcept
+{
+	if(this != &other)
+	{
+		unmap();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+		mapping = std::exchange(other.mapping, nullptr);
+		mapping_size = std::exchange(other.mapping_size, 0);
+		buffer = std::move(other.buffer);
+		owner = std::move(other.owner);
+		valid = std::exchange(other.valid, false);
+	}
+
+	return *this;
+}
+
+void MappedRegion::unmap()
+{
+	if(mapping)
+	{
+#if ZE_PLATFORM(WINDOWS)
+		UnmapViewOfFile(mapping);
+#elif ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+		munmap(mapping, mapping_size);
+#endif
+	}
+
+	data = nullptr;
+	size = 0;
+	mapping = nullptr;
+	mapping_size = 0;
+	buffer.clear();
+	owner.reset();
+	valid = false;
+}
+
+MappedRegion MappedRegion::map_file(const std::filesystem::path& in_path, const MapAccessHint in_hint)
+{
+	MappedRegion region;
+
+#if ZE_PLATFORM(WINDOWS)
+	HANDLE file = CreateFileW(in_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		in_hint == MapAccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+			in_hint == MapAccessHint::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL,
+		nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return region;
+
+	LARGE_INTEGER file_size;
+	if(!GetFileSizeEx(file, &file_size))
+	{
+		CloseHandle(file);
+		return region;
+	}
+
+	/** Empty files can't be mapped */
+	if(file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return MappedRegion(std::vector<uint8_t>());
+	}
+
+	HANDLE file_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if(!file_mapping)
+		return region;
+
+	/** The view keeps the mapping object alive */
+	void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(file_mapping);
+	if(!view)
+		return region;
+
+	region.mapping = view;
+	region.mapping_size = static_cast<size_t>(file_size.QuadPart);
+#elif ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+	int fd = open(in_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+		return region;
+
+	struct stat file_stat;
+	if(fstat(fd, &file_stat) != 0)
+	{
+		close(fd);
+		return region;
+	}
+
+	/** Empty files can't be mapped */
+	if(file_stat.st_size == 0)
+	{
+		close(fd);
+		return MappedRegion(std::vector<uint8_t>());
+	}
+
+	/** The mapping stays valid after closing the file */
+	void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(view == MAP_FAILED)
+		return region;
+
+	region.mapping = view;
+	region.mapping_size = static_cast<size_t>(file_stat.st_size);
+#else
+	return region;
+#endif
+
+	region.data = static_cast<const uint8_t*>(region.mapping);
+	region.size = region.mapping_size;
+	region.valid = true;
+	region.advise(in_hint);
+	return region;
+}
+
+#if ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+/**
+ * madvise a range, the range is extended to page boundaries
+ */
+void advise_range(const uint8_t* in_data, const size_t in_size, const int in_advice)
+{
+	const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+	const uintptr_t begin = reinterpret_cast<uintptr_t>(in_data) & ~(page_size - 1);
+	const uintptr_t end = reinterpret_cast<uintptr_t>(in_data) + in_size;
+	madvise(reinterpret_cast<void*>(begin), end - begin, in_advice);
+}
+#endif
+
+void MappedRegion::advise(const MapAccessHint in_hint) const
+{
+	if(!is_mapped() || empty())
+		return;
+
+#if ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+	int advice = MADV_NORMAL;
+	switch(in_hint)
+	{
+	case MapAccessHint::Normal:
+		advice = MADV_NORMAL;
+		break;
+	case MapAccessHint::Sequential:
+		advice = MADV_SEQUENTIAL;
+		break;
+	case MapAccessHint::Random:
+		advice = MADV_RANDOM;
+		break;
+	}
+
+	advise_range(data, size, advice);
+#endif
+}
+
+void MappedRegion::prefetch(const size_t in_offset, const size_t in_size) const
+{
+	if(!is_mapped() || in_offset >= size)
+		return;
+
+	const size_t prefetch_size = std::min(in_size, size - in_offset);
+
+#if ZE_PLATFORM(WINDOWS)
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = const_cast<uint8_t*>(data) + in_offset;
+	range.NumberOfBytes = prefetch_size;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#elif ZE_PLATFORM(OSX) || ZE_PLATFORM(LINUX)
+	advise_range(data + in_offset, prefetch_size, MADV_WILLNEED);
+#endif
+}
+
+}
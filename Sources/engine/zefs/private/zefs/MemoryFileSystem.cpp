@@ -0,0 +1,346 @@
+#include "zefs/MemoryFileSystem.h"
+#include "zefs/RegionStreamBuf.h"
+#include "zefs/VirtualPath.h"
+#include "zefs/ZEFS.h"
+#include <mutex>
+#include <streambuf>
+
+namespace ze::filesystem
+{
+
+/**
+ * Streambuf accumulating written data, committed to the file system on sync and destruction
+ */
+class MemoryWriteStreamBuf final : public std::streambuf
+{
+public:
+	MemoryWriteStreamBuf(MemoryFileSystem& in_filesystem, const std::filesystem::path& in_path,
+		const uint64_t in_max_size, std::vector<uint8_t>&& in_data) : filesystem(in_filesystem), path(in_path),
+		max_size(in_max_size), data(std::move(in_data)), dirty(true) {}
+
+	~MemoryWriteStreamBuf() override
+	{
+		/** Nobody can check the result anymore, at least report the loss */
+		if (dirty && !filesystem.add_file(path, std::move(data)))
+			ze::logger::error("Failed to commit {} to the memory file system, written data is lost", path.string());
+	}
+protected:
+	int_type overflow(int_type ch) override
+	{
+		if (traits_type::eq_int_type(ch, traits_type::eof()))
+			return traits_type::not_eof(ch);
+
+		const char c = traits_type::to_char_type(ch);
+		return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+	}
+
+	std::streamsize xsputn(const char* s, std::streamsize count) override
+	{
+		if (max_size != 0 && data.size() + count > max_size)
+			return 0;
+
+		data.insert(data.end(), reinterpret_cast<const uint8_t*>(s), reinterpret_cast<const uint8_t*>(s) + count);
+		dirty = true;
+		return count;
+	}
+
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		/** Only tellp is supported, data is always appended */
+		if (off != 0 || dir == std::ios_base::beg || !(which & std::ios_base::out))
+			return pos_type(off_type(-1));
+
+		return pos_type(static_cast<off_type>(data.size()));
+	}
+
+	int sync() override
+	{
+		if (!dirty)
+			return 0;
+
+		dirty = false;
+		return filesystem.add_file(path, std::vector<uint8_t>(data)) ? 0 : -1;
+	}
+private:
+	MemoryFileSystem& filesystem;
+	std::filesystem::path path;
+	uint64_t max_size;
+	std::vector<uint8_t> data;
+	bool dirty;
+};
+
+MemoryFileSystem::MemoryFileSystem(const std::string& in_alias,
+	const uint8_t& in_priority, const uint64_t in_max_size) : FileSystem(in_alias,
+		in_priority), max_size(in_max_size), used_size(0)
+{
+	nodes.insert({ "", Node() });
+}
+
+MemoryFileSystem::Buffer MemoryFileSystem::find_file(const std::filesystem::path& path) const
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::shared_lock lock(mutex);
+	auto it = nodes.find(normalized_path);
+	return it != nodes.end() ? it->second.data : nullptr;
+}
+
+OwnerPtr<std::streambuf> MemoryFileSystem::read(const std::filesystem::path& path, const FileReadFlags& flags)
+{
+	Buffer data = find_file(path);
+	if (!data)
+		return nullptr;
+
+	const std::span<const uint8_t> view(*data);
+	return new RegionStreamBuf(MappedRegion(view, std::move(data)),
+		static_cast<bool>(flags & FileReadFlagBits::End));
+}
+
+OwnerPtr<std::streambuf> MemoryFileSystem::write(const std::filesystem::path& path, const FileWriteFlags& flags)
+{
+	if (is_directory(path))
+	{
+		ze::logger::error("Failed to open file {}: is a directory", path.string());
+		return nullptr;
+	}
+
+	/** Files are truncated unless appending, the content is committed when the streambuf is synced */
+	std::vector<uint8_t> data;
+	if (Buffer existing_data = find_file(path))
+	{
+		if (flags & FileWriteFlagBits::Append)
+		{
+			data = *existing_data;
+		}
+		else if (!(flags & FileWriteFlagBits::ReplaceExisting))
+		{
+			ze::logger::error("Failed to open file {}: file already exists", path.string());
+			return nullptr;
+		}
+	}
+
+	return new MemoryWriteStreamBuf(*this, path, max_size, std::move(data));
+}
+
+MappedRegion MemoryFileSystem::map(const std::filesystem::path& path, const MapAccessHint& hint)
+{
+	Buffer data = find_file(path);
+	if (!data)
+		return {};
+
+	const std::span<const uint8_t> view(*data);
+	return MappedRegion(view, std::move(data));
+}
+
+bool MemoryFileSystem::iterate_directories(const std::filesystem::path& path,
+	const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags)
+{
+	if (!iterator)
+		return false;
+
+	const std::string directory = normalize_virtual_path(path);
+	const std::string prefix = directory.empty() ? directory : directory + "/";
+	const bool recursive = static_cast<bool>(flags & IterateDirectoriesFlagBits::Recursive);
+
+	/** Entries are collected first so the iterator can modify the file system */
+	std::vector<std::filesystem::path> entries;
+	{
+		std::shared_lock lock(mutex);
+		auto directory_it = nodes.find(directory);
+		if (directory_it == nodes.end() || directory_it->second.data)
+			return false;
+
+		for (auto it = nodes.lower_bound(prefix); it != nodes.end() && it->first.starts_with(prefix); ++it)
+		{
+			const std::string_view relative_path = std::string_view(it->first).substr(prefix.size());
+			if (relative_path.empty())
+				continue;
+
+			if (recursive || relative_path.find('/') == std::string_view::npos)
+				entries.emplace_back(relative_path);
+		}
+	}
+
+	for (const auto& entry : entries)
+		iterator.execute(DirectoryEntry(entry));
+
+	return true;
+}
+
+bool MemoryFileSystem::exists(const std::filesystem::path& path)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::shared_lock lock(mutex);
+	return nodes.contains(normalized_path);
+}
+
+bool MemoryFileSystem::is_directory(const std::filesystem::path& path)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::shared_lock lock(mutex);
+	auto it = nodes.find(normalized_path);
+	return it != nodes.end() && !it->second.data;
+}
+
+FileAttributeFlags MemoryFileSystem::get_file_attributes(const std::filesystem::path& path) const
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::shared_lock lock(mutex);
+	auto it = nodes.find(normalized_path);
+	return it != nodes.end() ? it->second.attributes : FileAttributeFlags();
+}
+
+bool MemoryFileSystem::set_file_attributes(const std::filesystem::path& path, const FileAttributeFlags& in_flags)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::unique_lock lock(mutex);
+	auto it = nodes.find(normalized_path);
+	if (it == nodes.end())
+		return false;
+
+	it->second.attributes = in_flags;
+	return true;
+}
+
+bool MemoryFileSystem::add_parent_directories(const std::string& in_path)
+{
+	/** Directories created by this call, removed if a parent turns out to be a file */
+	std::vector<decltype(nodes)::iterator> created_directories;
+	for (size_t sep = in_path.find('/'); sep != std::string::npos; sep = in_path.find('/', sep + 1))
+	{
+		auto [it, inserted] = nodes.try_emplace(in_path.substr(0, sep));
+		if (inserted)
+		{
+			created_directories.emplace_back(it);
+		}
+		else if (it->second.data)
+		{
+			for (const auto& directory : created_directories)
+				nodes.erase(directory);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool MemoryFileSystem::add_file(const std::filesystem::path& path, std::vector<uint8_t>&& in_data)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+	if (normalized_path.empty())
+		return false;
+
+	{
+		std::unique_lock lock(mutex);
+
+		auto it = nodes.find(normalized_path);
+		if (it != nodes.end() && !it->second.data)
+		{
+			ze::logger::error("Failed to write {}: is a directory", path.string());
+			return false;
+		}
+
+		const uint64_t previous_size = it != nodes.end() ? it->second.data->size() : 0;
+		const uint64_t new_used_size = used_size - previous_size + in_data.size();
+		if (max_size != 0 && new_used_size > max_size)
+		{
+			ze::logger::error("Failed to write {}: memory file system is full ({}/{} bytes)",
+				path.string(), used_size, max_size);
+			return false;
+		}
+
+		if (!add_parent_directories(normalized_path))
+		{
+			ze::logger::error("Failed to write {}: a parent is a file", path.string());
+			return false;
+		}
+
+		Node& node = nodes[normalized_path];
+		node.data = std::make_shared<const std::vector<uint8_t>>(std::move(in_data));
+		used_size = new_used_size;
+	}
+
+	/** The file may have been created */
+	invalidate_resolved_path(path);
+	return true;
+}
+
+bool MemoryFileSystem::add_directory(const std::filesystem::path& path)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+
+	std::unique_lock lock(mutex);
+	if (!add_parent_directories(normalized_path))
+		return false;
+
+	auto [it, inserted] = nodes.try_emplace(normalized_path);
+	return !it->second.data;
+}
+
+bool MemoryFileSystem::remove(const std::filesystem::path& path)
+{
+	const std::string normalized_path = normalize_virtual_path(path);
+	if (normalized_path.empty())
+	{
+		clear();
+		return true;
+	}
+
+	{
+		std::unique_lock lock(mutex);
+		auto it = nodes.find(normalized_path);
+		if (it == nodes.end())
+			return false;
+
+		if (it->second.data)
+		{
+			used_size -= it->second.data->size();
+			nodes.erase(it);
+		}
+		else
+		{
+			nodes.erase(it);
+
+			/** Siblings like "dir.txt" sort between "dir" and "dir/", so the range starts at the prefix */
+			const std::string prefix = normalized_path + "/";
+			auto first = nodes.lower_bound(prefix);
+			auto last = first;
+			while (last != nodes.end() && last->first.starts_with(prefix))
+			{
+				if (last->second.data)
+					used_size -= last->second.data->size();
+				++last;
+			}
+
+			nodes.erase(first, last);
+		}
+	}
+
+	/** Resolved paths of a removed directory content are stale too */
+	clear_resolve_cache();
+	return true;
+}
+
+void MemoryFileSystem::clear()
+{
+	{
+		std::unique_lock lock(mutex);
+		nodes.clear();
+		nodes.insert({ "", Node() });
+		used_size = 0;
+	}
+
+	clear_resolve_cache();
+}
+
+uint64_t MemoryFileSystem::get_used_size() const
+{
+	std::shared_lock lock(mutex);
+	return used_size;
+}
+
+}
@@ -0,0 +1,136 @@
+#include "zefs/MountTable.h"
+#include <algorithm>
+#include <iterator>
+
+namespace ze::filesystem
+{
+
+MountTable::MountTable(const std::vector<Mount>& in_mounts)
+{
+	/** Mount indices of each node, including the ones inherited from shorter aliases */
+	std::vector<std::vector<size_t>> node_mounts(1);
+	std::vector<uint32_t> parents(1, invalid_node);
+	nodes.emplace_back();
+
+	for (size_t i = 0; i < in_mounts.size(); ++i)
+	{
+		const StringType& alias = in_mounts[i].alias.native();
+
+		/** "/" is the root alias and matches every path */
+		uint32_t node = 0;
+		if (in_mounts[i].alias != "/")
+		{
+			for (const auto& c : alias)
+			{
+				uint32_t child = find_child(node, c);
+				if (child == invalid_node)
+				{
+					child = static_cast<uint32_t>(nodes.size());
+					nodes[node].children.emplace_back(c, child);
+					nodes.emplace_back();
+					node_mounts.emplace_back();
+					parents.emplace_back(node);
+				}
+
+				node = child;
+			}
+		}
+
+		node_mounts[node].emplace_back(i);
+	}
+
+	/** Children are always created after their parent, so parents are already resolved */
+	for (size_t i = 1; i < nodes.size(); ++i)
+	{
+		std::vector<size_t> merged_mounts;
+		std::merge(node_mounts[parents[i]].begin(), node_mounts[parents[i]].end(),
+			node_mounts[i].begin(), node_mounts[i].end(), std::back_inserter(merged_mounts));
+		node_mounts[i] = std::move(merged_mounts);
+	}
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		nodes[i].filesystems.reserve(node_mounts[i].size());
+		for (const size_t mount : node_mounts[i])
+			nodes[i].filesystems.emplace_back(in_mounts[mount].filesystem);
+	}
+}
+
+uint32_t MountTable::find_child(const uint32_t in_node, const StringType::value_type in_char) const
+{
+	for (const auto& [c, child] : nodes[in_node].children)
+		if (c == in_char)
+			return child;
+
+	return invalid_node;
+}
+
+std::span<FileSystem* const> MountTable::find(const std::filesystem::path& in_path) const
+{
+	uint32_t node = 0;
+	for (const auto& c : in_path.native())
+	{
+		const uint32_t child = find_child(node, c);
+		if (child == invalid_node)
+			break;
+
+		node = child;
+	}
+
+	return nodes[node].filesystems;
+}
+
+ResolveCache::Shard& ResolveCache::get_shard(const MountTable::StringType& in_path)
+{
+	return shards[robin_hood::hash<MountTable::StringType>{}(in_path) % shard_count];
+}
+
+const ResolveCache::Shard& ResolveCache::get_shard(const MountTable::StringType& in_path) const
+{
+	return shards[robin_hood::hash<MountTable::StringType>{}(in_path) % shard_count];
+}
+
+bool ResolveCache::find(const MountTable::StringType& in_path, FileSystem*& out_filesystem) const
+{
+	const Shard& shard = get_shard(in_path);
+	std::scoped_lock lock(shard.mutex);
+	auto it = shard.entries.find(in_path);
+	if (it == shard.entries.end())
+		return false;
+
+	out_filesystem = it->second;
+	return true;
+}
+
+void ResolveCache::insert(const MountTable::StringType& in_path, FileSystem* in_filesystem, 
+	const uint64_t in_generation)
+{
+	Shard& shard = get_shard(in_path);
+	std::scoped_lock lock(shard.mutex);
+	if (in_generation != generation)
+		return;
+
+	if (shard.entries.size() >= max_entries_per_shard)
+		shard.entries.clear();
+
+	shard.entries[in_path] = in_filesystem;
+}
+
+void ResolveCache::erase(const MountTable::StringType& in_path)
+{
+	Shard& shard = get_shard(in_path);
+	std::scoped_lock lock(shard.mutex);
+	shard.entries.erase(in_path);
+}
+
+void ResolveCache::clear()
+{
+	generation++;
+	for (auto& shard : shards)
+	{
+		std::scoped_lock lock(shard.mutex);
+		shard.entries.clear();
+	}
+}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <robin_hood.h>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace ze::filesystem
+{
+
+class FileSystem;
+
+/**
+ * Prefix trie over filesystem aliases
+ * Each node stores every filesystem whose alias is a prefix of the node path, sorted by priority,
+ *	so a lookup is a walk along the path characters without any allocation
+ * The table is immutable, mount changes build a new one
+ */
+class MountTable
+{
+public:
+	using StringType = std::filesystem::path::string_type;
+
+	struct Mount
+	{
+		std::filesystem::path alias;
+		uint8_t priority;
+		FileSystem* filesystem;
+	};
+
+	/** in_mounts must be sorted by priority */
+	MountTable(const std::vector<Mount>& in_mounts);
+
+	/**
+	 * Get the filesystems whose alias is a prefix of in_path ("/" matches every path), sorted by priority
+	 * The span is valid as long as the table is alive
+	 */
+	std::span<FileSystem* const> find(const std::filesystem::path& in_path) const;
+private:
+	struct Node
+	{
+		std::vector<std::pair<StringType::value_type, uint32_t>> children;
+		std::vector<FileSystem*> filesystems;
+	};
+
+	static constexpr uint32_t invalid_node = std::numeric_limits<uint32_t>::max();
+
+	uint32_t find_child(const uint32_t in_node, const StringType::value_type in_char) const;
+private:
+	std::vector<Node> nodes;
+};
+
+/**
+ * Concurrent cache of path -> first filesystem (by priority) containing the path
+ * Paths that don't exist are cached too, with a null filesystem
+ */
+class ResolveCache
+{
+public:
+	static constexpr size_t shard_count = 16;
+
+	/** A full shard is cleared */
+	static constexpr size_t max_entries_per_shard = 4096;
+
+	ResolveCache() : generation(0) {}
+
+	/**
+	 * \return false if the path is not cached
+	 */
+	bool find(const MountTable::StringType& in_path, FileSystem*& out_filesystem) const;
+
+	/** Entries resolved before a clear (in_generation != current generation) are dropped */
+	void insert(const MountTable::StringType& in_path, FileSystem* in_filesystem, const uint64_t in_generation);
+	void erase(const MountTable::StringType& in_path);
+	void clear();
+
+	ZE_FORCEINLINE uint64_t get_generation() const { return generation; }
+private:
+	struct alignas(64) Shard
+	{
+		mutable std::mutex mutex;
+		robin_hood::unordered_map<MountTable::StringType, FileSystem*> entries;
+	};
+
+	Shard& get_shard(const MountTable::StringType& in_path);
+	const Shard& get_shard(const MountTable::StringType& in_path) const;
+private:
+	std::atomic_uint64_t generation;
+	std::array<Shard, shard_count> shards;
+};
+
+}
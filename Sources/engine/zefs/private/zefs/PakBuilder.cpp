@@ -0,0 +1,175 @@
+#include "zefs/PakBuilder.h"
+#include "zefs/PakFileSystem.h"
+#include "compression/BlockCompression.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace ze::filesystem
+{
+
+struct PakBuildFile
+{
+	std::filesystem::path path;
+	std::string pak_path;
+};
+
+/** Pad the stream with zeros up to the next multiple of in_alignment */
+uint64_t align_stream(std::ofstream& in_stream, const uint64_t in_offset, const uint64_t in_alignment)
+{
+	static constexpr char zeros[256] = {};
+
+	uint64_t padding = (in_alignment - (in_offset % in_alignment)) % in_alignment;
+	const uint64_t aligned_offset = in_offset + padding;
+	while (padding > 0)
+	{
+		const uint64_t count = std::min<uint64_t>(padding, sizeof(zeros));
+		in_stream.write(zeros, static_cast<std::streamsize>(count));
+		padding -= count;
+	}
+
+	return aligned_offset;
+}
+
+bool build_pak(const std::filesystem::path& in_directory, const std::filesystem::path& in_pak_path,
+	const PakBuildSettings& in_settings, PakBuildStats* out_stats)
+{
+	ZE_CHECK(in_settings.alignment > 0 && (in_settings.alignment & (in_settings.alignment - 1)) == 0);
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(in_directory, error))
+	{
+		ze::logger::error("Failed to build pack {}: {} is not a directory", in_pak_path.string(),
+			in_directory.string());
+		return false;
+	}
+
+	std::vector<PakBuildFile> files;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(in_directory))
+	{
+		if (!entry.is_regular_file())
+			continue;
+
+		PakBuildFile file;
+		file.path = entry.path();
+		file.pak_path = normalize_pak_path(std::filesystem::relative(entry.path(), in_directory));
+		if (file.pak_path.size() > std::numeric_limits<uint16_t>::max())
+		{
+			ze::logger::error("Failed to build pack {}: path {} is too long", in_pak_path.string(),
+				file.pak_path);
+			return false;
+		}
+
+		files.emplace_back(std::move(file));
+	}
+
+	/** Store data in path order so files of a same directory are close */
+	std::sort(files.begin(), files.end(),
+		[](const PakBuildFile& left, const PakBuildFile& right) { return left.pak_path < right.pak_path; });
+
+	/** Lookups only use the hash, so colliding paths can't be stored */
+	robin_hood::unordered_map<uint64_t, const PakBuildFile*> hashes;
+	hashes.reserve(files.size());
+	for (const auto& file : files)
+	{
+		auto [it, inserted] = hashes.insert({ hash_pak_path(file.pak_path), &file });
+		if (!inserted)
+		{
+			ze::logger::error("Failed to build pack {}: {} and {} have the same pack path hash",
+				in_pak_path.string(), it->second->path.string(), file.path.string());
+			return false;
+		}
+	}
+
+	std::ofstream stream(in_pak_path, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open())
+	{
+		ze::logger::error("Failed to open pack {} for writing", in_pak_path.string());
+		return false;
+	}
+
+	PakHeader header = {};
+	header.magic = PakHeader::magic_value;
+	header.version = PakHeader::current_version;
+	header.entry_count = static_cast<uint32_t>(files.size());
+	header.alignment = in_settings.alignment;
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	PakBuildStats stats;
+	std::vector<PakEntry> entries;
+	entries.reserve(files.size());
+	std::string strings;
+	uint64_t offset = sizeof(PakHeader);
+	for (const auto& file : files)
+	{
+		MappedRegion region = MappedRegion::map_file(file.path, MapAccessHint::Sequential);
+		if (!region)
+		{
+			ze::logger::error("Failed to build pack {}: can't read {}", in_pak_path.string(), file.path.string());
+			return false;
+		}
+
+		PakEntry entry = {};
+		entry.path_hash = hash_pak_path(file.pak_path);
+		entry.uncompressed_size = region.get_size();
+		entry.path_offset = static_cast<uint32_t>(strings.size());
+		entry.path_size = static_cast<uint16_t>(file.pak_path.size());
+		strings += file.pak_path;
+
+		/** Already block-compressed assets would not compress further */
+		std::vector<uint8_t> compressed_data;
+		std::span<const uint8_t> data = region.get_span();
+		if (in_settings.compress && !region.empty() && !compression::is_block_compressed(data))
+		{
+			compressed_data = compression::compress_blocks(data);
+			const double saving = 1.0 - static_cast<double>(compressed_data.size()) / data.size();
+			if (saving >= in_settings.min_compression_saving)
+			{
+				data = compressed_data;
+				entry.flags = static_cast<uint16_t>(PakEntryFlagBits::Compressed);
+				stats.compressed_entry_count++;
+			}
+		}
+
+		offset = align_stream(stream, offset, in_settings.alignment);
+		entry.offset = offset;
+		entry.size = data.size();
+		stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		offset += data.size();
+
+		stats.uncompressed_size += entry.uncompressed_size;
+		entries.emplace_back(entry);
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const PakEntry& left, const PakEntry& right) { return left.path_hash < right.path_hash; });
+
+	offset = align_stream(stream, offset, alignof(PakEntry));
+	header.toc_offset = offset;
+	stream.write(reinterpret_cast<const char*>(entries.data()),
+		static_cast<std::streamsize>(entries.size() * sizeof(PakEntry)));
+	offset += entries.size() * sizeof(PakEntry);
+
+	header.strings_offset = offset;
+	header.strings_size = strings.size();
+	stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+	offset += strings.size();
+
+	stream.seekp(0);
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	stream.close();
+	if (stream.fail())
+	{
+		ze::logger::error("Failed to write pack {}", in_pak_path.string());
+		return false;
+	}
+
+	stats.entry_count = header.entry_count;
+	stats.pak_size = offset;
+	if (out_stats)
+		*out_stats = stats;
+
+	return true;
+}
+
+}
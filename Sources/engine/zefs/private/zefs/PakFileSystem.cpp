@@ -0,0 +1,203 @@
+#include "zefs/PakFileSystem.h"
+#include "zefs/RegionStreamBuf.h"
+#include "zefs/VirtualPath.h"
+#include "compression/BlockCompression.h"
+
+namespace ze::filesystem
+{
+
+std::string normalize_pak_path(const std::filesystem::path& in_path)
+{
+	return normalize_virtual_path(in_path);
+}
+
+PakFileSystem::PakFileSystem(const std::string& in_alias,
+	const uint8_t& in_priority, const std::filesystem::path& in_pak_path) : FileSystem(in_alias,
+		in_priority), pak_path(in_pak_path)
+{
+	MappedRegion region = MappedRegion::map_file(pak_path, MapAccessHint::Random);
+	if (!region)
+	{
+		ze::logger::error("Failed to open pack {}", pak_path.string());
+		return;
+	}
+
+	if (region.get_size() < sizeof(PakHeader))
+	{
+		ze::logger::error("Invalid pack {}: too small", pak_path.string());
+		return;
+	}
+
+	const PakHeader* header = reinterpret_cast<const PakHeader*>(region.get_data());
+	if (header->magic != PakHeader::magic_value || header->version != PakHeader::current_version)
+	{
+		ze::logger::error("Invalid pack {}: bad magic or unsupported version", pak_path.string());
+		return;
+	}
+
+	/** Offsets come from the file, compare against the remaining size so the checks can't overflow */
+	const uint64_t toc_size = static_cast<uint64_t>(header->entry_count) * sizeof(PakEntry);
+	if (header->toc_offset % alignof(PakEntry) != 0 ||
+		header->toc_offset > region.get_size() || toc_size > region.get_size() - header->toc_offset ||
+		header->strings_offset > region.get_size() ||
+		header->strings_size > region.get_size() - header->strings_offset)
+	{
+		ze::logger::error("Invalid pack {}: corrupted table of contents", pak_path.string());
+		return;
+	}
+
+	entries = std::span<const PakEntry>(
+		reinterpret_cast<const PakEntry*>(region.get_data() + header->toc_offset), header->entry_count);
+	strings = std::string_view(reinterpret_cast<const char*>(region.get_data() + header->strings_offset),
+		header->strings_size);
+
+	entry_map.reserve(entries.size());
+	directories.insert(std::string_view());
+	for (uint32_t i = 0; i < entries.size(); ++i)
+	{
+		const PakEntry& entry = entries[i];
+		if (entry.offset > region.get_size() || entry.size > region.get_size() - entry.offset ||
+			static_cast<uint64_t>(entry.path_offset) + entry.path_size > strings.size())
+		{
+			ze::logger::error("Invalid pack {}: corrupted entry {}", pak_path.string(), i);
+			entries = {};
+			strings = {};
+			entry_map.clear();
+			directories.clear();
+			return;
+		}
+
+		entry_map.insert({ entry.path_hash, i });
+
+		/** Register every parent directory */
+		const std::string_view path = get_entry_path(entry);
+		for (size_t sep = path.find('/'); sep != std::string_view::npos; sep = path.find('/', sep + 1))
+			directories.insert(path.substr(0, sep));
+	}
+
+	pak = std::make_shared<MappedRegion>(std::move(region));
+	ze::logger::verbose("Mounted pack {} ({} entries)", pak_path.string(), entries.size());
+}
+
+std::string_view PakFileSystem::get_entry_path(const PakEntry& in_entry) const
+{
+	return strings.substr(in_entry.path_offset, in_entry.path_size);
+}
+
+const PakEntry* PakFileSystem::find_entry(const std::filesystem::path& path) const
+{
+	const std::string normalized_path = normalize_pak_path(path);
+	auto it = entry_map.find(hash_pak_path(normalized_path));
+	if (it == entry_map.end())
+		return nullptr;
+
+	/** Paths not in the pack could still collide with an entry hash */
+	const PakEntry& entry = entries[it->second];
+	if (!pak_path_equals(get_entry_path(entry), normalized_path))
+		return nullptr;
+
+	return &entry;
+}
+
+MappedRegion PakFileSystem::get_entry_data(const PakEntry& in_entry) const
+{
+	std::span<const uint8_t> data(pak->get_data() + in_entry.offset, in_entry.size);
+	if (PakEntryFlags(static_cast<PakEntryFlagBits>(in_entry.flags)) & PakEntryFlagBits::Compressed)
+	{
+		std::vector<uint8_t> uncompressed_data;
+		if (!compression::decompress_blocks(data, uncompressed_data) ||
+			uncompressed_data.size() != in_entry.uncompressed_size)
+		{
+			ze::logger::error("Failed to decompress {} from pack {}", get_entry_path(in_entry),
+				pak_path.string());
+			return {};
+		}
+
+		return MappedRegion(std::move(uncompressed_data));
+	}
+
+	/** Stored entries are views into the pack mapping */
+	return MappedRegion(data, pak);
+}
+
+OwnerPtr<std::streambuf> PakFileSystem::read(const std::filesystem::path& path, const FileReadFlags& flags)
+{
+	if (!pak)
+		return nullptr;
+
+	const PakEntry* entry = find_entry(path);
+	if (!entry)
+		return nullptr;
+
+	MappedRegion region = get_entry_data(*entry);
+	if (!region)
+		return nullptr;
+
+	return new RegionStreamBuf(std::move(region),
+		static_cast<bool>(flags & FileReadFlagBits::End));
+}
+
+MappedRegion PakFileSystem::map(const std::filesystem::path& path, const MapAccessHint& hint)
+{
+	if (!pak)
+		return {};
+
+	const PakEntry* entry = find_entry(path);
+	if (!entry)
+		return {};
+
+	MappedRegion region = get_entry_data(*entry);
+	if (region.is_mapped())
+		region.advise(hint);
+
+	return region;
+}
+
+bool PakFileSystem::iterate_directories(const std::filesystem::path& path,
+	const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags)
+{
+	if (!iterator || !is_directory(path))
+		return false;
+
+	const std::string directory = normalize_pak_path(path);
+	const std::string prefix = directory.empty() ? directory : directory + "/";
+	const bool recursive = static_cast<bool>(flags & IterateDirectoriesFlagBits::Recursive);
+
+	/** Directories are implicit, so report each of them only once */
+	robin_hood::unordered_set<std::string_view, PakPathHash, PakPathEqual> visited_directories;
+	for (const auto& entry : entries)
+	{
+		const std::string_view entry_path = get_entry_path(entry);
+		if (entry_path.size() < prefix.size() || !pak_path_equals(entry_path.substr(0, prefix.size()), prefix))
+			continue;
+
+		const std::string_view relative_path = entry_path.substr(prefix.size());
+		for (size_t sep = relative_path.find('/'); sep != std::string_view::npos;
+			sep = relative_path.find('/', sep + 1))
+		{
+			const std::string_view sub_directory = relative_path.substr(0, sep);
+			if (visited_directories.insert(sub_directory).second)
+				iterator.execute(DirectoryEntry(std::filesystem::path(sub_directory)));
+
+			if (!recursive)
+				break;
+		}
+
+		if (recursive || relative_path.find('/') == std::string_view::npos)
+			iterator.execute(DirectoryEntry(std::filesystem::path(relative_path)));
+	}
+
+	return true;
+}
+
+bool PakFileSystem::exists(const std::filesystem::path& path)
+{
+	return find_entry(path) || is_directory(path);
+}
+
+bool PakFileSystem::is_directory(const std::filesystem::path& path)
+{
+	return directories.contains(std::string_view(normalize_pak_path(path)));
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "zefs/MappedRegion.h"
+#include <streambuf>
+
+namespace ze::filesystem
+{
+
+/**
+ * Read-only streambuf over a region, used to serve files that already are in memory without copying them
+ */
+class RegionStreamBuf final : public std::streambuf
+{
+public:
+	RegionStreamBuf(MappedRegion&& in_region, const bool in_end) : region(std::move(in_region))
+	{
+		char* begin = const_cast<char*>(reinterpret_cast<const char*>(region.get_data()));
+		char* end = begin + region.get_size();
+		setg(begin, in_end ? end : begin, end);
+	}
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		if (!(which & std::ios_base::in))
+			return pos_type(off_type(-1));
+
+		off_type base = 0;
+		if (dir == std::ios_base::cur)
+			base = gptr() - eback();
+		else if (dir == std::ios_base::end)
+			base = egptr() - eback();
+
+		const off_type pos = base + off;
+		if (pos < 0 || pos > egptr() - eback())
+			return pos_type(off_type(-1));
+
+		setg(eback(), eback() + pos, egptr());
+		return pos_type(pos);
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+
+	std::streamsize showmanyc() override
+	{
+		return egptr() - gptr();
+	}
+private:
+	MappedRegion region;
+};
+
+}
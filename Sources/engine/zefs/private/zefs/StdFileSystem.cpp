@@ -45,6 +45,8 @@ OwnerPtr<std::streambuf> StdFileSystem::write(const std::filesystem::path& path,
 	uint32_t wflags = std::ios::out;
 	if (flags & FileWriteFlagBits::Binary)
 		wflags |= std::ios::binary;
+	if (flags & FileWriteFlagBits::Append)
+		wflags |= std::ios::app;
 
 	/** On hidden files for some reason it fails.. */
 	FileAttributeFlags attribs = get_file_attributes(path);
@@ -73,6 +75,33 @@ OwnerPtr<std::streambuf> StdFileSystem::write(const std::filesystem::path& path,
 	return file;
 }
 
+MappedRegion StdFileSystem::map(const std::filesystem::path& path, const MapAccessHint& hint)
+{
+	std::filesystem::path correct_path = get_correct_path(path);
+
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(correct_path, error);
+	if (!error && size >= map_min_size)
+	{
+		MappedRegion region = MappedRegion::map_file(correct_path, hint);
+		if (region)
+			return region;
+
+		ze::logger::warn("Failed to map file {}, reading it instead", path.string());
+	}
+
+	return FileSystem::map(path, hint);
+}
+
+std::filesystem::path StdFileSystem::get_native_path(const std::filesystem::path& path)
+{
+	std::filesystem::path correct_path = get_correct_path(path);
+	if (!std::filesystem::exists(correct_path))
+		return {};
+
+	return correct_path;
+}
+
 bool StdFileSystem::iterate_directories(const std::filesystem::path& path,
 	const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags)
 {
@@ -0,0 +1,32 @@
+#include "zefs/VirtualPath.h"
+
+namespace ze::filesystem
+{
+
+std::string normalize_virtual_path(const std::filesystem::path& in_path)
+{
+	std::string path = in_path.lexically_normal().generic_string();
+
+	size_t start = 0;
+	while (start < path.size())
+	{
+		if (path[start] == '/')
+			start++;
+		else if (path.compare(start, 2, "./") == 0)
+			start += 2;
+		else
+			break;
+	}
+
+	size_t end = path.size();
+	while (end > start && path[end - 1] == '/')
+		end--;
+
+	path = path.substr(start, end - start);
+	if (path == ".")
+		path.clear();
+
+	return path;
+}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace ze::filesystem
+{
+
+/**
+ * Normalize a path for lookups in in-memory file tables (packs, memory file systems)
+ * Generic separators, no leading ./ or /, no trailing /, the root is an empty string
+ */
+std::string normalize_virtual_path(const std::filesystem::path& in_path);
+
+}
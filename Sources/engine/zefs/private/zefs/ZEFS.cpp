@@ -1,6 +1,7 @@
 #include "EngineCore.h"
 #include "zefs/ZEFS.h"
-#include <map>
+#include "zefs/MountTable.h"
+#include <algorithm>
 #include "module/Module.h"
 
 ZE_DEFINE_MODULE(ze::module::DefaultModule, zefs);
@@ -17,38 +18,77 @@ struct FSEntry
 	FSEntry() : priority(0) {}
 	FSEntry(const std::string& in_name, const std::string& in_alias,
 		const uint8_t& in_priority) : name(in_name), priority(in_priority), alias(in_alias) {}
-
-	bool operator<(const FSEntry& other) const
-	{
-		return priority < other.priority;
-	}
 };
 
-/** Sorted map of all file systems */
-std::map<FSEntry, std::unique_ptr<FileSystem>> filesystems;
+/** All file systems, sorted by priority. File systems with the same priority keep their mount order */
+std::vector<std::pair<FSEntry, std::unique_ptr<FileSystem>>> filesystems;
+std::mutex filesystems_mutex;
+
+/** Alias lookup table, rebuilt when a file system is added. Readers hold a reference while using it */
+std::atomic<std::shared_ptr<const MountTable>> mount_table = 
+	std::make_shared<const MountTable>(std::vector<MountTable::Mount>());
+
+/** Cache of the file system containing each resolved path, cleared on mount changes */
+ResolveCache resolve_cache;
+#if ZE_WITH_EDITOR
+std::atomic_bool resolve_cache_enabled = false;
+#else
+std::atomic_bool resolve_cache_enabled = true;
+#endif
 
 /** Ref to the writer file system, if specified.
  * Defaults to the first added that is not read only */
 FileSystem* write_fs = nullptr;
 
+/**
+ * File systems that has a matching alias inside the path, keeps the mount table alive
+ */
+struct MatchingFileSystems
+{
+	std::shared_ptr<const MountTable> table;
+	std::span<FileSystem* const> filesystems;
+
+	ZE_FORCEINLINE auto begin() const { return filesystems.begin(); }
+	ZE_FORCEINLINE auto end() const { return filesystems.end(); }
+};
+
 /**
  * Get filesystems that has a matching alias inside the path
  */
-std::vector<FileSystem*> get_filesystems_matching_alias(const std::filesystem::path& path)
+MatchingFileSystems get_filesystems_matching_alias(const std::filesystem::path& path)
 {
-	std::vector<FileSystem*> r_filesystems;
-	r_filesystems.reserve(2);
+	std::shared_ptr<const MountTable> table = mount_table.load(std::memory_order_acquire);
+	const std::span<FileSystem* const> r_filesystems = table->find(path);
+	return { std::move(table), r_filesystems };
+}
 
-	for (const auto& [entry, fs] : filesystems)
+/**
+ * Get the first file system containing the path
+ * @return nullptr if the path doesn't exist
+ */
+FileSystem* resolve(const std::filesystem::path& path, const MatchingFileSystems& in_filesystems)
+{
+	const bool use_cache = resolve_cache_enabled;
+	const uint64_t generation = resolve_cache.get_generation();
+
+	FileSystem* resolved_fs = nullptr;
+	if (use_cache && resolve_cache.find(path.native(), resolved_fs))
+		return resolved_fs;
+
+	for (FileSystem* fs : in_filesystems)
 	{
-		if (entry.alias == "/" ||
-			path.string().rfind(entry.alias, 0) == 0)
+		if (fs->exists(path))
 		{
-			r_filesystems.emplace_back(fs.get());
+			resolved_fs = fs;
+			break;
 		}
 	}
 
-	return r_filesystems;
+	/** Misses aren't cached, a file created outside of zefs would stay invisible until the next clear */
+	if (use_cache && resolved_fs)
+		resolve_cache.insert(path.native(), resolved_fs, generation);
+
+	return resolved_fs;
 }
 
 /**
@@ -58,9 +98,7 @@ std::vector<FileSystem*> get_filesystems_matching_alias(const std::filesystem::p
 template<typename Lambda>
 bool execute(const std::filesystem::path& path, Lambda&& lambda)
 {
-	std::vector<FileSystem*> r_filesystems = get_filesystems_matching_alias(path);
-
-	for (const auto& fs : r_filesystems)
+	for (FileSystem* fs : get_filesystems_matching_alias(path))
 	{
 		if (lambda(fs))
 			return true;
@@ -72,9 +110,7 @@ bool execute(const std::filesystem::path& path, Lambda&& lambda)
 template<typename Ret, typename Lambda>
 Ret execute(const std::filesystem::path& path, Lambda&& lambda)
 {
-	std::vector<FileSystem*> r_filesystems = get_filesystems_matching_alias(path);
-
-	for (const auto& fs : r_filesystems)
+	for (FileSystem* fs : get_filesystems_matching_alias(path))
 	{
 		return lambda(fs);
 	}
@@ -83,8 +119,6 @@ Ret execute(const std::filesystem::path& path, Lambda&& lambda)
 template<typename Ret, bool write = false, typename Lambda>
 Ret execute_ptr(const std::filesystem::path& path, Lambda&& lambda)
 {
-	std::vector<FileSystem*> r_filesystems = get_filesystems_matching_alias(path);
-
 	if constexpr(write)
 	{
 		if (write_fs)
@@ -92,7 +126,16 @@ Ret execute_ptr(const std::filesystem::path& path, Lambda&& lambda)
 	}
 	else
 	{
-		for (const auto& fs : r_filesystems)
+		const MatchingFileSystems r_filesystems = get_filesystems_matching_alias(path);
+
+		/** Only ask the file system containing the file */
+		if (resolve_cache_enabled)
+		{
+			FileSystem* fs = resolve(path, r_filesystems);
+			return fs ? lambda(fs) : nullptr;
+		}
+
+		for (FileSystem* fs : r_filesystems)
 		{
 			Ret ptr = lambda(fs);
 			if (ptr)
@@ -116,12 +159,12 @@ OwnerPtr<std::streambuf> read(const std::filesystem::path& path,
 OwnerPtr<std::streambuf> write(const std::filesystem::path& path,
 	const FileWriteFlags& flags)
 {
-	return execute_ptr<OwnerPtr<std::streambuf>, true>(path,
+	OwnerPtr<std::streambuf> buffer = execute_ptr<OwnerPtr<std::streambuf>, true>(path,
 		[path, flags](FileSystem* fs) -> OwnerPtr<std::streambuf>
 		{
 			if (fs->exists(path))
 			{
-				if (!(flags & FileWriteFlagBits::ReplaceExisting))
+				if (!(flags & (FileWriteFlagBits::ReplaceExisting | FileWriteFlagBits::Append)))
 				{
 					ze::logger::error("Can't write to file {}: file already exists",
 						path.string());
@@ -131,15 +174,42 @@ OwnerPtr<std::streambuf> write(const std::filesystem::path& path,
 
 			return fs->write(path, flags);
 		});
+
+	/** The file may have been created */
+	if (buffer)
+		resolve_cache.erase(path.native());
+
+	return buffer;
+}
+
+MappedRegion map(const std::filesystem::path& path, const MapAccessHint& hint)
+{
+	const MatchingFileSystems r_filesystems = get_filesystems_matching_alias(path);
+	if (resolve_cache_enabled)
+	{
+		FileSystem* fs = resolve(path, r_filesystems);
+		return fs ? fs->map(path, hint) : MappedRegion();
+	}
+
+	for (FileSystem* fs : r_filesystems)
+	{
+		MappedRegion region = fs->map(path, hint);
+		if (region)
+			return region;
+	}
+
+	return {};
+}
+
+std::filesystem::path get_native_path(const std::filesystem::path& path)
+{
+	FileSystem* fs = resolve(path, get_filesystems_matching_alias(path));
+	return fs ? fs->get_native_path(path) : std::filesystem::path();
 }
 
 bool exists(const std::filesystem::path& path)
 {
-	return execute(path,
-		[path](FileSystem* fs) -> bool
-		{
-			return fs->exists(path);
-		});
+	return resolve(path, get_filesystems_matching_alias(path)) != nullptr;
 }
 
 bool is_directory(const std::filesystem::path& path)
@@ -186,11 +256,41 @@ void set_write_fs(FileSystem& fs)
 	write_fs = &fs;
 }
 
+void set_resolve_cache_enabled(const bool in_enabled)
+{
+	resolve_cache_enabled = in_enabled;
+	resolve_cache.clear();
+}
+
+void clear_resolve_cache()
+{
+	resolve_cache.clear();
+}
+
+void invalidate_resolved_path(const std::filesystem::path& path)
+{
+	if (!path.empty())
+		resolve_cache.erase(path.native());
+}
+
 FileSystem& add_filesystem(const std::string& name, const std::string& alias,
 	const uint8_t& priority, OwnerPtr<FileSystem> fs)
 {
-	filesystems.insert({ FSEntry(name, alias, priority),
-		std::unique_ptr<FileSystem>(fs) });
+	{
+		std::scoped_lock lock(filesystems_mutex);
+
+		auto it = std::upper_bound(filesystems.begin(), filesystems.end(), priority,
+			[](const uint8_t& in_priority, const auto& in_entry) { return in_priority < in_entry.first.priority; });
+		filesystems.insert(it, { FSEntry(name, alias, priority), std::unique_ptr<FileSystem>(fs) });
+
+		std::vector<MountTable::Mount> mounts;
+		mounts.reserve(filesystems.size());
+		for (const auto& [entry, filesystem] : filesystems)
+			mounts.push_back({ entry.alias, entry.priority, filesystem.get() });
+
+		mount_table.store(std::make_shared<const MountTable>(mounts), std::memory_order_release);
+		resolve_cache.clear();
+	}
 
 	ze::logger::info("Added new filesystem {} (alias {}/{})", 
 		name,
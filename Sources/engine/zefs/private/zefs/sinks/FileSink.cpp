@@ -13,6 +13,10 @@ void FileSink::log(const logger::Message& message)
 	std::string msg = format(message);
 
 	stream << msg;
+}
+
+void FileSink::flush()
+{
 	stream.flush();
 }
 
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/**
+ * Asynchronous file reads
+ * Reads are submitted in batches and executed without blocking job system workers:
+ *	- Linux: io_uring, for files backed by an OS file
+ *	- Other platforms and non-OS files (e.g packed files): a small pool of dedicated I/O threads
+ * When every read of a batch is done, its callback is scheduled as a job
+ */
+namespace ze::filesystem::asyncio
+{
+
+enum class Backend
+{
+	/** Dedicated I/O threads doing blocking reads */
+	ThreadPool,
+
+	/** Linux io_uring, files that are not OS files still go through the thread pool */
+	IoUring,
+};
+
+struct Settings
+{
+	/** Max io_uring reads in flight, other reads are queued until a slot is free */
+	uint32_t queue_depth;
+
+	/** Thread count of the thread pool backend, each thread has one read in flight */
+	uint32_t thread_count;
+
+	/** Use io_uring if the kernel supports it */
+	bool use_io_uring;
+
+	Settings() : queue_depth(64), thread_count(2), use_io_uring(true) {}
+};
+
+struct ReadRequest
+{
+	/** zefs path of the file */
+	std::filesystem::path path;
+	uint64_t offset;
+
+	/** Destination, must stay valid until the batch is completed */
+	std::span<uint8_t> buffer;
+
+	/** Set once the read is done, can be less than the buffer size if the end of the file is reached */
+	uint64_t bytes_read;
+	bool succeeded;
+
+	ReadRequest(const std::filesystem::path& in_path, const uint64_t in_offset,
+		std::span<uint8_t> in_buffer) : path(in_path), offset(in_offset), buffer(in_buffer),
+		bytes_read(0), succeeded(false) {}
+};
+
+/**
+ * A group of reads completed together
+ */
+class ZEFS_API ReadBatch
+{
+	friend class Service;
+	friend struct PendingRead;
+
+public:
+	using OnCompleted = std::function<void(const ReadBatch&)>;
+
+	ReadBatch(std::vector<ReadRequest>&& in_requests, OnCompleted&& in_on_completed);
+
+	/** True once every read is done, the callback may still be pending */
+	ZE_FORCEINLINE bool is_completed() const { return completed; }
+
+	/** True if any read failed, only valid once completed */
+	ZE_FORCEINLINE bool has_failed() const { return failed; }
+
+	ZE_FORCEINLINE std::span<const ReadRequest> get_requests() const { return requests; }
+
+	/** Block the calling thread until every read is done */
+	void wait() const;
+private:
+	std::vector<ReadRequest> requests;
+	OnCompleted on_completed;
+	std::atomic_size_t pending;
+	std::atomic_bool completed;
+	std::atomic_bool failed;
+	mutable std::mutex mutex;
+	mutable std::condition_variable condition_var;
+
+	/** OS files opened for this batch, closed when completed */
+	std::vector<int> files;
+};
+using ReadBatchPtr = std::shared_ptr<ReadBatch>;
+
+struct Stats
+{
+	uint64_t submitted_reads;
+	uint64_t completed_reads;
+	uint64_t failed_reads;
+	uint64_t bytes_read;
+	uint32_t in_flight;
+	uint32_t max_in_flight;
+
+	/** Reads waiting for a free slot */
+	uint32_t queued;
+
+	/** Time since the stats were reset, in seconds */
+	double elapsed;
+
+	Stats() : submitted_reads(0), completed_reads(0), failed_reads(0), bytes_read(0),
+		in_flight(0), max_in_flight(0), queued(0), elapsed(0.0) {}
+
+	ZE_FORCEINLINE double get_iops() const
+	{
+		return elapsed > 0.0 ? completed_reads / elapsed : 0.0;
+	}
+
+	/** MiB read per second */
+	ZE_FORCEINLINE double get_throughput() const
+	{
+		return elapsed > 0.0 ? (bytes_read / (1024.0 * 1024.0)) / elapsed : 0.0;
+	}
+};
+
+/**
+ * Start the I/O service, called automatically with the default settings on the first submit
+ * \return false if the service is already running
+ */
+ZEFS_API bool initialize(const Settings& in_settings = {});
+
+/** Wait for the reads in flight and stop the I/O threads */
+ZEFS_API void shutdown();
+
+ZEFS_API Backend get_backend();
+
+/**
+ * Submit a batch of reads
+ * \param in_on_completed Scheduled as a job once every read is done (called directly if the job system isn't running)
+ */
+ZEFS_API ReadBatchPtr submit(std::vector<ReadRequest>&& in_requests,
+	ReadBatch::OnCompleted&& in_on_completed = {});
+
+ZEFS_API Stats get_stats();
+ZEFS_API void reset_stats();
+
+}
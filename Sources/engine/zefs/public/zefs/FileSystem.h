@@ -2,6 +2,7 @@
 
 #include "EngineCore.h"
 #include "delegates/Delegate.h"
+#include "MappedRegion.h"
 #include <filesystem>
 
 namespace ze::filesystem
@@ -31,6 +32,9 @@ enum class FileWriteFlagBits
 
 	ReplaceExisting = 1 << 0,
 	Binary = 1 << 1,
+
+	/** Write at the end of the existing file instead of truncating it */
+	Append = 1 << 2,
 };
 ENABLE_FLAG_ENUMS(FileWriteFlagBits, FileWriteFlags);
 
@@ -73,6 +77,20 @@ public:
 
 	virtual OwnerPtr<std::streambuf> read(const std::filesystem::path& path, const FileReadFlags& flags) = 0;
 	virtual OwnerPtr<std::streambuf> write(const std::filesystem::path& path, const FileWriteFlags& flags) = 0;
+
+	/**
+	 * Get a read-only view of a whole file
+	 * The default implementation reads the file into a buffer, filesystems that can map files should override it
+	 * \return An invalid region if the file can't be read
+	 */
+	virtual MappedRegion map(const std::filesystem::path& path, const MapAccessHint& hint);
+
+	/**
+	 * Get the path of a file or directory on the OS filesystem, used to read it without going through a streambuf
+	 * \return An empty path if the file doesn't exist or isn't backed by an OS file (e.g packed files)
+	 */
+	virtual std::filesystem::path get_native_path(const std::filesystem::path& path) { return {}; }
+
 	virtual bool iterate_directories(const std::filesystem::path& path,
 		const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags) = 0;
 	virtual bool exists(const std::filesystem::path& path) = 0;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "flags/Flags.h"
+#include <filesystem>
+#include <functional>
+
+/**
+ * Directory watching
+ * Linux uses inotify, other platforms poll the watched directories
+ */
+namespace ze::filesystem
+{
+
+enum class FileWatchEventType
+{
+	Created,
+	Modified,
+	Deleted,
+
+	/** Renamed or moved inside the watched directory, old_path is set */
+	Renamed,
+
+	/** Events were lost, path is the watched directory and must be rescanned */
+	Overflowed,
+};
+
+struct FileWatchEvent
+{
+	FileWatchEventType type;
+
+	/** zefs path (watched path / relative path) */
+	std::filesystem::path path;
+	std::filesystem::path old_path;
+	bool is_directory;
+
+	FileWatchEvent(const FileWatchEventType in_type, const std::filesystem::path& in_path,
+		const bool in_is_directory) : type(in_type), path(in_path), is_directory(in_is_directory) {}
+};
+
+enum class FileWatchFlagBits
+{
+	None = 0,
+
+	/** Also watch sub directories, including the ones created later */
+	Recursive = 1 << 0,
+};
+ENABLE_FLAG_ENUMS(FileWatchFlagBits, FileWatchFlags);
+
+using FileWatchCallback = std::function<void(const FileWatchEvent&)>;
+using FileWatchHandle = uint32_t;
+static constexpr FileWatchHandle invalid_file_watch_handle = 0;
+
+/**
+ * Watch a directory for changes
+ * Only directories backed by an OS directory can be watched (not packed files)
+ * The callback is called from the watcher thread, in the order of the events
+ * \return invalid_file_watch_handle if the directory can't be watched
+ */
+ZEFS_API FileWatchHandle watch(const std::filesystem::path& path, FileWatchCallback&& callback,
+	const FileWatchFlags& flags = FileWatchFlagBits::Recursive);
+
+/** Stop watching, the callback won't be called once this returns */
+ZEFS_API void unwatch(const FileWatchHandle handle);
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace ze::filesystem
+{
+
+/**
+ * Expected access pattern of a mapped region, forwarded to the OS (madvise) to tune readahead
+ */
+enum class MapAccessHint
+{
+	Normal,
+
+	/** Read from start to end, aggressive readahead */
+	Sequential,
+
+	/** Random accesses, no readahead */
+	Random,
+};
+
+/**
+ * A read-only view of a whole file
+ * Filesystems that support it map the file in memory, others read it into an owned buffer
+ * The data stays valid as long as the region is alive
+ */
+class ZEFS_API MappedRegion
+{
+public:
+	MappedRegion() : data(nullptr), size(0), mapping(nullptr), mapping_size(0), valid(false) {}
+
+	/** Fallback region owning a copy of the file */
+	MappedRegion(std::vector<uint8_t>&& in_buffer) : data(nullptr), size(0), mapping(nullptr), mapping_size(0),
+		buffer(std::move(in_buffer)), valid(true)
+	{
+		data = buffer.data();
+		size = buffer.size();
+	}
+
+	/** View into memory owned by another object (e.g a range of a mapped pack file) */
+	MappedRegion(std::span<const uint8_t> in_view, std::shared_ptr<const void> in_owner) : data(in_view.data()),
+		size(in_view.size()), mapping(nullptr), mapping_size(0), owner(std::move(in_owner)), valid(true) {}
+
+	~MappedRegion();
+
+	MappedRegion(MappedRegion&& other) noexcept;
+	MappedRegion& operator=(MappedRegion&& other) noexcept;
+
+	MappedRegion(const MappedRegion&) = delete;
+	MappedRegion& operator=(const MappedRegion&) = delete;
+
+	/**
+	 * Map a file in memory
+	 * \return An empty region if the file can't be mapped
+	 */
+	static MappedRegion map_file(const std::filesystem::path& in_path, const MapAccessHint in_hint);
+
+	/** Hint the expected access pattern for the whole region, only for mapped regions */
+	void advise(const MapAccessHint in_hint) const;
+
+	/** Ask the OS to start reading a range in the background */
+	void prefetch(const size_t in_offset, const size_t in_size) const;
+
+	ZE_FORCEINLINE const uint8_t* get_data() const { return data; }
+	ZE_FORCEINLINE size_t get_size() const { return size; }
+	ZE_FORCEINLINE std::span<const uint8_t> get_span() const { return { data, size }; }
+	ZE_FORCEINLINE bool empty() const { return size == 0; }
+
+	/** True if the data is mapped from the file, false if it is an owned copy */
+	ZE_FORCEINLINE bool is_mapped() const { return mapping != nullptr || owner != nullptr; }
+
+	ZE_FORCEINLINE bool is_valid() const { return valid; }
+	ZE_FORCEINLINE explicit operator bool() const { return valid; }
+private:
+	void unmap();
+private:
+	const uint8_t* data;
+	size_t size;
+
+	/** OS mapping, null for fallback regions */
+	void* mapping;
+	size_t mapping_size;
+	std::vector<uint8_t> buffer;
+
+	/** Keeps the memory of views alive */
+	std::shared_ptr<const void> owner;
+	bool valid;
+};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "FileSystem.h"
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace ze::filesystem
+{
+
+/**
+ * Thread-safe file system storing everything in RAM
+ * Stored buffers are immutable and shared, reads and maps are views over them and stay valid
+ *	after the file is overwritten or removed
+ * Written files are committed when the write streambuf is synced or destroyed, writing to an existing file
+ *	requires ReplaceExisting (truncate) or Append
+ */
+class ZEFS_API MemoryFileSystem final : public FileSystem
+{
+public:
+	/**
+	 * \param in_max_size Max number of bytes stored, 0 for no limit
+	 */
+	MemoryFileSystem(const std::string& in_alias,
+		const uint8_t& in_priority, const uint64_t in_max_size = 0);
+
+	OwnerPtr<std::streambuf> read(const std::filesystem::path& path, const FileReadFlags& flags) override;
+	OwnerPtr<std::streambuf> write(const std::filesystem::path& path, const FileWriteFlags& flags) override;
+	MappedRegion map(const std::filesystem::path& path, const MapAccessHint& hint) override;
+
+	bool iterate_directories(const std::filesystem::path& path,
+		const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags) override;
+
+	bool exists(const std::filesystem::path& path) override;
+	bool is_directory(const std::filesystem::path& path) override;
+
+	bool is_read_only() const override { return false; }
+	FileAttributeFlags get_file_attributes(const std::filesystem::path& path) const override;
+	bool set_file_attributes(const std::filesystem::path& path, const FileAttributeFlags& in_flags) override;
+
+	/**
+	 * Store a file, replacing any existing one, parent directories are created
+	 * \return false if the path is a directory or the size limit would be exceeded
+	 */
+	bool add_file(const std::filesystem::path& path, std::vector<uint8_t>&& in_data);
+
+	/** Create a directory and its parents */
+	bool add_directory(const std::filesystem::path& path);
+
+	/** Remove a file, or a directory and everything inside it */
+	bool remove(const std::filesystem::path& path);
+	void clear();
+
+	ZE_FORCEINLINE uint64_t get_max_size() const { return max_size; }
+	uint64_t get_used_size() const;
+private:
+	using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+	struct Node
+	{
+		/** Null for directories */
+		Buffer data;
+		FileAttributeFlags attributes;
+	};
+
+	Buffer find_file(const std::filesystem::path& path) const;
+
+	/** Must be called with the mutex locked */
+	bool add_parent_directories(const std::string& in_path);
+private:
+	mutable std::shared_mutex mutex;
+
+	/** Normalized path -> node, ordered so a directory content is a contiguous range */
+	std::map<std::string, Node, std::less<>> nodes;
+	uint64_t max_size;
+	uint64_t used_size;
+};
+
+}
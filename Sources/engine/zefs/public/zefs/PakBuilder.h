@@ -0,0 +1,41 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <filesystem>
+
+namespace ze::filesystem
+{
+
+struct PakBuildSettings
+{
+	/** Alignment of each entry data in the pack, must be a power of two */
+	uint32_t alignment;
+
+	/** Block-compress entries */
+	bool compress;
+
+	/** Entries are stored uncompressed if compression doesn't save at least this fraction of the size */
+	double min_compression_saving;
+
+	PakBuildSettings() : alignment(64), compress(true), min_compression_saving(0.1) {}
+};
+
+struct PakBuildStats
+{
+	uint32_t entry_count;
+	uint32_t compressed_entry_count;
+	uint64_t uncompressed_size;
+	uint64_t pak_size;
+
+	PakBuildStats() : entry_count(0), compressed_entry_count(0), uncompressed_size(0), pak_size(0) {}
+};
+
+/**
+ * Build a pack file containing every file of in_directory, see PakFileSystem.h for the layout
+ * Entry paths are relative to in_directory
+ * \return false if a file couldn't be read, two paths collide or the pack couldn't be written
+ */
+ZEFS_API bool build_pak(const std::filesystem::path& in_directory, const std::filesystem::path& in_pak_path,
+	const PakBuildSettings& in_settings = {}, PakBuildStats* out_stats = nullptr);
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "FileSystem.h"
+#include "MappedRegion.h"
+#include <robin_hood.h>
+#include <string_view>
+
+namespace ze::filesystem
+{
+
+/**
+ * Pack file layout:
+ *	[PakHeader][entry data, each entry aligned to PakHeader::alignment][PakEntry * entry_count][path strings]
+ * The table of contents is sorted by path hash
+ */
+struct PakHeader
+{
+	static constexpr uint64_t magic_value = 0x3130304B4150455A; /** "ZEPAK001" */
+	static constexpr uint32_t current_version = 1;
+
+	uint64_t magic;
+	uint32_t version;
+	uint32_t entry_count;
+	uint64_t toc_offset;
+	uint64_t strings_offset;
+	uint64_t strings_size;
+	uint32_t alignment;
+	uint32_t padding;
+};
+static_assert(sizeof(PakHeader) == 48);
+
+enum class PakEntryFlagBits : uint16_t
+{
+	None = 0,
+
+	/** Entry is a block-compressed stream (see compression/BlockCompression.h) */
+	Compressed = 1 << 0,
+};
+ENABLE_FLAG_ENUMS(PakEntryFlagBits, PakEntryFlags);
+
+struct PakEntry
+{
+	uint64_t path_hash;
+	uint64_t offset;
+
+	/** Size stored in the pack */
+	uint64_t size;
+	uint64_t uncompressed_size;
+
+	/** Path in the string table */
+	uint32_t path_offset;
+	uint16_t path_size;
+	uint16_t flags;
+};
+static_assert(sizeof(PakEntry) == 40);
+
+/**
+ * Normalize a path for pack lookups: generic separators, no leading ./ or /
+ * The case is kept, lookups are case-insensitive
+ */
+ZEFS_API std::string normalize_pak_path(const std::filesystem::path& in_path);
+
+constexpr char fold_pak_path_char(const char in_char)
+{
+	return in_char >= 'A' && in_char <= 'Z' ? static_cast<char>(in_char - 'A' + 'a') : in_char;
+}
+
+/** FNV-1a of a normalized path, ASCII case is folded so the hash is case-insensitive */
+constexpr uint64_t hash_pak_path(const std::string_view& in_path)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for(const char& c : in_path)
+	{
+		hash ^= static_cast<uint8_t>(fold_pak_path_char(c));
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/** Case-insensitive comparison of two normalized paths */
+constexpr bool pak_path_equals(const std::string_view& in_left, const std::string_view& in_right)
+{
+	if(in_left.size() != in_right.size())
+		return false;
+
+	for(size_t i = 0; i < in_left.size(); ++i)
+		if(fold_pak_path_char(in_left[i]) != fold_pak_path_char(in_right[i]))
+			return false;
+
+	return true;
+}
+
+struct PakPathHash
+{
+	size_t operator()(const std::string_view& in_path) const { return hash_pak_path(in_path); }
+};
+
+struct PakPathEqual
+{
+	bool operator()(const std::string_view& in_left, const std::string_view& in_right) const
+	{
+		return pak_path_equals(in_left, in_right);
+	}
+};
+
+/**
+ * Read-only file system backed by a single pack file
+ * The pack is mapped once when mounted, lookups are hash map lookups and don't do any syscall
+ * Uncompressed entries are served as views into the mapping
+ */
+class ZEFS_API PakFileSystem final : public FileSystem
+{
+public:
+	PakFileSystem(const std::string& in_alias,
+		const uint8_t& in_priority, const std::filesystem::path& in_pak_path);
+
+	OwnerPtr<std::streambuf> read(const std::filesystem::path& path, const FileReadFlags& flags) override;
+	OwnerPtr<std::streambuf> write(const std::filesystem::path& path, const FileWriteFlags& flags) override { return nullptr; }
+	MappedRegion map(const std::filesystem::path& path, const MapAccessHint& hint) override;
+
+	bool iterate_directories(const std::filesystem::path& path,
+		const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags) override;
+
+	bool exists(const std::filesystem::path& path) override;
+	bool is_directory(const std::filesystem::path& path) override;
+
+	bool is_read_only() const override { return true; }
+	FileAttributeFlags get_file_attributes(const std::filesystem::path& path) const override { return {}; }
+	bool set_file_attributes(const std::filesystem::path& path, const FileAttributeFlags& in_flags) override { return false; }
+
+	/** False if the pack couldn't be opened or is invalid */
+	ZE_FORCEINLINE bool is_valid() const { return pak != nullptr; }
+	ZE_FORCEINLINE size_t get_entry_count() const { return entries.size(); }
+private:
+	const PakEntry* find_entry(const std::filesystem::path& path) const;
+	std::string_view get_entry_path(const PakEntry& in_entry) const;
+	MappedRegion get_entry_data(const PakEntry& in_entry) const;
+private:
+	std::filesystem::path pak_path;
+	std::shared_ptr<MappedRegion> pak;
+	std::span<const PakEntry> entries;
+	std::string_view strings;
+
+	/** Path hash -> entry index */
+	robin_hood::unordered_flat_map<uint64_t, uint32_t> entry_map;
+
+	/** Every directory containing an entry, views into the string table */
+	robin_hood::unordered_flat_set<std::string_view, PakPathHash, PakPathEqual> directories;
+};
+
+}
@@ -13,12 +13,19 @@ namespace ze::filesystem
 class ZEFS_API StdFileSystem final : public FileSystem
 {
 public:
+	/** Below this size, reading a file is cheaper than mapping it */
+	static constexpr size_t map_min_size = 64 * 1024;
+
 	StdFileSystem(const std::string& in_alias,
 		const uint8_t& in_priority, const std::string& in_root);
 
 	OwnerPtr<std::streambuf> read(const std::filesystem::path& path, const FileReadFlags& flags) override;
 	OwnerPtr<std::streambuf> write(const std::filesystem::path& path, const FileWriteFlags& flags) override;
 
+	/** Files bigger than map_min_size are mapped, smaller ones are read */
+	MappedRegion map(const std::filesystem::path& path, const MapAccessHint& hint) override;
+	std::filesystem::path get_native_path(const std::filesystem::path& path) override;
+
 	bool iterate_directories(const std::filesystem::path& path,
 		const DirectoryIterator& iterator, const IterateDirectoriesFlags& flags) override;
 
@@ -43,6 +43,20 @@ ZEFS_API OwnerPtr<std::streambuf> write(const std::filesystem::path& path,
 	const FileWriteFlags& flags = FileWriteFlagBits::None); 
 
 
+/**
+ * Get a read-only view of a whole file, mapped in memory when the filesystem supports it
+ * Prefer this over read() for large immutable files (cooked data, packs...) as it avoids copying through stream buffers
+ * @return An invalid region if the file can't be read
+ */
+ZEFS_API MappedRegion map(const std::filesystem::path& path,
+	const MapAccessHint& hint = MapAccessHint::Normal);
+
+/**
+ * Get the OS path of a file or directory, resolved by the first filesystem containing it
+ * @return An empty path if the file doesn't exist or isn't backed by an OS file
+ */
+ZEFS_API std::filesystem::path get_native_path(const std::filesystem::path& path);
+
 /**
  * ***************************************
  *			Directory manipulation
@@ -63,6 +77,19 @@ ZEFS_API bool iterate_directories(const std::filesystem::path& path,
 /** Set the current write file system */
 ZEFS_API void set_write_fs(FileSystem& fs);
 
+/**
+ * Enable the cache of resolved paths, only paths that exist are cached
+ * Files deleted without going through zefs are still reported while it is enabled,
+ *	it is disabled by default in editor builds
+ */
+ZEFS_API void set_resolve_cache_enabled(const bool in_enabled);
+
+/** Clear the resolved paths cache, e.g after files were modified without going through zefs */
+ZEFS_API void clear_resolve_cache();
+
+/** Forget the resolved filesystem of a single path */
+ZEFS_API void invalidate_resolved_path(const std::filesystem::path& path);
+
 FileAttributeFlags get_file_attributes(const std::filesystem::path& path);
 bool set_file_attributes(const std::filesystem::path& path, const FileAttributeFlags& in_flags);
 
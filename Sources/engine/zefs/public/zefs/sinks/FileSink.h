@@ -18,6 +18,7 @@ public:
 		const std::string& in_filename);
 
 	void log(const logger::Message& InMessage) override;
+	void flush() override;
 private:
 	std::string filename;
 	FileOStream stream;
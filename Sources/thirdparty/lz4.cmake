@@ -0,0 +1,10 @@
+FetchContent_Declare(lz4
+    GIT_REPOSITORY https://github.com/lz4/lz4.git
+    GIT_TAG v1.9.4
+    SOURCE_SUBDIR build/cmake)
+set(LZ4_BUILD_CLI OFF CACHE BOOL "" FORCE)
+set(LZ4_BUILD_LEGACY_LZ4C OFF CACHE BOOL "" FORCE)
+set(LZ4_POSITION_INDEPENDENT_LIB ON CACHE BOOL "" FORCE)
+FetchContent_MakeAvailable(lz4)
+
+target_include_directories(lz4_static INTERFACE ${lz4_SOURCE_DIR}/lib)
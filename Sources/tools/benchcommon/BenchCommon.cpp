@@ -0,0 +1,24 @@
+#include "BenchCommon.h"
+
+namespace ze::bench
+{
+
+std::string_view parse_command_line_arg(const std::string_view& in_arg)
+{
+	const size_t id = in_arg.find('=');
+	return id == std::string_view::npos ? std::string_view() : in_arg.substr(id + 1);
+}
+
+bool parse_settings_arg(const std::string_view& in_arg, Settings& out_settings)
+{
+	if(in_arg.starts_with("-MinTime="))
+		out_settings.min_time = std::stod(std::string(parse_command_line_arg(in_arg)));
+	else if(in_arg.starts_with("-Filter="))
+		out_settings.filter = parse_command_line_arg(in_arg);
+	else
+		return false;
+
+	return true;
+}
+
+}
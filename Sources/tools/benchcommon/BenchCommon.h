@@ -0,0 +1,77 @@
+#pragma once
+
+#include "EngineCore.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <string_view>
+
+/**
+ * Helpers shared by the headless benchmarks (ecsbench, serializationbench)
+ */
+namespace ze::bench
+{
+
+struct Settings
+{
+	/** Minimum time spent on each benchmark, in seconds. The best pass is kept */
+	double min_time;
+
+	/** Minimum number of passes of each benchmark */
+	size_t min_passes;
+
+	/** Only run benchmarks whose name contains this string */
+	std::string filter;
+
+	Settings(const double in_min_time) : min_time(in_min_time), min_passes(3) {}
+
+	ZE_FORCEINLINE bool is_filtered_out(const std::string& in_name) const
+	{
+		return !filter.empty() && in_name.find(filter) == std::string::npos;
+	}
+};
+
+struct PassTiming
+{
+	/** Duration of the fastest pass, in seconds */
+	double best_time;
+
+	/** Value returned by the last pass */
+	uint64_t count;
+};
+
+/**
+ * Run in_pass until both the minimum time and the minimum pass count are reached, keep the fastest pass
+ * \param in_pass Function running one pass and returning what it processed (bytes, operations...)
+ */
+template<typename Func>
+PassTiming measure(const Settings& in_settings, Func&& in_pass)
+{
+	using Clock = std::chrono::steady_clock;
+
+	PassTiming timing = { std::numeric_limits<double>::max(), 0 };
+	size_t passes = 0;
+	const auto start = Clock::now();
+	do
+	{
+		const auto pass_start = Clock::now();
+		timing.count = in_pass();
+		timing.best_time = std::min(timing.best_time, std::chrono::duration<double>(Clock::now() - pass_start).count());
+		passes++;
+	} while(passes < in_settings.min_passes ||
+		std::chrono::duration<double>(Clock::now() - start).count() < in_settings.min_time);
+
+	return timing;
+}
+
+/** Value of a -Name=Value argument */
+BENCHCOMMON_API std::string_view parse_command_line_arg(const std::string_view& in_arg);
+
+/**
+ * Parse the arguments every benchmark accepts: -MinTime=<seconds> -Filter=<string>
+ * \return false if the argument is not one of them
+ */
+BENCHCOMMON_API bool parse_settings_arg(const std::string_view& in_arg, Settings& out_settings);
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "engine/ecs/Component.h"
+#include "BenchComponents.gen.h"
+
+/**
+ * Components used by the ECS benchmark
+ */
+namespace ze::ecsbench
+{
+
+ZSTRUCT()
+struct BenchPosition : public Component
+{
+	ZE_REFL_BODY()
+
+	float x;
+	float y;
+	float z;
+
+	BenchPosition() : x(0.f), y(0.f), z(0.f) {}
+};
+
+ZSTRUCT()
+struct BenchVelocity : public Component
+{
+	ZE_REFL_BODY()
+
+	float x;
+	float y;
+	float z;
+
+	BenchVelocity() : x(1.f), y(0.f), z(0.f) {}
+};
+
+ZSTRUCT()
+struct BenchHealth : public Component
+{
+	ZE_REFL_BODY()
+
+	int32_t health;
+	int32_t max_health;
+
+	BenchHealth() : health(100), max_health(100) {}
+};
+
+/** Empty component toggled to flag entities */
+ZSTRUCT()
+struct BenchTag : public Component
+{
+	ZE_REFL_BODY()
+};
+
+}
@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+#include "BenchComponents.h"
+#include "engine/ecs/ComponentManager.h"
+#include "reflection/Class.h"
+#include <random>
+
+namespace ze::ecsbench
+{
+
+/**
+ * Time a benchmark, see bench::measure
+ * \param in_pass Function returning the number of components added or removed
+ */
+template<typename Func>
+void measure(const BenchmarkSettings& in_settings, const std::string& in_name, Func&& in_pass,
+	std::vector<BenchmarkResult>& out_results)
+{
+	if(in_settings.is_filtered_out(in_name))
+		return;
+
+	const bench::PassTiming timing = bench::measure(in_settings, std::forward<Func>(in_pass));
+
+	BenchmarkResult result;
+	result.name = in_name;
+	result.operations = timing.count;
+	result.ms_per_pass = timing.best_time * 1e3;
+	result.ns_per_operation = timing.count > 0 ? (timing.best_time * 1e9) / static_cast<double>(timing.count) : 0.0;
+	out_results.emplace_back(std::move(result));
+}
+
+/** Register entities 1..in_count with a position and a velocity */
+void spawn(ComponentManager& in_manager, const size_t in_count)
+{
+	for(size_t i = 1; i <= in_count; ++i)
+	{
+		const Entity entity(i);
+		in_manager.register_entity(entity);
+		in_manager.add_component<BenchPosition>(entity);
+		in_manager.add_component<BenchVelocity>(entity);
+	}
+}
+
+std::vector<BenchmarkResult> run_benchmarks(const BenchmarkSettings& in_settings)
+{
+	std::vector<BenchmarkResult> results;
+
+	const size_t count = in_settings.entity_count;
+	const reflection::Class* velocity_class = reflection::Class::get<BenchVelocity>();
+	const reflection::Class* health_class = reflection::Class::get<BenchHealth>();
+	const reflection::Class* tag_class = reflection::Class::get<BenchTag>();
+
+	/** Every component goes through the empty -> Position -> Position + Velocity transitions */
+	measure(in_settings, "Spawn", [&]()
+	{
+		ComponentManager manager;
+		spawn(manager, count);
+		return static_cast<uint64_t>(count * 2);
+	}, results);
+
+	ComponentManager manager;
+	spawn(manager, count);
+
+	/** Flag then unflag every entity */
+	measure(in_settings, "ToggleTag", [&]()
+	{
+		for(size_t i = 1; i <= count; ++i)
+			manager.add_component<BenchTag>(Entity(i));
+
+		for(size_t i = 1; i <= count; ++i)
+			manager.remove_component(Entity(i), tag_class);
+
+		return static_cast<uint64_t>(count * 2);
+	}, results);
+
+	/** Same as ToggleTag but entities come back in reverse order, so each removal moves another entity */
+	measure(in_settings, "ToggleTagReverse", [&]()
+	{
+		for(size_t i = 1; i <= count; ++i)
+			manager.add_component<BenchTag>(Entity(i));
+
+		for(size_t i = count; i >= 1; --i)
+			manager.remove_component(Entity(i), tag_class);
+
+		return static_cast<uint64_t>(count * 2);
+	}, results);
+
+	/** Swap the velocity for health and back, going through four archetypes */
+	measure(in_settings, "AlternateTypes", [&]()
+	{
+		for(size_t i = 1; i <= count; ++i)
+		{
+			manager.add_component<BenchHealth>(Entity(i));
+			manager.remove_component(Entity(i), velocity_class);
+		}
+
+		for(size_t i = 1; i <= count; ++i)
+		{
+			manager.add_component<BenchVelocity>(Entity(i));
+			manager.remove_component(Entity(i), health_class);
+		}
+
+		return static_cast<uint64_t>(count * 4);
+	}, results);
+
+	/** Toggle the tag of random entities, entities picked several times go back and forth */
+	std::vector<size_t> random_entities(count);
+	{
+		std::mt19937_64 random(42);
+		std::uniform_int_distribution<size_t> distribution(1, count);
+		for(auto& entity : random_entities)
+			entity = distribution(random);
+	}
+
+	measure(in_settings, "ToggleTagRandom", [&]()
+	{
+		for(const size_t entity : random_entities)
+		{
+			if(manager.has_component(Entity(entity), tag_class))
+				manager.remove_component(Entity(entity), tag_class);
+			else
+				manager.add_component<BenchTag>(Entity(entity));
+		}
+
+		return static_cast<uint64_t>(count);
+	}, results);
+
+	return results;
+}
+
+void report(const std::vector<BenchmarkResult>& in_results)
+{
+	fmt::print("{:<24} {:>12} {:>12} {:>12}\n", "Benchmark", "Operations", "ms/pass", "ns/op");
+	for(const auto& result : in_results)
+		fmt::print("{:<24} {:>12} {:>12.3f} {:>12.1f}\n", result.name, result.operations, result.ms_per_pass,
+			result.ns_per_operation);
+}
+
+}
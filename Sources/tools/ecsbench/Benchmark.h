@@ -0,0 +1,39 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "BenchCommon.h"
+#include <string>
+#include <vector>
+
+/**
+ * Headless ECS benchmark
+ * Spawns entities in a ComponentManager and moves them between archetypes by adding and removing components
+ */
+namespace ze::ecsbench
+{
+
+struct BenchmarkSettings : bench::Settings
+{
+	/** Entities spawned by each benchmark */
+	size_t entity_count;
+
+	BenchmarkSettings() : bench::Settings(0.5), entity_count(100000) {}
+};
+
+struct BenchmarkResult
+{
+	std::string name;
+
+	/** Components added or removed by a pass */
+	uint64_t operations;
+	double ms_per_pass;
+	double ns_per_operation;
+
+	BenchmarkResult() : operations(0), ms_per_pass(0.0), ns_per_operation(0.0) {}
+};
+
+ECSBENCH_API std::vector<BenchmarkResult> run_benchmarks(const BenchmarkSettings& in_settings);
+
+ECSBENCH_API void report(const std::vector<BenchmarkResult>& in_results);
+
+}
@@ -0,0 +1,29 @@
+#include "Benchmark.h"
+#include "logger/Logger.h"
+#include "logger/sinks/StdSink.h"
+#include <string_view>
+
+/**
+ * ECS benchmark
+ * Usage: ZEECSBench [-Entities=<count>] [-MinTime=<seconds>] [-Filter=<string>]
+ */
+
+int main(int argc, char** argv)
+{
+	using namespace ze::ecsbench;
+
+	ze::logger::add_sink(std::make_unique<ze::logger::StdSink>("Std"));
+
+	BenchmarkSettings settings;
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if(arg.starts_with("-Entities="))
+			settings.entity_count = std::stoull(std::string(ze::bench::parse_command_line_arg(arg)));
+		else
+			ze::bench::parse_settings_arg(arg, settings);
+	}
+
+	report(run_benchmarks(settings));
+	return 0;
+}
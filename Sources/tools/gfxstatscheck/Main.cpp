@@ -0,0 +1,123 @@
+#include "EngineCore.h"
+#include "NullBackend.h"
+#include "gfx/Gfx.h"
+#include "logger/Logger.h"
+#include "logger/sinks/StdSink.h"
+
+/**
+ * Checks the gfx frame counters against a null backend
+ * Usage:
+ *	ZEGfxStatsCheck
+ * Returns 1 if a counter of the last frame doesn't match the commands that were recorded
+ */
+
+using namespace ze::gfx;
+
+using ExpectedStats = std::vector<std::pair<DeviceCounter, uint64_t>>;
+
+bool check_stats(const std::string_view& in_frame, const DeviceStats& in_stats, const ExpectedStats& in_expected)
+{
+	bool success = true;
+	for(const auto& [counter, value] : in_expected)
+	{
+		if(in_stats.get(counter) != value)
+		{
+			ze::logger::error("{}: expected {} {}, got {}", in_frame, value,
+				get_device_counter_name(counter), in_stats.get(counter));
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void bind_pipeline(CommandList* in_list, const DeviceResourceHandle& in_layout)
+{
+	in_list->bind_pipeline_layout(in_layout);
+	in_list->set_pipeline_render_pass_state(GfxPipelineRenderPassState {});
+	in_list->set_pipeline_instance_state(GfxPipelineInstanceState {});
+}
+
+int main()
+{
+	ze::logger::add_sink(std::make_unique<ze::logger::StdSink>("Std"));
+
+	BackendInfo info("Null", "", ShaderLanguage::SPIRV, { ShaderModel::ShaderModel6_0 });
+	NullBackend backend(&info);
+	Device device;
+	device.new_frame();
+
+	auto [layout_result, layout] = device.create_pipeline_layout(PipelineLayoutCreateInfo(
+		{
+			DescriptorSetLayoutCreateInfo(
+				{
+					DescriptorSetLayoutBinding(0, DescriptorType::UniformBuffer, 1, ShaderStageFlagBits::Vertex)
+				})
+		}));
+	auto [ubo_result, ubo] = device.create_buffer(BufferInfo::make_ubo(64));
+	auto [other_ubo_result, other_ubo] = device.create_buffer(BufferInfo::make_ubo(64));
+
+	/** First frame: every lookup misses once, then the same state and descriptors must hit */
+	{
+		CommandList* list = device.allocate_cmd_list(CommandListType::Gfx);
+		bind_pipeline(list, layout);
+		list->bind_ubo(0, 0, ubo);
+		list->draw(3, 1, 0, 0);
+		list->draw(3, 1, 0, 0);
+		list->bind_ubo(0, 0, ubo);
+		list->draw(3, 1, 0, 0);
+		list->bind_ubo(0, 0, other_ubo);
+		list->draw_indexed(3, 1, 0, 0, 0);
+		device.submit(list);
+		device.end_frame();
+		device.new_frame();
+	}
+
+	bool success = check_stats("Frame 1", device.get_last_frame_stats(),
+		{
+			{ DeviceCounter::Draws, 4 },
+			{ DeviceCounter::PipelineBinds, 1 },
+			{ DeviceCounter::PipelineCacheHits, 3 },
+			{ DeviceCounter::PipelineCacheMisses, 1 },
+			{ DeviceCounter::DescriptorSetAllocations, 2 },
+			{ DeviceCounter::DescriptorSetCacheHits, 1 },
+			{ DeviceCounter::Barriers, 0 },
+			{ DeviceCounter::BytesUploaded, 0 },
+			{ DeviceCounter::ResourcesCreated, 3 },
+			{ DeviceCounter::ResourcesDestroyed, 0 },
+		});
+
+	/** Second frame: counters start from zero and everything comes from the caches */
+	{
+		CommandList* list = device.allocate_cmd_list(CommandListType::Gfx);
+		bind_pipeline(list, layout);
+		list->bind_ubo(0, 0, ubo);
+		list->draw(3, 1, 0, 0);
+		device.submit(list);
+		device.destroy_buffer(other_ubo);
+		device.end_frame();
+		device.new_frame();
+	}
+
+	success &= check_stats("Frame 2", device.get_last_frame_stats(),
+		{
+			{ DeviceCounter::Draws, 1 },
+			{ DeviceCounter::PipelineBinds, 1 },
+			{ DeviceCounter::PipelineCacheHits, 1 },
+			{ DeviceCounter::PipelineCacheMisses, 0 },
+			{ DeviceCounter::DescriptorSetAllocations, 0 },
+			{ DeviceCounter::DescriptorSetCacheHits, 1 },
+			{ DeviceCounter::ResourcesCreated, 0 },
+			{ DeviceCounter::ResourcesDestroyed, 1 },
+		});
+
+	device.destroy_buffer(ubo);
+	device.destroy_pipeline_layout(layout);
+	device.destroy();
+
+	if(!success)
+		return 1;
+
+	ze::logger::info("Gfx stats check passed");
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "NullBackend.h"
+#include "gfx/Gfx.h"
+
+namespace ze::gfx
+{
+
+std::pair<Result, ResourceHandle> NullBackend::buffer_create(const BufferCreateInfo& in_create_info)
+{
+	ResourceHandle handle = make_handle();
+	buffers[handle.handle].resize(in_create_info.size);
+	return { Result::Success, handle };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::swapchain_create(const SwapChainCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::texture_create(const TextureCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::texture_view_create(const TextureViewCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::render_pass_create(const RenderPassCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::shader_create(const ShaderCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::gfx_pipeline_create(const GfxPipelineCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::pipeline_layout_create(const PipelineLayoutCreateInfo&)
+{
+	ResourceHandle handle = make_handle();
+	descriptor_sets[handle.handle];
+	return { Result::Success, handle };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::sampler_create(const SamplerCreateInfo&)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::fence_create(const bool)
+{
+	return { Result::Success, make_handle() };
+}
+
+std::pair<Result, ResourceHandle> NullBackend::semaphore_create()
+{
+	return { Result::Success, make_handle() };
+}
+
+void NullBackend::buffer_destroy(const ResourceHandle& in_handle)
+{
+	buffers.erase(in_handle.handle);
+}
+
+void NullBackend::pipeline_layout_destroy(const ResourceHandle& in_handle)
+{
+	descriptor_sets.erase(in_handle.handle);
+}
+
+ResourceHandle NullBackend::pipeline_layout_allocate_descriptor_set(const ResourceHandle& in_pipeline_layout,
+	const uint32_t in_set,
+	const std::vector<Descriptor>& descriptors,
+	bool& out_cache_hit)
+{
+	auto layout = descriptor_sets.find(in_pipeline_layout.handle);
+	ZE_CHECKF(layout != descriptor_sets.end(), "Invalid pipeline layout given to pipeline_layout_allocate_descriptor_set");
+
+	size_t hash = 0;
+	hash_combine(hash, in_set);
+	hash_combine(hash, descriptors);
+
+	auto set = layout->second.find(hash);
+	out_cache_hit = set != layout->second.end();
+	if(out_cache_hit)
+		return set->second;
+
+	ResourceHandle handle = make_handle();
+	layout->second.insert({ hash, handle });
+	return handle;
+}
+
+std::pair<Result, void*> NullBackend::buffer_map(const ResourceHandle& in_buffer)
+{
+	auto buffer = buffers.find(in_buffer.handle);
+	ZE_CHECKF(buffer != buffers.end(), "Invalid buffer given to buffer_map");
+	return { Result::Success, buffer->second.data() };
+}
+
+ResourceHandle NullBackend::command_pool_create()
+{
+	return make_handle();
+}
+
+std::vector<ResourceHandle> NullBackend::command_pool_allocate(const ResourceHandle&, const size_t in_count)
+{
+	std::vector<ResourceHandle> lists;
+	lists.reserve(in_count);
+	for(size_t i = 0; i < in_count; ++i)
+		lists.emplace_back(make_handle());
+	return lists;
+}
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "gfx/Backend.h"
+#include <robin_hood.h>
+
+namespace ze::gfx
+{
+
+/**
+ * A backend that records nothing and only hands out handles
+ * Descriptor sets are cached by their descriptors so the frontend cache counters can be checked without a GPU
+ */
+class NullBackend final : public Backend
+{
+public:
+	NullBackend(const BackendInfo* in_backend_info) : Backend(in_backend_info), next_handle(0) {}
+
+	void device_wait_idle() override {}
+	void new_frame() override {}
+	BackendFeatureFlags get_features() const override { return BackendFeatureFlags(); }
+
+	std::pair<Result, ResourceHandle> buffer_create(const BufferCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> swapchain_create(const SwapChainCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> texture_create(const TextureCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> texture_view_create(const TextureViewCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> render_pass_create(const RenderPassCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> shader_create(const ShaderCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> gfx_pipeline_create(const GfxPipelineCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> pipeline_layout_create(const PipelineLayoutCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> sampler_create(const SamplerCreateInfo& in_create_info) override;
+	std::pair<Result, ResourceHandle> fence_create(const bool in_is_signaled = false) override;
+
+	void buffer_destroy(const ResourceHandle& in_handle) override;
+	void texture_destroy(const ResourceHandle&) override {}
+	void texture_view_destroy(const ResourceHandle&) override {}
+	void swapchain_destroy(const ResourceHandle&) override {}
+	void fence_destroy(const ResourceHandle&) override {}
+	void semaphore_destroy(const ResourceHandle&) override {}
+	void command_pool_destroy(const ResourceHandle&) override {}
+	void shader_destroy(const ResourceHandle&) override {}
+	void render_pass_destroy(const ResourceHandle&) override {}
+	void pipeline_destroy(const ResourceHandle&) override {}
+	void pipeline_layout_destroy(const ResourceHandle& in_handle) override;
+	void sampler_destroy(const ResourceHandle&) override {}
+
+	ResourceHandle pipeline_layout_allocate_descriptor_set(const ResourceHandle& in_pipeline_layout,
+		const uint32_t in_set,
+		const std::vector<Descriptor>& descriptors,
+		bool& out_cache_hit) override;
+
+	/** Buffer */
+	std::pair<Result, void*> buffer_map(const ResourceHandle& in_buffer) override;
+	void buffer_unmap(const ResourceHandle&) override {}
+
+	/** Swap chain */
+	bool swapchain_acquire_image(const ResourceHandle&) override { return true; }
+	void swapchain_resize(const ResourceHandle&, const uint32_t, const uint32_t) override {}
+	ResourceHandle swapchain_get_backbuffer(const ResourceHandle&) override { return {}; }
+	ResourceHandle swapchain_get_backbuffer_texture(const ResourceHandle&) override { return {}; }
+	uint32_t swapchain_get_backbuffer_index(const ResourceHandle&) override { return 0; }
+	uint32_t swapchain_get_textures_count(const ResourceHandle&) override { return 0; }
+	std::vector<ResourceHandle> swapchain_get_backbuffer_textures(const ResourceHandle&) override { return {}; }
+	std::vector<ResourceHandle> swapchain_get_backbuffer_texture_views(const ResourceHandle&) override { return {}; }
+	void swapchain_present(const ResourceHandle&, const std::vector<ResourceHandle>&) override {}
+
+	/** Queues */
+	void queue_execute(const ResourceHandle&,
+		const std::vector<ResourceHandle>&,
+		const ResourceHandle&,
+		const std::vector<ResourceHandle>&,
+		const std::vector<PipelineStageFlags>&,
+		const std::vector<ResourceHandle>&) override {}
+	ResourceHandle get_gfx_queue() const override { return ResourceHandle(0); }
+
+	/** Sync */
+	void fence_wait_for(const std::vector<ResourceHandle>&, const bool, const uint64_t) override {}
+	void fence_reset(const std::vector<ResourceHandle>&) override {}
+	std::pair<Result, ResourceHandle> semaphore_create() override;
+
+	/** Commands */
+	ResourceHandle command_pool_create() override;
+	void command_pool_reset(const ResourceHandle&) override {}
+	void command_pool_trim(const ResourceHandle&) override {}
+	void command_pool_free(const ResourceHandle&, const std::vector<ResourceHandle>&) override {}
+	std::vector<ResourceHandle> command_pool_allocate(const ResourceHandle& in_pool, const size_t in_count) override;
+	Result command_list_begin(const ResourceHandle&) override { return Result::Success; }
+	Result command_list_end(const ResourceHandle&) override { return Result::Success; }
+
+	void cmd_bind_pipeline(const ResourceHandle&, const PipelineBindPoint&, const ResourceHandle&) override {}
+	void cmd_pipeline_barrier(const ResourceHandle&,
+		const PipelineStageFlags&,
+		const PipelineStageFlags&,
+		const std::vector<TextureMemoryBarrier>&) override {}
+	void cmd_begin_render_pass(const ResourceHandle&,
+		const ResourceHandle&,
+		const Framebuffer&,
+		const maths::Rect2D&,
+		const std::vector<ClearValue>&) override {}
+	void cmd_end_render_pass(const ResourceHandle&) override {}
+	void cmd_bind_vertex_buffers(const ResourceHandle&,
+		const uint32_t,
+		const std::vector<ResourceHandle>&,
+		const std::vector<uint64_t>&) override {}
+	void cmd_bind_index_buffer(const ResourceHandle&,
+		const ResourceHandle&,
+		const uint64_t,
+		const IndexType) override {}
+	void cmd_draw(const ResourceHandle&, const uint32_t, const uint32_t, const uint32_t, const uint32_t) override {}
+	void cmd_draw_indexed(const ResourceHandle&,
+		const uint32_t,
+		const uint32_t,
+		const uint32_t,
+		const int32_t,
+		const uint32_t) override {}
+	void cmd_set_viewport(const ResourceHandle&, uint32_t, const std::vector<Viewport>&) override {}
+	void cmd_set_scissor(const ResourceHandle&, uint32_t, const std::vector<maths::Rect2D>&) override {}
+	void cmd_bind_descriptor_sets(const ResourceHandle&,
+		const PipelineBindPoint,
+		const ResourceHandle&,
+		const uint32_t&,
+		const std::vector<ResourceHandle>&) override {}
+	void cmd_push_constants(const ResourceHandle&,
+		const ResourceHandle&,
+		const ShaderStageFlags,
+		const uint32_t,
+		const uint32_t,
+		const void*) override {}
+	void cmd_copy_buffer(const ResourceHandle&,
+		const ResourceHandle&,
+		const ResourceHandle&,
+		const std::vector<BufferCopyRegion>&) override {}
+	void cmd_copy_buffer_to_texture(const ResourceHandle&,
+		const ResourceHandle&,
+		const ResourceHandle&,
+		const TextureLayout&,
+		const std::vector<BufferTextureCopyRegion>&) override {}
+	void cmd_copy_texture(const ResourceHandle&,
+		const ResourceHandle&,
+		const TextureLayout,
+		const ResourceHandle&,
+		const TextureLayout,
+		const std::vector<TextureCopyRegion>&) override {}
+	void cmd_copy_texture_to_buffer(const ResourceHandle&,
+		const ResourceHandle&,
+		const TextureLayout,
+		const ResourceHandle&,
+		const std::vector<BufferTextureCopyRegion>&) override {}
+	void cmd_blit_texture(const ResourceHandle&,
+		const ResourceHandle&,
+		const TextureLayout,
+		const ResourceHandle&,
+		const TextureLayout,
+		const std::vector<TextureBlitRegion>&,
+		const Filter&) override {}
+private:
+	ZE_FORCEINLINE ResourceHandle make_handle() { return ResourceHandle(next_handle++); }
+private:
+	uint64_t next_handle;
+
+	/** Host memory backing the buffers so they can be mapped */
+	robin_hood::unordered_map<uint64_t, std::vector<uint8_t>> buffers;
+
+	/** Descriptor sets already written, per pipeline layout */
+	robin_hood::unordered_map<uint64_t, robin_hood::unordered_map<uint64_t, ResourceHandle>> descriptor_sets;
+};
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "serialization/Archive.h"
+#include "serialization/types/String.h"
+#include "serialization/types/Vector.h"
+#include "serialization/Json.h"
+#include "reflection/Traits.h"
+#include "reflection/Serialization.h"
+
+/**
+ * Json archives aren't registered by the engine, the benchmark needs them for the reflected paths
+ * Registered before the vector types so they get bindings too
+ */
+ZE_REFL_REGISTER_ARCHIVE(ze::serialization::JsonInputArchive);
+ZE_REFL_REGISTER_ARCHIVE(ze::serialization::JsonOutputArchive);
+
+#include "reflection/VectorRefl.h"
+#include "BenchTypes.gen.h"
+
+/**
+ * Synthetic types used by the serialization benchmark
+ * Each type exposes field_count: the number of leaf values written per instance
+ */
+namespace ze::serializationbench
+{
+
+/** Flat struct of arithmetic values */
+struct BenchPod
+{
+	static constexpr size_t field_count = 8;
+
+	int32_t a;
+	int32_t b;
+	uint32_t c;
+	uint32_t d;
+	float e;
+	float f;
+	double g;
+	uint64_t h;
+
+	BenchPod() : a(-12), b(42), c(1337), d(0xDEADBEEF), e(3.14f), f(-1.5f), g(2.718281828), h(1ull << 40) {}
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("a", a);
+		archive <=> serialization::make_named_data("b", b);
+		archive <=> serialization::make_named_data("c", c);
+		archive <=> serialization::make_named_data("d", d);
+		archive <=> serialization::make_named_data("e", e);
+		archive <=> serialization::make_named_data("f", f);
+		archive <=> serialization::make_named_data("g", g);
+		archive <=> serialization::make_named_data("h", h);
+	}
+};
+
+/** Structs nested a few levels deep */
+struct BenchNested
+{
+	static constexpr size_t field_count = BenchPod::field_count * 3 + 2;
+
+	struct Inner
+	{
+		BenchPod pod;
+		uint32_t flags;
+
+		Inner() : flags(7) {}
+
+		template<typename ArchiveType>
+		void serialize(ArchiveType& archive)
+		{
+			archive <=> serialization::make_named_data("pod", pod);
+			archive <=> serialization::make_named_data("flags", flags);
+		}
+	};
+
+	Inner first;
+	Inner second;
+	BenchPod pod;
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("first", first);
+		archive <=> serialization::make_named_data("second", second);
+		archive <=> serialization::make_named_data("pod", pod);
+	}
+};
+
+/** Large vectors of POD, written as raw bytes by binary archives */
+struct BenchPodVector
+{
+	static constexpr size_t element_count = 1024;
+	static constexpr size_t field_count = element_count * 2 + element_count * BenchPod::field_count;
+
+	std::vector<float> floats;
+	std::vector<uint32_t> indices;
+	std::vector<BenchPod> pods;
+
+	BenchPodVector() : floats(element_count, 1.f), indices(element_count, 3), pods(element_count) {}
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("floats", floats);
+		archive <=> serialization::make_named_data("indices", indices);
+		archive <=> serialization::make_named_data("pods", pods);
+	}
+};
+
+/** 64 MB buffer like a texture mip, only benchmarked in binary archives */
+struct BenchLargeBuffer
+{
+	static constexpr size_t element_count = 64 * 1024 * 1024;
+	static constexpr size_t field_count = element_count;
+
+	std::vector<uint8_t> bytes;
+
+	BenchLargeBuffer() : bytes(element_count, 0x5A) {}
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("bytes", bytes);
+	}
+};
+
+/** Short and long strings */
+struct BenchStrings
+{
+	static constexpr size_t field_count = 4;
+
+	std::string name;
+	std::string path;
+	std::string description;
+	std::string tag;
+
+	BenchStrings() : name("BenchmarkObject"),
+		path("Assets/Textures/Environment/Rocks/RockCliff_01_Albedo.zetexture"),
+		description(512, 'x'),
+		tag("a") {}
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("name", name);
+		archive <=> serialization::make_named_data("path", path);
+		archive <=> serialization::make_named_data("description", description);
+		archive <=> serialization::make_named_data("tag", tag);
+	}
+};
+
+/** Reflected struct, serialized through the archive bindings and through Property::serialize_value */
+ZSTRUCT()
+struct BenchReflected
+{
+	ZE_REFL_BODY()
+
+	static constexpr size_t field_count = 12;
+
+	ZPROPERTY(Serializable)
+	maths::Vector3d position;
+
+	ZPROPERTY(Serializable)
+	maths::Vector3f rotation;
+
+	ZPROPERTY(Serializable)
+	maths::Vector3f scale;
+
+	ZPROPERTY(Serializable)
+	maths::Vector3f velocity;
+
+	BenchReflected() : position(1.0, 2.0, 3.0), rotation(0.f, 90.f, 0.f), scale(1.f), velocity(0.f, -9.81f, 0.f) {}
+
+	template<typename ArchiveType>
+	void serialize(ArchiveType& archive)
+	{
+		archive <=> serialization::make_named_data("position", position);
+		archive <=> serialization::make_named_data("rotation", rotation);
+		archive <=> serialization::make_named_data("scale", scale);
+		archive <=> serialization::make_named_data("velocity", velocity);
+	}
+};
+
+}
+
+ZE_SERL_TRIVIALLY_SERIALIZABLE(ze::serializationbench::BenchPod);
@@ -0,0 +1,279 @@
+#include "Benchmark.h"
+#include "BenchTypes.h"
+#include "serialization/BinaryArchive.h"
+#include "serialization/MemoryArchive.h"
+#include "reflection/Class.h"
+#include "reflection/Property.h"
+#include <fstream>
+#include <sstream>
+
+namespace ze::serializationbench
+{
+
+enum class SerializeMode
+{
+	/** archive <=> object */
+	Direct,
+
+	/** Through the reflection archive bindings, like reflection::serialization::serialize */
+	Reflected,
+
+	/** Property by property using Property::serialize_value */
+	Properties,
+};
+
+const char* get_mode_name(const SerializeMode in_mode)
+{
+	switch(in_mode)
+	{
+	case SerializeMode::Direct:
+		return "Direct";
+	case SerializeMode::Reflected:
+		return "Reflected";
+	case SerializeMode::Properties:
+		return "Properties";
+	}
+
+	return "";
+}
+
+template<SerializeMode Mode, typename ArchiveType, typename T>
+ZE_FORCEINLINE void serialize_object(ArchiveType& archive, T& object)
+{
+	if constexpr(Mode == SerializeMode::Direct)
+	{
+		archive <=> object;
+	}
+	else if constexpr(Mode == SerializeMode::Reflected)
+	{
+		/** Structs have no get_class() so lookup the binding like reflection::serialization::serialize does */
+		auto& map = reflection::serialization::get_archive_map(reflection::serialization::archive_name<ArchiveType>);
+		auto serializer = map.find(reflection::Class::get<T>()->get_name());
+		ZE_CHECK(serializer != map.end());
+		serializer->second(reinterpret_cast<void*>(&archive), reinterpret_cast<void*>(&object));
+	}
+	else
+	{
+		for(const auto& property : reflection::Class::get<T>()->get_properties())
+			property.serialize_value(archive, &object);
+	}
+}
+
+/**
+ * Time a benchmark, see bench::measure
+ * \param in_pass Function processing in_object_count objects and returning the number of bytes processed
+ */
+template<typename T, typename Func>
+void measure(const BenchmarkSettings& in_settings, const std::string& in_name, const size_t in_object_count,
+	Func&& in_pass, std::vector<BenchmarkResult>& out_results)
+{
+	if(in_settings.is_filtered_out(in_name))
+		return;
+
+	const bench::PassTiming timing = bench::measure(in_settings, std::forward<Func>(in_pass));
+
+	BenchmarkResult result;
+	result.name = in_name;
+	result.bytes = timing.count;
+	result.mb_per_sec = timing.best_time > 0.0 ? (timing.count / (1024.0 * 1024.0)) / timing.best_time : 0.0;
+	result.ns_per_field = (timing.best_time * 1e9) / static_cast<double>(T::field_count * in_object_count);
+	out_results.emplace_back(std::move(result));
+}
+
+/**
+ * Benchmark T in every archive type
+ * Input benchmarks read the data produced by the corresponding output benchmark
+ * \tparam WithJson false to only benchmark binary archives (for large buffers)
+ */
+template<typename T, SerializeMode Mode, bool WithJson = true>
+void run_type(const BenchmarkSettings& in_settings, const char* in_type_name, const size_t in_object_count,
+	std::vector<BenchmarkResult>& out_results)
+{
+	using namespace serialization;
+
+	const std::string prefix = std::string(in_type_name) + "/" + get_mode_name(Mode) + "/";
+
+	std::vector<T> objects(in_object_count);
+
+	/** Json archives don't store container sizes, so loaded objects start with the right sizes */
+	std::vector<T> loaded_objects(in_object_count);
+
+	/** Binary stream archives */
+	{
+		std::ostringstream out_stream;
+		measure<T>(in_settings, prefix + "BinaryOutput", in_object_count, [&]()
+		{
+			out_stream.str("");
+			BinaryOutputArchive archive(out_stream);
+			for(auto& object : objects)
+				serialize_object<Mode>(archive, object);
+			return static_cast<uint64_t>(out_stream.tellp());
+		}, out_results);
+
+		const std::string data = out_stream.str();
+		std::istringstream in_stream(data);
+		measure<T>(in_settings, prefix + "BinaryInput", in_object_count, [&]()
+		{
+			in_stream.clear();
+			in_stream.seekg(0);
+			BinaryInputArchive archive(in_stream);
+			for(auto& object : loaded_objects)
+				serialize_object<Mode>(archive, object);
+			return static_cast<uint64_t>(data.size());
+		}, out_results);
+	}
+
+	/** Memory archives */
+	{
+		std::vector<uint8_t> buffer;
+		measure<T>(in_settings, prefix + "MemoryOutput", in_object_count, [&]()
+		{
+			buffer.clear();
+			MemoryOutputArchive archive(buffer);
+			for(auto& object : objects)
+				serialize_object<Mode>(archive, object);
+			return static_cast<uint64_t>(buffer.size());
+		}, out_results);
+
+		measure<T>(in_settings, prefix + "MemoryInput", in_object_count, [&]()
+		{
+			MemoryInputArchive archive(buffer);
+			for(auto& object : loaded_objects)
+				serialize_object<Mode>(archive, object);
+			return static_cast<uint64_t>(buffer.size());
+		}, out_results);
+	}
+
+	/** Json archives, the document is only complete once the archive is destroyed */
+	if constexpr (WithJson)
+	{
+		std::ostringstream out_stream;
+		auto write_json = [&](const bool in_pretty)
+		{
+			out_stream.str("");
+			{
+				JsonOutputArchive archive(out_stream, in_pretty);
+				for(auto& object : objects)
+					serialize_object<Mode>(archive, object);
+			}
+			return static_cast<uint64_t>(out_stream.tellp());
+		};
+
+		measure<T>(in_settings, prefix + "JsonOutput", in_object_count, [&]() { return write_json(true); }, out_results);
+		measure<T>(in_settings, prefix + "JsonCompactOutput", in_object_count, [&]() { return write_json(false); }, out_results);
+
+		const std::string data = out_stream.str();
+		std::istringstream in_stream(data);
+		auto read_json = [&](const JsonReadMode in_mode)
+		{
+			in_stream.clear();
+			in_stream.seekg(0);
+			JsonInputArchive archive(in_stream, in_mode);
+			for(auto& object : loaded_objects)
+				serialize_object<Mode>(archive, object);
+			return static_cast<uint64_t>(data.size());
+		};
+
+		measure<T>(in_settings, prefix + "JsonDomInput", in_object_count,
+			[&]() { return read_json(JsonReadMode::Dom); }, out_results);
+		measure<T>(in_settings, prefix + "JsonSequentialInput", in_object_count,
+			[&]() { return read_json(JsonReadMode::Sequential); }, out_results);
+	}
+}
+
+std::vector<BenchmarkResult> run_benchmarks(const BenchmarkSettings& in_settings)
+{
+	std::vector<BenchmarkResult> results;
+
+	run_type<BenchPod, SerializeMode::Direct>(in_settings, "Pod", 4096, results);
+	run_type<BenchNested, SerializeMode::Direct>(in_settings, "Nested", 1024, results);
+	run_type<BenchPodVector, SerializeMode::Direct>(in_settings, "PodVector", 8, results);
+	run_type<BenchStrings, SerializeMode::Direct>(in_settings, "Strings", 2048, results);
+	run_type<BenchLargeBuffer, SerializeMode::Direct, false>(in_settings, "LargeBuffer64MB", 1, results);
+	run_type<BenchReflected, SerializeMode::Direct>(in_settings, "Reflected", 2048, results);
+	run_type<BenchReflected, SerializeMode::Reflected>(in_settings, "Reflected", 2048, results);
+	run_type<BenchReflected, SerializeMode::Properties>(in_settings, "Reflected", 2048, results);
+
+	return results;
+}
+
+Baseline read_baseline(const std::filesystem::path& in_path)
+{
+	Baseline baseline;
+
+	std::ifstream file(in_path);
+	if(!file.is_open())
+		return baseline;
+
+	std::string line;
+	uint32_t version = 0;
+	while(std::getline(file, line))
+	{
+		if(line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream stream(line);
+		if(version == 0)
+		{
+			stream >> version;
+			if(version != baseline_version)
+				return baseline;
+			continue;
+		}
+
+		BenchmarkResult result;
+		if(stream >> result.name >> result.mb_per_sec >> result.ns_per_field)
+			baseline.insert({ result.name, result });
+	}
+
+	return baseline;
+}
+
+bool write_baseline(const std::filesystem::path& in_path, const std::vector<BenchmarkResult>& in_results)
+{
+	std::ofstream file(in_path, std::ios::trunc);
+	if(!file.is_open())
+		return false;
+
+	file << "# Serialization benchmark baseline, regenerate with -WriteBaseline on the reference machine\n";
+	file << "# <name> <MB/s> <ns per field>\n";
+	file << baseline_version << "\n";
+	for(const auto& result : in_results)
+		file << fmt::format("{} {:.3f} {:.3f}\n", result.name, result.mb_per_sec, result.ns_per_field);
+
+	return true;
+}
+
+size_t report(const std::vector<BenchmarkResult>& in_results, const Baseline& in_baseline,
+	const double in_tolerance)
+{
+	size_t failures = 0;
+
+	fmt::print("{:<48} {:>12} {:>12} {:>12} {:>14} {:>9}\n", "Benchmark", "Bytes", "MB/s", "ns/field",
+		"Base ns/field", "Delta");
+	for(const auto& result : in_results)
+	{
+		auto it = in_baseline.find(result.name);
+		if(it == in_baseline.end() || it->second.ns_per_field <= 0.0)
+		{
+			/** A benchmark without baseline can't be checked, fail so it gets added */
+			failures++;
+			fmt::print("{:<48} {:>12} {:>12.1f} {:>12.3f} {:>14} {:>9} NO BASELINE\n", result.name, result.bytes,
+				result.mb_per_sec, result.ns_per_field, "-", "-");
+			continue;
+		}
+
+		const double delta = (result.ns_per_field / it->second.ns_per_field) - 1.0;
+		const bool regressed = delta > in_tolerance;
+		if(regressed)
+			failures++;
+
+		fmt::print("{:<48} {:>12} {:>12.1f} {:>12.3f} {:>14.3f} {:>+8.1f}%{}\n", result.name, result.bytes,
+			result.mb_per_sec, result.ns_per_field, it->second.ns_per_field, delta * 100.0,
+			regressed ? " REGRESSION" : "");
+	}
+
+	return failures;
+}
+
+}
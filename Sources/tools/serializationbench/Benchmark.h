@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EngineCore.h"
+#include "BenchCommon.h"
+#include <robin_hood.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * Headless serialization benchmark
+ * Serializes synthetic types of various shapes in every archive type and reports throughput and cost per field
+ */
+namespace ze::serializationbench
+{
+
+static constexpr uint32_t baseline_version = 1;
+
+struct BenchmarkSettings : bench::Settings
+{
+	BenchmarkSettings() : bench::Settings(0.25) {}
+};
+
+struct BenchmarkResult
+{
+	/** Type/Mode/Archive */
+	std::string name;
+
+	/** Bytes written or read by a pass */
+	uint64_t bytes;
+	double mb_per_sec;
+	double ns_per_field;
+
+	BenchmarkResult() : bytes(0), mb_per_sec(0.0), ns_per_field(0.0) {}
+};
+
+using Baseline = robin_hood::unordered_map<std::string, BenchmarkResult>;
+
+SERIALIZATIONBENCH_API std::vector<BenchmarkResult> run_benchmarks(const BenchmarkSettings& in_settings);
+
+/**
+ * Baseline files store one "<name> <MB/s> <ns per field>" entry per line after the version, lines starting with # are ignored
+ */
+SERIALIZATIONBENCH_API Baseline read_baseline(const std::filesystem::path& in_path);
+SERIALIZATIONBENCH_API bool write_baseline(const std::filesystem::path& in_path, const std::vector<BenchmarkResult>& in_results);
+
+/**
+ * Print the results and compare them against the baseline
+ * \param in_tolerance Allowed ns per field increase relative to the baseline (0.1 = 10%)
+ * \return Number of benchmarks slower than the baseline or missing from it
+ */
+SERIALIZATIONBENCH_API size_t report(const std::vector<BenchmarkResult>& in_results, const Baseline& in_baseline,
+	const double in_tolerance);
+
+}
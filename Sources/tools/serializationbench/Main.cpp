@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include "logger/Logger.h"
+#include "logger/sinks/StdSink.h"
+#include <string_view>
+
+/**
+ * Serialization benchmark
+ * Usage: ZESerializationBench [-Baseline=<path>] [-WriteBaseline] [-Tolerance=<ratio>] [-MinTime=<seconds>] [-Filter=<string>]
+ * Returns 1 if a benchmark is slower than the baseline by more than the tolerance or has no baseline entry
+ */
+
+int main(int argc, char** argv)
+{
+	using namespace ze::serializationbench;
+
+	ze::logger::add_sink(std::make_unique<ze::logger::StdSink>("Std"));
+
+	BenchmarkSettings settings;
+	std::filesystem::path baseline_path = ZE_SERIALIZATIONBENCH_BASELINE;
+	bool write = false;
+	double tolerance = 0.1;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if(arg.starts_with("-Baseline="))
+			baseline_path = ze::bench::parse_command_line_arg(arg);
+		else if(arg == "-WriteBaseline")
+			write = true;
+		else if(arg.starts_with("-Tolerance="))
+			tolerance = std::stod(std::string(ze::bench::parse_command_line_arg(arg)));
+		else
+			ze::bench::parse_settings_arg(arg, settings);
+	}
+
+	/** The baseline is rewritten as a whole, a filtered run would drop every other entry */
+	if(write && !settings.filter.empty())
+	{
+		fmt::print("-WriteBaseline can't be combined with -Filter, the baseline must contain every benchmark\n");
+		return 1;
+	}
+
+	std::vector<BenchmarkResult> results = run_benchmarks(settings);
+
+	if(write)
+	{
+		if(!write_baseline(baseline_path, results))
+		{
+			fmt::print("Failed to write baseline {}\n", baseline_path.string());
+			return 1;
+		}
+
+		report(results, read_baseline(baseline_path), tolerance);
+		fmt::print("Baseline written to {}\n", baseline_path.string());
+		return 0;
+	}
+
+	const size_t failures = report(results, read_baseline(baseline_path), tolerance);
+	if(failures > 0)
+	{
+		fmt::print("{} benchmark(s) regressed by more than {:.0f}% or have no baseline entry\n", failures, 
+			tolerance * 100.0);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+#include "EngineCore.h"
+#include "logger/BinaryLog.h"
+#include "logger/Logger.h"
+#include "logger/sinks/StdSink.h"
+#include <fstream>
+#include <iostream>
+
+/**
+ * Binary log decoder
+ * Usage:
+ *	ZELog <binary log> [output]
+ * Without an output file, the log is printed to the standard output
+ */
+
+int main(int argc, char** argv)
+{
+	ze::logger::add_sink(std::make_unique<ze::logger::StdSink>("Std"));
+
+	if (argc != 2 && argc != 3)
+	{
+		fmt::print("Usage: ZELog <binary log> [output]\n");
+		return 1;
+	}
+
+	std::ifstream log(argv[1], std::ios::binary);
+	if (!log.is_open())
+	{
+		ze::logger::error("Failed to open {}", argv[1]);
+		return 1;
+	}
+
+	if (argc == 3)
+	{
+		std::ofstream output(argv[2]);
+		if (!output.is_open())
+		{
+			ze::logger::error("Failed to open {}", argv[2]);
+			return 1;
+		}
+
+		return ze::logger::binary::decode(log, output) ? 0 : 1;
+	}
+
+	return ze::logger::binary::decode(log, std::cout) ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include "EngineCore.h"
+#include "zefs/PakBuilder.h"
+#include "zefs/PakFileSystem.h"
+#include "logger/Logger.h"
+#include "logger/sinks/StdSink.h"
+#include <chrono>
+#include <string_view>
+
+/**
+ * Pack file builder
+ * Usage:
+ *	ZEPak <directory> <pak> [-NoCompress] [-Alignment=<bytes>]
+ *	ZEPak -List <pak>
+ */
+
+std::string_view parse_command_line_arg(const std::string_view& arg)
+{
+	size_t id = arg.find('=');
+	return arg.substr(id + 1, arg.size() - id);
+}
+
+int list_pak(const std::filesystem::path& in_pak_path)
+{
+	ze::filesystem::PakFileSystem pak("/", 0, in_pak_path);
+	if (!pak.is_valid())
+		return 1;
+
+	pak.iterate_directories("",
+		[&](const ze::filesystem::DirectoryEntry& in_entry)
+		{
+			if (!pak.is_directory(in_entry.path))
+				fmt::print("{}\n", in_entry.path.generic_string());
+		}, ze::filesystem::IterateDirectoriesFlagBits::Recursive);
+
+	fmt::print("{} entries\n", pak.get_entry_count());
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	using namespace ze::filesystem;
+
+	ze::logger::add_sink(std::make_unique<ze::logger::StdSink>("Std"));
+
+	std::vector<std::string_view> paths;
+	PakBuildSettings settings;
+	bool list = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-List")
+			list = true;
+		else if (arg == "-NoCompress")
+			settings.compress = false;
+		else if (arg.starts_with("-Alignment="))
+			settings.alignment = static_cast<uint32_t>(std::stoul(std::string(parse_command_line_arg(arg))));
+		else
+			paths.emplace_back(arg);
+	}
+
+	if (list && paths.size() == 1)
+		return list_pak(paths[0]);
+
+	if (paths.size() != 2 || settings.alignment == 0 || (settings.alignment & (settings.alignment - 1)) != 0)
+	{
+		fmt::print("Usage: ZEPak <directory> <pak> [-NoCompress] [-Alignment=<power of two>]\n");
+		fmt::print("       ZEPak -List <pak>\n");
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	PakBuildStats stats;
+	if (!build_pak(paths[0], paths[1], settings, &stats))
+		return 1;
+
+	fmt::print("Packed {} files ({} compressed) in {:.2f}s, {:.2f} MiB -> {:.2f} MiB\n",
+		stats.entry_count, stats.compressed_entry_count,
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+		stats.uncompressed_size / (1024.0 * 1024.0), stats.pak_size / (1024.0 * 1024.0));
+
+	return 0;
+}
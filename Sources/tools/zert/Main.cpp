@@ -2,10 +2,16 @@
 #include <iostream>
 #include <cstdarg>
 #include <string>
-#include <sys/stat.h>
 #include "Type.h"
 #include "Parser.h"
 #include <fstream>
+#include <sstream>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <chrono>
+#include <algorithm>
 #include "Header.h"
 #include "Writer.h"
 
@@ -30,20 +36,142 @@ void fatal(std::string_view InMessage, ...)
 	exit(-1);
 }
 
-// stat
-#ifdef _WIN64
-#define STAT _stat
-using stat_time_t = __time64_t;
-#else
-#define STAT stat
-using stat_time_t = __int64_t;
-#endif
+uint64_t hash_bytes(std::string_view in_bytes, uint64_t in_seed)
+{
+	uint64_t hash = in_seed;
+	for(const char& c : in_bytes)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * Per-module manifest of the content hash of each header and of its generated files
+ * Format: one "<hash> <has refl data> <.gen.h hash> <.gen.cpp hash> <header path>" entry per line
+ */
+struct ManifestEntry
+{
+	uint64_t hash;
+	bool has_refl_data;
+	uint64_t h_hash;
+	uint64_t cpp_hash;
+};
+
+robin_hood::unordered_map<std::string, ManifestEntry> read_manifest(const std::filesystem::path& in_path)
+{
+	robin_hood::unordered_map<std::string, ManifestEntry> manifest;
+
+	std::ifstream file(in_path);
+	if(!file.is_open())
+		return manifest;
+
+	uint32_t version = 0;
+	file >> version;
+	if(version != zert_version)
+		return manifest;
+
+	ManifestEntry entry;
+	std::string path;
+	while(file >> std::hex >> entry.hash >> std::dec >> entry.has_refl_data >> std::hex >> entry.h_hash >> entry.cpp_hash
+		>> std::dec && std::getline(file >> std::ws, path))
+		manifest.insert({ path, entry });
+
+	return manifest;
+}
+
+/**
+ * Manifest is sorted so it is only rewritten when something changed
+ */
+std::string write_manifest(const std::map<std::string, ManifestEntry>& in_manifest)
+{
+	std::ostringstream stream;
+	stream << zert_version << "\n";
+	for(const auto& [path, entry] : in_manifest)
+		stream << std::hex << entry.hash << std::dec << " " << entry.has_refl_data << " " << std::hex << entry.h_hash
+			<< " " << entry.cpp_hash << std::dec << " " << path << "\n";
+
+	return stream.str();
+}
+
+/**
+ * Check a generated file is still the one written by the last run
+ * CMake creates placeholder .gen.cpp files, so an existing file isn't enough
+ */
+bool is_generated_file_up_to_date(const std::filesystem::path& in_path, const uint64_t in_hash)
+{
+	std::ifstream file(in_path, std::ios::binary);
+	if(!file.is_open())
+		return false;
+
+	std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return hash_bytes(content) == in_hash;
+}
+
+/**
+ * Run in_func(i) for each i in [0, in_count) on in_jobs threads
+ */
+template<typename Func>
+void parallel_for(const size_t in_count, const size_t in_jobs, Func&& in_func)
+{
+	if(in_jobs <= 1 || in_count <= 1)
+	{
+		for(size_t i = 0; i < in_count; ++i)
+			in_func(i);
+		return;
+	}
+
+	const size_t thread_count = std::min(in_jobs, in_count);
+	std::atomic_size_t next = 0;
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+	for(size_t i = 0; i < thread_count; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			for(size_t idx = next++; idx < in_count; idx = next++)
+				in_func(idx);
+		});
+	}
+
+	for(auto& thread : threads)
+		thread.join();
+}
+
+/**
+ * Result of parsing a header of the current module
+ */
+struct ParseResult
+{
+	std::optional<Header> header;
+	ManifestEntry manifest_entry;
+};
 
 int main(int argc, char** argv)
 {
 	if(argc < 2)
 	{
-		fatal("Invalid syntax: ZERT.exe -SrcDir= -OutDir= ZRTFILES");
+		fatal("Invalid syntax: ZERT.exe -Module= -SrcDir= -OutDir= [-Jobs=] ZRTFILES");
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	/** Parse command line arguments */
+	std::string_view module_name = parse_command_line_arg(argv[1]);
+	std::string_view src_dir = parse_command_line_arg(argv[2]);
+	std::string_view out_dir = parse_command_line_arg(argv[3]);
+
+	size_t job_count = std::max(std::thread::hardware_concurrency(), 1U);
+	std::vector<std::string> zrt_files;
+	for(int i = 4; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if(arg.starts_with("-Jobs="))
+			job_count = std::max(std::atoi(parse_command_line_arg(arg).data()), 1);
+		else
+			zrt_files.emplace_back(arg);
 	}
 
 	/**
@@ -55,70 +183,108 @@ int main(int argc, char** argv)
 	/**
 	 * Load ZRT files and parse them
 	 */
-	int ZrtFileCount = argc;
-	for(int i = 4; i < ZrtFileCount; ++i)
+	std::vector<std::string> zrt_headers;
+	for(const auto& zrt_file : zrt_files)
 	{
-		Header headesr("", "");
-		std::vector<std::string> headers = read_file_lines(argv[i]);
-		for(const auto& header : headers)
-			Parser parser(headesr, read_text_file(header), true);
+		std::vector<std::string> headers = read_file_lines(zrt_file);
+		zrt_headers.insert(zrt_headers.end(), headers.begin(), headers.end());
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
-
-	/** Parse command line arguments */
-	std::string_view module_name = parse_command_line_arg(argv[1]);
-	std::string_view src_dir = parse_command_line_arg(argv[2]);
-	std::string_view out_dir = parse_command_line_arg(argv[3]);
+	parallel_for(zrt_headers.size(), job_count, [&](const size_t in_idx)
+	{
+		Header header("", "");
+		Parser parser(header, read_text_file(zrt_headers[in_idx]), true);
+	});
 
 	std::cout << "Generating reflection data for module " << module_name << "...\n";
 
 	/**
-	 * Iterate over headers and parse them
+	 * The generated code of a header also depends on the reflected types of the other headers
+	 * (e.g. whether a parent is reflected), so hash them with each header
 	 */
-	std::vector<Header> headers;
+	const uint64_t types_hash = typedb_hash();
+
+	std::filesystem::path manifest_path = out_dir;
+	manifest_path /= std::string(module_name) + ".zertmanifest";
+	auto old_manifest = read_manifest(manifest_path);
+	std::map<std::string, ManifestEntry> manifest;
+
+	/**
+	 * Iterate over headers and parse the ones whose content changed
+	 * Paths are sorted so the results are merged in the same order whatever the job count is
+	 */
+	std::vector<std::filesystem::path> paths;
 	for(const auto& entry : std::filesystem::recursive_directory_iterator(src_dir))
 	{
-		std::filesystem::path path = entry.path();
+		if(entry.path().extension() == ".h")
+			paths.emplace_back(entry.path());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	std::vector<ParseResult> results(paths.size());
+	parallel_for(paths.size(), job_count, [&](const size_t in_idx)
+	{
+		const std::filesystem::path& path = paths[in_idx];
+		ParseResult& result = results[in_idx];
+
+		std::string text = read_text_file(path.string());
+		uint64_t hash = hash_bytes(text, hash_bytes(std::to_string(zert_version), types_hash));
 
-		if(path.extension() == ".h")
+		auto old_entry = old_manifest.find(path.string());
+		if(old_entry != old_manifest.end() && old_entry->second.hash == hash)
 		{
-			/**
-			 * Check if file was modified
-			 */
-			std::filesystem::path datefile = out_dir;
-			datefile += path.filename();
-			datefile += ".date";
-			if(std::filesystem::exists(datefile))
+			/** Still regenerate if the outputs have been deleted or modified */
+			const ManifestEntry& entry = old_entry->second;
+			std::filesystem::path gen_file = out_dir;
+			gen_file /= path.stem().string();
+			if(!entry.has_refl_data || 
+				(is_generated_file_up_to_date(gen_file.string() + ".gen.h", entry.h_hash) &&
+				is_generated_file_up_to_date(gen_file.string() + ".gen.cpp", entry.cpp_hash)))
 			{
-				std::ifstream file(datefile);
-				stat_time_t time;
-				file >> time;
-
-				struct STAT write_time;
-				STAT(path.string().c_str(), &write_time);
-				if(time == write_time.st_mtime)
-					continue;
-				
-				file.close();
+				result.manifest_entry = entry;
+				return;
 			}
-			
-			std::ofstream file(datefile);
-			struct STAT write_time;
-			STAT(path.string().c_str(), &write_time);
-			file << write_time.st_mtime;
-			file.close();
-
-			Header& header = headers.emplace_back(std::string(module_name), path);
-			Parser parser(header, read_text_file(path.string()), false);
 		}
-	}
 
-	for(const auto& header : headers)
+		Header& header = result.header.emplace(std::string(module_name), path);
+		Parser parser(header, text, false);
+		result.manifest_entry = ManifestEntry { hash, header.has_refl_data(), 0, 0 };
+	});
+
+	/** Merge results */
+	size_t parsed_headers = 0;
+	size_t skipped_headers = 0;
+	size_t written_files = 0;
+	for(size_t i = 0; i < paths.size(); ++i)
 	{
-		if(header.has_refl_data())
-			Writer writer(header, out_dir);
+		ManifestEntry& entry = results[i].manifest_entry;
+		if(results[i].header)
+		{
+			parsed_headers++;
+			if(results[i].header->has_refl_data())
+			{
+				Writer writer(*results[i].header, out_dir);
+				written_files += writer.get_written_files();
+				entry.h_hash = writer.get_h_hash();
+				entry.cpp_hash = writer.get_cpp_hash();
+			}
+		}
+		else
+		{
+			skipped_headers++;
+		}
+
+		manifest.insert({ paths[i].string(), entry });
 	}
 
+	if(!std::filesystem::exists(out_dir))
+		std::filesystem::create_directories(out_dir);
+	write_file_if_changed(manifest_path, write_manifest(manifest));
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::high_resolution_clock::now() - start);
+	std::cout << "Parsed " << parsed_headers << " headers (" << skipped_headers << " unchanged), "
+		<< written_files << " files written in " << elapsed.count() << " ms (" << job_count << " jobs)\n";
+
 	return 0;
-}
\ No newline at end of file
+}
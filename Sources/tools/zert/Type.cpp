@@ -1,23 +1,46 @@
 #include "ZERT.h"
 #include "Type.h"
+#include <algorithm>
+#include <mutex>
 
 std::vector<Type> types;
 
+/** Headers are parsed in parallel */
+std::mutex types_mutex;
+
 void typedb_register(Type&& in_type)
 {
+	std::scoped_lock lock(types_mutex);
 	types.emplace_back(std::move(in_type));
 }
 
-std::vector<Type> typedb_get_types()
+const std::vector<Type>& typedb_get_types()
 {
 	return types;
 }
 
 bool typedb_has_type(const std::string& in_type)
 {
+	std::scoped_lock lock(types_mutex);
 	for(const auto& type : types)
 		if(type.name == in_type)
 			return true;
 
 	return false;
+}
+
+uint64_t typedb_hash()
+{
+	std::vector<std::string> names;
+	names.reserve(types.size());
+	for(const auto& type : types)
+		names.emplace_back(std::to_string(static_cast<int>(type.refl_type)) + " " + type.znamespace + "::" + type.name);
+
+	std::sort(names.begin(), names.end());
+
+	std::string text;
+	for(const auto& name : names)
+		text += name + "\n";
+
+	return hash_bytes(text);
 }
\ No newline at end of file
@@ -20,5 +20,13 @@ struct Type
 };
 
 void typedb_register(Type&& in_type);
-std::vector<Type> typedb_get_types();
-bool typedb_has_type(const std::string& in_type);
\ No newline at end of file
+
+/** Not thread-safe, only call once every header has been parsed */
+const std::vector<Type>& typedb_get_types();
+bool typedb_has_type(const std::string& in_type);
+
+/**
+ * Hash of every registered type, independent of the registration order
+ * Not thread-safe
+ */
+uint64_t typedb_hash();
\ No newline at end of file
@@ -1,18 +1,59 @@
 #include "Writer.h"
+#include "ZERT.h"
 #include "Header.h"
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <iostream>
+#include <map>
+#include <set>
+#include <algorithm>
 
-uint64_t unique_header_id = 0;
+/**
+ * Write the file only if its content changed, this prevents touching timestamps
+ * and triggering recompiles when the generated code is the same
+ */
+bool write_file_if_changed(const std::filesystem::path& in_path, const std::string& in_content)
+{
+	{
+		std::ifstream file(in_path, std::ios::binary);
+		if(file.is_open())
+		{
+			std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			if(content == in_content)
+				return false;
+		}
+	}
+
+	std::ofstream file(in_path, std::ios::binary | std::ios::trunc);
+	if(!file.is_open())
+		fatal("Failed to write file %s", in_path.string().c_str());
+	file << in_content;
+	return true;
+}
+
+/**
+ * Make an identifier from a qualified type name, so same-named types of different namespaces get different symbols
+ */
+std::string get_symbol_name(const std::string& in_namespace, const std::string& in_name)
+{
+	std::string symbol = in_namespace.empty() ? in_name : in_namespace + "::" + in_name;
+	for(size_t pos = symbol.find("::"); pos != std::string::npos; pos = symbol.find("::", pos))
+		symbol.replace(pos, 2, "_");
+	return symbol;
+}
 
 Writer::Writer(const Header& in_header, const std::filesystem::path& in_out_dir) 
-	: header(in_header), out_dir(in_out_dir)
+	: header(in_header), out_dir(in_out_dir), written_files(0), h_hash(0), cpp_hash(0)
 {
+	/** Unique id derived from the header path so it is stable between runs */
+	char path_hash[17];
+	snprintf(path_hash, sizeof(path_hash), "%016llx", 
+		static_cast<unsigned long long>(hash_bytes(header.path.string())));
+	unique_id = header.module_name + "_" + path_hash;
+
 	write_h();
 	write_cpp();
-
-	unique_header_id++;
 }
 
 void Writer::write_h()
@@ -28,9 +69,7 @@ void Writer::write_h()
 	std::filesystem::path filename(header.path.stem());
 	out_file /= filename.string() + ".gen.h";
 
-	std::string unique_id = header.module_name + "_" + std::to_string(unique_header_id); 
-
-	std::ofstream file(out_file.c_str(), std::ios::out);
+	std::ostringstream file;
 	file << "#pragma once\n\n";
 	file << "/** GENERATED BY ZERT. DO NOT MODIFY! */";
 	file << "\n\n";
@@ -87,7 +126,9 @@ void Writer::write_h()
 		file << "ZE_REFL_DECLARE_ENUM(" << en.znamespace << "::" << en.name << ")\n\n";
 	}
 
-	file.close();
+	h_hash = hash_bytes(file.str());
+	if(write_file_if_changed(out_file, file.str()))
+		written_files++;
 }
 
 void Writer::write_cpp()
@@ -97,46 +138,54 @@ void Writer::write_cpp()
 	std::filesystem::path filename(header.path.stem());
 	out_file /= filename.string() + ".gen.cpp";
 
-	std::string unique_id = header.module_name + "_" + std::to_string(unique_header_id); 
-
-	std::ofstream file(out_file.c_str(), std::ios::out);
+	std::ostringstream file;
 	file << "/** GENERATED BY ZERT. DO NOT MODIFY! */\n\n";
 	file << "#include " << header.path << "\n";
 	file << "#include \"reflection/Builders.h\"\n";
 	file << "#include \"reflection/Class.h\"\n";
 	file << "#include \"reflection/Enum.h\"\n";
-	file << "#include \"reflection/Serialization.h\"\n\n";
+	file << "#include \"reflection/Serialization.h\"\n";
+	file << "#include \"reflection/TypeTable.h\"\n\n";
 
 	/** Serialization */
 	for(const auto& cl : header.classes)
-		file << "ZE_REFL_SERL_REGISTER_TYPE(" << cl.znamespace << "::" << cl.name << ", " << cl.name << ");\n\n";
+		file << "ZE_REFL_SERL_REGISTER_TYPE(" << cl.znamespace << "::" << cl.name << ", " << get_symbol_name(cl.znamespace, cl.name) << ");\n\n";
 	
 	file << "namespace ze::reflection\n{\n";
 	file << "ZE_REFL_BUILDER_FUNC(" << unique_id << "_" << header.path.stem().string() << ")\n{\n"; 
 	file << "using namespace ze;\n";
 
+	/** Bring every namespace of this header in scope as types are written like in the header */
+	std::set<std::string> namespaces;
 	for(const auto& cl : header.classes)
+		namespaces.insert(cl.znamespace);
+	for(const auto& en : header.enums)
+		namespaces.insert(en.znamespace);
+	for(const auto& ns : namespaces)
 	{
-		file << "{\n";
-		file << "using namespace " << cl.znamespace << ";\n";
-		std::string builder_var = "Builder_" + cl.name;
-
-		file << "builders::ClassBuilder<" << cl.znamespace << "::" << cl.name << "> " << builder_var << ";\n";
-		
-		for(const auto& ctor : cl.get_ctors())
-			file << builder_var << ".constructor<" + ctor + ">();\n";
+		if(!ns.empty() && ns != "ze")
+			file << "using namespace " << ns << ";\n";
+	}
 
-		if(cl.get_ctors().empty())
-			file << builder_var << ".constructor<>();\n";
+	/**
+	 * Emit read-only descriptors, types are only built by the RegistrationManager when requested
+	 * The type table must be sorted by name
+	 */
+	std::map<std::string, std::string> type_descriptors;
 
-		for(const auto& parent : cl.get_parents())
-			file << builder_var << ".parent<" << parent << ">();\n";
+	for(const auto& cl : header.classes)
+	{
+		std::string full_name = cl.znamespace + "::" + cl.name;
+		std::string symbol_name = get_symbol_name(cl.znamespace, cl.name);
+		std::string properties_var = symbol_name + "_properties";
+		std::string ctors_var = symbol_name + "_constructors";
 
 		for(const auto& property : cl.get_properties())
 		{
-			file << builder_var << ".property<" << property.type << ">(\"" 
-				+ property.name + "\", &" << cl.znamespace << "::" << cl.name << "::" << property.name << ", ";
-			file << "{\n";
+			if(property.metadatas.empty())
+				continue;
+
+			file << "static constexpr PropertyMetadataDescriptor " << symbol_name << "_" << property.name << "_metadatas[] =\n{\n";
 			for(const auto& [key, value] : property.metadatas)
 			{   
 				std::string keyv = key;
@@ -145,34 +194,88 @@ void Writer::write_cpp()
 				keyv.erase(std::remove_if(keyv.begin(), keyv.end(), isspace), keyv.end());
 				valuev.erase(std::remove_if(valuev.begin(), valuev.end(), isspace), valuev.end());
 
-				file << "{ \"" << keyv << "\", \"" << valuev << "\" },";
+				file << "\t{ \"" << keyv << "\", \"" << valuev << "\" },\n";
 			}
-			file << "}";
-			file << ");\n";
+			file << "};\n";
 		}
 
-		file << "#if ZE_WITH_EDITOR\n";
-		file << builder_var << ".documentation(\"" << cl.documentation << "\");\n";
-		file << "#endif\n";
+		if(!cl.get_properties().empty())
+		{
+			file << "static constexpr PropertyDescriptor " << properties_var << "[] =\n{\n";
+			for(const auto& property : cl.get_properties())
+			{
+				file << "\t{ \"" << property.name << "\", ";
+				if(property.metadatas.empty())
+					file << "{}, ";
+				else
+					file << symbol_name << "_" << property.name << "_metadatas, ";
+				file << "&builders::build_property<" << full_name << ", " << property.type << ", &" 
+					<< full_name << "::" << property.name << "> },\n";
+			}
+			file << "};\n";
+		}
+
+		if(!cl.get_ctors().empty())
+		{
+			file << "static constexpr ConstructorDescriptor " << ctors_var << "[] =\n{\n";
+			for(const auto& ctor : cl.get_ctors())
+			{
+				file << "\t&builders::add_constructor<" << full_name;
+				if(!ctor.empty())
+					file << "," << ctor;
+				file << ">,\n";
+			}
+			file << "};\n";
+		}
 
-		file << "}\n";
+		std::string parents;
+		for(const auto& parent : cl.get_parents())
+		{
+			if(!parents.empty())
+				parents += ", ";
+			parents += parent;
+		}
+
+		std::string& descriptor = type_descriptors[full_name];
+		descriptor = "\t{ .name = type_name<" + full_name + ">, .build = &builders::build_class<" + full_name + ">";
+		if(!parents.empty())
+			descriptor += ", .parent = builders::parent_name<" + parents + ">()";
+		if(!cl.get_ctors().empty())
+			descriptor += ", .constructors = " + ctors_var;
+		if(!cl.get_properties().empty())
+			descriptor += ", .properties = " + properties_var;
+		descriptor += ", .documentation = ZE_REFL_DOCUMENTATION(\"" + cl.documentation + "\") },\n";
 	}
 
 	for(const auto& en : header.enums)
 	{
-		file << "{\n";
-		file << "using namespace " << en.znamespace << ";\n";
-		std::string builder_var = "Builder_" + en.name;
-
-		file << "builders::EnumBuilder<" << en.znamespace << "::" << en.name << "> " << builder_var << ";\n";
-		
-		for(const auto& value : en.values)
-			file << builder_var << ".value(\"" << value << "\", " << en.name << "::" << value << ");\n";
-	
-		file << "}\n";
+		std::string full_name = en.znamespace + "::" + en.name;
+		std::string values_var = get_symbol_name(en.znamespace, en.name) + "_values";
+
+		if(!en.values.empty())
+		{
+			file << "static constexpr EnumValueDescriptor " << values_var << "[] =\n{\n";
+			for(const auto& value : en.values)
+				file << "\t{ \"" << value << "\", static_cast<uint64_t>(" << full_name << "::" << value << ") },\n";
+			file << "};\n";
+		}
+
+		std::string& descriptor = type_descriptors[full_name];
+		descriptor = "\t{ .name = type_name<" + full_name + ">, .build = &builders::build_enum<" + full_name + ">";
+		if(!en.values.empty())
+			descriptor += ", .values = " + values_var;
+		descriptor += " },\n";
 	}
 
+	file << "static constexpr TypeDescriptor types[] =\n{\n";
+	for(const auto& [name, descriptor] : type_descriptors)
+		file << descriptor;
+	file << "};\n";
+	file << "RegistrationManager::get().register_table(types);\n";
+
 	file << "}\n}";
 	
-	file.close();
+	cpp_hash = hash_bytes(file.str());
+	if(write_file_if_changed(out_file, file.str()))
+		written_files++;
 }
\ No newline at end of file
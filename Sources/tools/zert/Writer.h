@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
 
 struct Header;
 
@@ -8,10 +10,23 @@ class Writer
 {
 public:
 	Writer(const Header& in_header, const std::filesystem::path& in_out_dir);
+
+	/** Number of files whose content changed and were written */
+	size_t get_written_files() const { return written_files; }
+
+	/** Hash of the generated .gen.h/.gen.cpp content */
+	uint64_t get_h_hash() const { return h_hash; }
+	uint64_t get_cpp_hash() const { return cpp_hash; }
 private:
 	void write_h();
 	void write_cpp();
 private:
 	const Header& header;
 	std::filesystem::path out_dir;
-};
\ No newline at end of file
+	std::string unique_id;
+	size_t written_files;
+	uint64_t h_hash;
+	uint64_t cpp_hash;
+};
+
+bool write_file_if_changed(const std::filesystem::path& in_path, const std::string& in_content);
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 #include <vector>
 #include <string>
@@ -31,7 +32,18 @@ inline void hash_combine(std::size_t& Seed, const T& V)
 #define HAS_FLAG(Enum, Other) (Enum & Other) == Other
 #define HASN_FLAG(Enum, Other) !(HAS_FLAG(Enum, Other))
 
+/**
+ * Version of the generated code, bump it when the output format changes
+ * so every header gets regenerated
+ */
+static constexpr uint32_t zert_version = 2;
+
 void fatal(std::string_view message, ...);
+
+/**
+ * 64-bit FNV-1a hash
+ */
+uint64_t hash_bytes(std::string_view in_bytes, uint64_t in_seed = 14695981039346656037ULL);
 std::string read_text_file(const std::string_view& in_filename);
 std::vector<std::string> read_file_lines(const std::string_view& in_filename);
 std::vector<std::string> tokenize(const std::string& in_string,